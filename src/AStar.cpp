@@ -1,12 +1,13 @@
 #include <AStar.hpp>
 #include <RobotWorld.hpp>
-#include <RobotWorldCanvas.hpp>
 #include <Shape2DUtils.hpp>
 #include <Wall.hpp>
 #include <Robot.hpp>
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <iterator>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
 #include <utility>
@@ -34,99 +35,84 @@ namespace PathAlgorithm
 	}
 	/**
 	 *
+	 * @return The distance from aVertex to the nearest of someGoals
 	 */
-	Path ConstructPath(	VertexMap& aPredecessorMap,
-						const Vertex& aCurrentNode)
+	double HeuristicCost(	const Vertex& aVertex,
+							const Vertex* someGoals,
+							std::size_t aNumberOfGoals)
 	{
-		VertexMap::iterator i = aPredecessorMap.find( aCurrentNode);
-		if (i != aPredecessorMap.end())
+		double cost = HeuristicCost( aVertex, someGoals[0]);
+		for (std::size_t i = 1; i < aNumberOfGoals; ++i)
 		{
-			Path path = ConstructPath( aPredecessorMap, (*i).second);
-			path.push_back( aCurrentNode);
-			return path;
+			cost = std::min( cost, HeuristicCost( aVertex, someGoals[i]));
+		}
+		return cost;
+	}
+	/**
+	 *
+	 */
+	std::string GoalsAsString(	const Vertex* someGoals,
+								std::size_t aNumberOfGoals)
+	{
+		std::ostringstream os;
+		if (aNumberOfGoals == 1)
+		{
+			os << someGoals[0];
 		} else
 		{
-			Path path;
-			path.push_back( aCurrentNode);
-			return path;
+			os << "any of " << aNumberOfGoals << " goals";
 		}
+		return os.str();
 	}
 	/**
-	 *
+	 * Adds the edges of aPose, inflated with aFreeRadius, to aLines
 	 */
-	std::vector< Vertex > GetNeighbours(	const Vertex& aVertex,
-											int aFreeRadius /*= 1*/)
-				{
+	void AddRobotLines(	const Model::Robot::Pose& aPose,
+						int aFreeRadius,
+						std::vector< OccupancyGrid::Line >& aLines)
+	{
+		aLines.push_back( OccupancyGrid::Line{ aPose.frontLeft, aPose.frontRight, aFreeRadius });
+		aLines.push_back( OccupancyGrid::Line{ aPose.backLeft, aPose.backRight, aFreeRadius });
+		aLines.push_back( OccupancyGrid::Line{ aPose.backLeft, aPose.frontLeft, aFreeRadius });
+		aLines.push_back( OccupancyGrid::Line{ aPose.frontRight, aPose.backRight, aFreeRadius });
+	}
+	/**
+	 * Walks the predecessors from aCurrentNode back to the start into aPath and reverses it.
+	 * aPath keeps its capacity, so a reused aPath does not allocate for routes that are not longer.
+	 */
+	void ConstructPath(	const VertexTable& aVertexTable,
+						const Vertex& aCurrentNode,
+						Path& aPath)
+	{
+		aPath.clear();
+		aPath.push_back( aCurrentNode);
+		while (aVertexTable.hasPredecessor( aPath.back()))
+		{
+			aPath.push_back( aVertexTable.getPredecessor( aPath.back()));
+		}
+		std::reverse( aPath.begin(), aPath.end());
+	}
+	/**
+	 * Fills aNeighbours with the free neighbours of aVertex. aNeighbours is reused by the caller
+	 * for every expansion so it does not allocate once it has reached its capacity of 8.
+	 */
+	void GetNeighbours(	const Vertex& aVertex,
+						const OccupancyGrid& aGrid,
+						std::vector< Vertex >& aNeighbours)
+	{
 		static int xOffset[] = { 0, 1, 1, 1, 0, -1, -1, -1 };
 		static int yOffset[] = { 1, 1, 0, -1, -1, -1, 0, 1 };
 
-		const std::vector< Model::WallPtr >& walls = Model::RobotWorld::getRobotWorld().getWalls();
-		const std::vector< Model::RobotPtr >& robots = Model::RobotWorld::getRobotWorld().getRobots();
-		std::vector< Vertex > neighbours;
+		aNeighbours.clear();
 
 		for (int i = 0; i < 8; ++i)
 		{
-			bool addToNeigbours = true;
-
-			Vertex vertex( aVertex.x + xOffset[i], aVertex.y + yOffset[i]);
-			for (Model::WallPtr wall : walls)
+			if (aGrid.isFree( aVertex.x + xOffset[i], aVertex.y + yOffset[i]))
 			{
-				if (Utils::Shape2DUtils::isOnLine( wall->getPoint1(), wall->getPoint2(), vertex.asPoint(), aFreeRadius + 2))
-				{
-					addToNeigbours = false;
-					break;
-				}
+				aNeighbours.push_back( Vertex( aVertex.x + xOffset[i], aVertex.y + yOffset[i]));
 			}
-			for (Model::RobotPtr otherRobot : robots)
-			{
-				if(otherRobot->getName().compare("Robot") == true)
-				{
-					if (Utils::Shape2DUtils::isOnLine( otherRobot->Robot::getFrontLeft(),otherRobot->Robot::getFrontRight(), vertex.asPoint(), aFreeRadius) || 
-						Utils::Shape2DUtils::isOnLine( otherRobot->Robot::getBackLeft(),otherRobot->Robot::getBackRight(), vertex.asPoint(), aFreeRadius)  || 
-						Utils::Shape2DUtils::isOnLine( otherRobot->Robot::getBackLeft(),otherRobot->Robot::getFrontLeft(), vertex.asPoint(), aFreeRadius)  || 
-						Utils::Shape2DUtils::isOnLine( otherRobot->Robot::getFrontRight(),otherRobot->Robot::getBackRight(), vertex.asPoint(), aFreeRadius) )	 
-					{
-						addToNeigbours = false;
-						break;
-					}
-				}
-			}
-
-			if (Utils::Shape2DUtils::isOnLine( Point(0,0), Point(View::RobotWorldCanvas::WorldSize,0), vertex.asPoint(), 2) || //left down --> left  up
-				Utils::Shape2DUtils::isOnLine( Point(0,0), Point(0,View::RobotWorldCanvas::WorldSize), vertex.asPoint(), 2) ||//right down --> right up 
-				Utils::Shape2DUtils::isOnLine( Point(View::RobotWorldCanvas::WorldSize,View::RobotWorldCanvas::WorldSize), Point(View::RobotWorldCanvas::WorldSize,0), vertex.asPoint(), 2) || //left down --> right down
-				Utils::Shape2DUtils::isOnLine( Point(View::RobotWorldCanvas::WorldSize,View::RobotWorldCanvas::WorldSize), Point(0,View::RobotWorldCanvas::WorldSize), vertex.asPoint(), 2) )	 
-			{
-				addToNeigbours = false;
-				break;
-			}
-			//			while (position.x > 0 && position.x < 500 && position.y > 0 && position.y < 500 && pathPoint < path.size())
-
-
-			//TODO worldcanvas size limit
-			if (addToNeigbours == true)
-			{
-				neighbours.push_back( vertex);
-			}
-		}
-		return neighbours;
-				}
-	/**
-	 *
-	 */
-	std::vector< Edge > GetNeighbourConnections(	const Vertex& aVertex,
-													int aFreeRadius /*= 1*/)
-				{
-		std::vector< Edge > connections;
-
-		const std::vector< Vertex >& neighbours = GetNeighbours( aVertex, aFreeRadius);
-		for (const Vertex& vertex : neighbours)
-		{
-			connections.push_back( Edge( aVertex, vertex));
 		}
-
-		return connections;
-				}
+	}
 	/**
 	 *
 	 */
@@ -147,336 +133,521 @@ namespace PathAlgorithm
 						const Vertex& aGoal,
 						const Size& aRobotSize)
 	{
-		getOS().clear();
-		getCS().clear();
-		getPM().clear();
+		Path path;
+		search( aStart, aGoal, aRobotSize, path);
+		return path;
+	}
+	/**
+	 *
+	 */
+	bool AStar::search(	Vertex aStart,
+						const Vertex& aGoal,
+						const Size& aRobotSize,
+						Path& aPath)
+	{
+		// The world does not change during the search so all obstacles are rasterised once
+		fillOccupancyGrid( occupancyGrid, freeRadius( aRobotSize), robotName);
 
-		int radius = std::ceil(std::sqrt( (aRobotSize.x / 2.0) * (aRobotSize.x / 2.0) + (aRobotSize.y / 2.0) * (aRobotSize.y / 2.0)));
+		return search( aStart, aGoal, occupancyGrid, aPath);
+	}
+	/**
+	 *
+	 */
+	Path AStar::search( Vertex aStart,
+						const Vertex& aGoal,
+						const OccupancyGrid& aGrid)
+	{
+		Path path;
+		search( aStart, aGoal, aGrid, path);
+		return path;
+	}
+	/**
+	 *
+	 */
+	bool AStar::search(	Vertex aStart,
+						const Vertex& aGoal,
+						const OccupancyGrid& aGrid,
+						Path& aPath)
+	{
+		return searchGoals( aStart, &aGoal, 1, aGrid, aPath);
+	}
+	/**
+	 *
+	 */
+	bool AStar::search(	Vertex aStart,
+						const std::vector< Vertex >& someGoals,
+						const Size& aRobotSize,
+						Path& aPath)
+	{
+		fillOccupancyGrid( occupancyGrid, freeRadius( aRobotSize), robotName);
+
+		return search( aStart, someGoals, occupancyGrid, aPath);
+	}
+	/**
+	 *
+	 */
+	bool AStar::search(	Vertex aStart,
+						const std::vector< Vertex >& someGoals,
+						const OccupancyGrid& aGrid,
+						Path& aPath)
+	{
+		return searchGoals( aStart, someGoals.data(), someGoals.size(), aGrid, aPath);
+	}
+	/**
+	 *
+	 */
+	bool AStar::searchBidirectional(	Vertex aStart,
+										const Vertex& aGoal,
+										const Size& aRobotSize,
+										Path& aPath)
+	{
+		fillOccupancyGrid( occupancyGrid, freeRadius( aRobotSize), robotName);
+
+		return searchBidirectional( aStart, aGoal, occupancyGrid, aPath);
+	}
+	/**
+	 * Both searches use the distance to the other end as their heuristic. Every route that has not
+	 * been found yet passes a Vertex in the openSet of each search whose cost is exact, so neither
+	 * search can find a route that is shorter than the lowest cost in its openSet. The best route
+	 * found so far is the shortest route as soon as it is not longer than one of those lowest costs.
+	 */
+	bool AStar::searchBidirectional(	Vertex aStart,
+										const Vertex& aGoal,
+										const OccupancyGrid& aGrid,
+										Path& aPath)
+	{
+		aPath.clear();
+
+		getOS().reset( aGrid.getWidth(), aGrid.getHeight());
+		vertexTable.reset( aGrid.getWidth(), aGrid.getHeight());
+		backwardOpenSet.reset( aGrid.getWidth(), aGrid.getHeight());
+		backwardVertexTable.reset( aGrid.getWidth(), aGrid.getHeight());
+		progress.start();
+
+		if (!vertexTable.isInside( aStart) || !vertexTable.isInside( aGoal))
+		{
+			std::cerr << "**** No route from " << aStart << " to " << aGoal << ", outside the world" << std::endl;
+			publishBidirectionalProgress();
+			return false;
+		}
+
+		aStart.actualCost = 0.0;
+		aStart.heuristicCost = HeuristicCost( aStart, aGoal);
+		vertexTable.visit( aStart);
+		addToOpenSet( aStart);
+
+		Vertex goal( aGoal.x, aGoal.y);
+		goal.actualCost = 0.0;
+		goal.heuristicCost = HeuristicCost( goal, aStart);
+		backwardVertexTable.visit( goal);
+		backwardOpenSet.push( goal);
+
+		// The Vertex where the best route found so far goes from the forward to the backward search
+		double bestCost = aStart.equalPoint( aGoal) ? 0.0 : std::numeric_limits< double >::infinity();
+		Vertex meeting( aStart.x, aStart.y);
+
+		std::vector< Vertex > neighbours;
+		neighbours.reserve( 8);
+
+		while (!openSet.empty() && !backwardOpenSet.empty() && std::max( openSet.top().heuristicCost, backwardOpenSet.top().heuristicCost) < bestCost)
+		{
+			// Expanding the smaller openSet keeps both searches about the same size
+			const bool forward = openSet.size() <= backwardOpenSet.size();
+			VertexHeap& heap = forward ? openSet : backwardOpenSet;
+			VertexTable& table = forward ? vertexTable : backwardVertexTable;
+			const VertexTable& otherTable = forward ? backwardVertexTable : vertexTable;
+			const Vertex& target = forward ? goal : aStart;
+
+			Vertex current = heap.top();
+			heap.pop();
+			table.setClosed( current);
+
+			if (progress.expand())
+			{
+				publishBidirectionalProgress();
+			}
+
+			GetNeighbours( current, aGrid, neighbours);
+			for (Vertex& neighbour : neighbours)
+			{
+				double calculatedActualNeighbourCost = current.actualCost + ActualCost( current, neighbour);
+				double totalHeuristicCostNeighbour = calculatedActualNeighbourCost + HeuristicCost( neighbour, target);
+
+				if (table.isVisited( neighbour))
+				{
+					if (table.get( neighbour).heuristicCost <= totalHeuristicCostNeighbour)
+					{
+						continue;
+					}
+					if (table.isClosed( neighbour))
+					{
+						table.setClosed( neighbour, false);
+					}
+				}
+
+				neighbour.actualCost = calculatedActualNeighbourCost;
+				neighbour.heuristicCost = totalHeuristicCostNeighbour;
+
+				table.visit( neighbour, current);
+
+				if (otherTable.isVisited( neighbour) && calculatedActualNeighbourCost + otherTable.get( neighbour).actualCost < bestCost)
+				{
+					bestCost = calculatedActualNeighbourCost + otherTable.get( neighbour).actualCost;
+					meeting = Vertex( neighbour.x, neighbour.y);
+				}
+				// A Vertex that can not lead to a shorter route, or that the other search already expanded, is not expanded
+				if (totalHeuristicCostNeighbour < bestCost && !otherTable.isClosed( neighbour))
+				{
+					heap.push( neighbour);
+				}
+			}
+		}
+
+		publishBidirectionalProgress();
+
+		if (bestCost == std::numeric_limits< double >::infinity())
+		{
+			std::cerr << "**** No route from " << aStart << " to " << aGoal << std::endl;
+			return false;
+		}
+
+		// The predecessors of the backward search lead to the goal
+		ConstructPath( vertexTable, vertexTable.get( meeting), aPath);
+		for (Vertex vertex = meeting; backwardVertexTable.hasPredecessor( vertex);)
+		{
+			vertex = backwardVertexTable.getPredecessor( vertex);
+			aPath.push_back( vertex);
+		}
+		for (std::size_t i = 1; i < aPath.size(); ++i)
+		{
+			aPath[i].actualCost = aPath[i - 1].actualCost + ActualCost( aPath[i - 1], aPath[i]);
+			aPath[i].heuristicCost = aPath[i].actualCost + HeuristicCost( aPath[i], aGoal);
+		}
+		return true;
+	}
+	/**
+	 * The heuristic is the distance to the nearest goal, which never overestimates the cost to the
+	 * goal that is reached, so the first goal that is expanded is the nearest reachable goal.
+	 */
+	bool AStar::searchGoals(	Vertex aStart,
+								const Vertex* someGoals,
+								std::size_t aNumberOfGoals,
+								const OccupancyGrid& aGrid,
+								Path& aPath)
+	{
+		aPath.clear();
+
+		getOS().reset( aGrid.getWidth(), aGrid.getHeight());
+		vertexTable.reset( aGrid.getWidth(), aGrid.getHeight());
+		progress.start();
+
+		bool goalInside = false;
+		for (std::size_t i = 0; i < aNumberOfGoals; ++i)
+		{
+			goalInside = goalInside || vertexTable.isInside( someGoals[i]);
+		}
+		if (!vertexTable.isInside( aStart) || !goalInside)
+		{
+			std::cerr << "**** No route from " << aStart << " to " << GoalsAsString( someGoals, aNumberOfGoals) << ", outside the world" << std::endl;
+			publishProgress();
+			return false;
+		}
 
 		aStart.actualCost = 0.0; 													// Cost from aStart along the best known path.
-		aStart.heuristicCost = aStart.actualCost + HeuristicCost( aStart, aGoal);	// Estimated total cost from aStart to aGoal through y.
+		aStart.heuristicCost = aStart.actualCost + HeuristicCost( aStart, someGoals, aNumberOfGoals);	// Estimated total cost from aStart to aGoal through y.
 
+		vertexTable.visit( aStart);
 		addToOpenSet(aStart);
 
+		std::vector< Vertex > neighbours;
+		neighbours.reserve( 8);
+
 		//		long long begin = std::clock();
 
 		while (!openSet.empty())
 		{
-			Vertex current = *openSet.begin();
+			Vertex current = openSet.top();
 
-			if (current.equalPoint( aGoal))
+			if (std::any_of( someGoals, someGoals + aNumberOfGoals, [&current](const Vertex& aGoal){ return current.equalPoint( aGoal);}))
 			{
-				return ConstructPath( predecessorMap, current);
+				publishProgress();
+				ConstructPath( vertexTable, current, aPath);
+				return true;
 			} else
 			{
 				addToClosedSet( current);
 				removeFirstFromOpenSet();
 
-				const std::vector< Edge >& connections = GetNeighbourConnections( current, radius);
-				for (const Edge& connection : connections)
+				if (progress.expand())
 				{
-					Vertex neighbour = connection.otherSide( current);
+					publishProgress();
+				}
 
+				GetNeighbours( current, aGrid, neighbours);
+				for (Vertex& neighbour : neighbours)
+				{
 					// The new costs
 					double calculatedActualNeighbourCost = current.actualCost + ActualCost( current, neighbour);
-					double totalHeuristicCostNeighbour = calculatedActualNeighbourCost + HeuristicCost( neighbour, aGoal);
+					double totalHeuristicCostNeighbour = calculatedActualNeighbourCost + HeuristicCost( neighbour, someGoals, aNumberOfGoals);
 
-					OpenSet::iterator openVertex = findInOpenSet( neighbour);
-					if (openVertex != openSet.end())
+					if (vertexTable.isVisited( neighbour))
 					{
-						// if neighbour is in the openSet we may have found a shorter via-route
-						if ((*openVertex).heuristicCost <= totalHeuristicCostNeighbour)
+						// if neighbour is in the openSet or the closedSet we may have found a shorter via-route
+						if (vertexTable.get( neighbour).heuristicCost <= totalHeuristicCostNeighbour)
 						{
 							continue;
-						} else
-						{
-							removeFromOpenSet( openVertex);
 						}
-					}
-					ClosedSet::iterator closedVertex = findInClosedSet( neighbour);
-					if (closedVertex != closedSet.end())
-					{
-						// if neighbour is in the closedSet we may have found a shorter via-route
-						if ((*closedVertex).heuristicCost <= totalHeuristicCostNeighbour)
+						if (isInClosedSet( neighbour))
 						{
-							continue;
-						} else
-						{
-							removeFromClosedSet( closedVertex);
+							removeFromClosedSet( neighbour);
 						}
 					}
 
 					neighbour.actualCost = calculatedActualNeighbourCost;
 					neighbour.heuristicCost = totalHeuristicCostNeighbour;
 
-					std::pair< VertexMap::iterator, bool > insertResult1 = predecessorMap.insert( std::make_pair( neighbour, current));
-					if (insertResult1.second != true)
-					{
-						if (!(*insertResult1.first).first.equalPoint( neighbour))
-						{
-							std::ostringstream os;
-							os << "*** (*insertResult1.first).first != neighbour:\n\t\t" << (*insertResult1.first).first << " <- " << (*insertResult1.first).second << "\n\t\t" << neighbour << " <- " << current;
-							throw std::runtime_error(os.str());
-						}
+					vertexTable.visit( neighbour, current);
 
-						if ((*insertResult1.first).first.heuristicCost > neighbour.heuristicCost)
-						{
-							predecessorMap.erase( insertResult1.first);
-							std::pair< VertexMap::iterator, bool > insertResult2 = predecessorMap.insert( std::make_pair( neighbour, current));
-							if (insertResult2.second != true)
-							{
-								std::ostringstream os;
-								os << "**** Failed updating neighbour in the predecessorMap:  " << neighbour << " <- " << current << "\n";
-								if (insertResult2.first != predecessorMap.end())
-								{
-									os << "\tcurrent value in the predecessorMap:  " << (*insertResult2.first).first << " <- " << (*insertResult2.first).second;
-								} else
-								{
-									os << "\tinvalid iterator ";
-								}
-								throw std::runtime_error(os.str());
-							} else
-							{
-							}
-						}
-					} else
-					{
-					}
-
-					// if neighbour is not in openSet, add it to the openSet
-					// which should always be the case?
-					openVertex = findInOpenSet( neighbour);
-					if (openVertex == openSet.end())
-					{
-						addToOpenSet( neighbour);
-					} else
-					{
-						std::cerr << "**** Failed adding neighbour to the openSet:  " << neighbour << std::endl;
-					}
-				} //for(Edge connection : connections)
-
-				//			Improving the performance 28-04-2014.....
-				//
-				//			Sorting after the insertion of an individual:
-				//			aRobotSize = (37,29), radius = 23
-				//			Duration: 17.349.490 openSet: 1507 closedSet: 76521 predecessorMap: 78027
-				//
-				//			After the insert of all:
-				//			aRobotSize = (37,29), radius = 23
-				//			Duration: 7.733.159 openSet: 1507 closedSet: 76521 predecessorMap: 78027
-				//
-				//			Partial sort after insert of all:
-				//			aRobotSize = (37,29), radius = 23
-				//			Duration: 3.297.669 openSet: 1507 closedSet: 76521 predecessorMap: 78027
-				//
-				//			No sorting, just iterator swap for begin() and the minimum element, which is basically
-				//			the smallest partial_sort there is...
-				//			aRobotSize = (37,29), radius = 23
-				//			Duration: 2.626.220 openSet: 1507 closedSet: 76521 predecessorMap: 78027
-				//
-				//			// Sort the openSet before the next loop, use partial_sort as per Scott Meyers' Effective STL
-				//			if(std::distance(openSet.begin(), openSet.end()) > 5 )
-				//			{
-				//				std::partial_sort( openSet.begin(), openSet.begin() + 4, openSet.end(), VertexLessCostCompare());
-				//			}else
-				//			{
-				//				std::sort( openSet.begin(), openSet.end(), VertexLessCostCompare());
-				//			}
-				std::iter_swap(openSet.begin(), std::min_element( openSet.begin(), openSet.end(), VertexLessCostCompare()));
+					// Either a new point or a shorter via-route to a point in the openSet,
+					// the latter is a decrease-key in the openSet
+					addToOpenSet( neighbour);
+				} //for(Vertex& neighbour : neighbours)
 			}
 		}
-		// std::cerr << "Duration: " << (std::clock() - begin) << " openSet: " << getOS().size() << " closedSet: " << getCS().size() << " predecessorMap: " << getPM().size() << std::endl;
+		// std::cerr << "Duration: " << (std::clock() - begin) << " openSet: " << getOS().size() << " closedSet: " << getClosedSet().size() << std::endl;
 
-		std::cerr << "**** No route from " << aStart << " to " << aGoal << std::endl;
-		return Path();
+		std::cerr << "**** No route from " << aStart << " to " << GoalsAsString( someGoals, aNumberOfGoals) << std::endl;
+		publishProgress();
+		return false;
 	}
 	/**
 	 *
 	 */
 	void AStar::addToOpenSet( const Vertex& aVertex)
 	{
-		std::unique_lock< std::recursive_mutex > lock( openSetMutex);
-		openSet.push_back( aVertex);
-		notifyObservers();
-	}
-	/**
-	 *
-	 */
-	void AStar::removeFromOpenSet( const Vertex& aVertex)
-	{
-		std::unique_lock< std::recursive_mutex > lock( openSetMutex);
-		OpenSet::iterator i = findInOpenSet( aVertex);
-		removeFromOpenSet( i);
+		openSet.push( aVertex);
 	}
 	/**
 	 *
 	 */
-	void AStar::removeFromOpenSet( OpenSet::iterator& i)
+	const Vertex* AStar::findInOpenSet( const Vertex& aVertex) const
 	{
-		std::unique_lock< std::recursive_mutex > lock( openSetMutex);
-		openSet.erase( i);
-		notifyObservers();
+		return openSet.find( aVertex);
 	}
 	/**
 	 *
 	 */
-	OpenSet::iterator AStar::findInOpenSet( const Vertex& aVertex)
+	void AStar::removeFirstFromOpenSet()
 	{
-		std::unique_lock< std::recursive_mutex > lock( openSetMutex);
-		return std::find_if( openSet.begin(),
-							 openSet.end(),
-							 [aVertex](const Vertex& rhs)
-							 {
-			return aVertex.equalPoint(rhs);
-							 });
+		openSet.pop();
 	}
 	/**
 	 *
 	 */
-	bool AStar::findRemoveInOpenSet( const Vertex& aVertex)
+	void AStar::addToClosedSet( const Vertex& aVertex)
 	{
-		std::lock_guard< std::recursive_mutex > lock( openSetMutex);
-		OpenSet::iterator i = findInOpenSet( aVertex);
-		if (i != openSet.end())
-		{
-			openSet.erase( i);
-			return true;
-		}
-		return false;
-
+		vertexTable.setClosed( aVertex);
 	}
 	/**
 	 *
 	 */
-	void AStar::removeFirstFromOpenSet()
+	void AStar::removeFromClosedSet( const Vertex& aVertex)
 	{
-		std::unique_lock< std::recursive_mutex > lock( openSetMutex);
-		openSet.erase( openSet.begin());
+		vertexTable.setClosed( aVertex, false);
 	}
 	/**
 	 *
 	 */
-	void AStar::addToClosedSet( const Vertex& aVertex)
+	bool AStar::isInClosedSet( const Vertex& aVertex) const
 	{
-		std::unique_lock< std::recursive_mutex > lock( closedSetMutex);
-		closedSet.insert( aVertex);
-		notifyObservers();
+		return vertexTable.isClosed( aVertex);
 	}
 	/**
 	 *
 	 */
-	void AStar::removeFromClosedSet( const Vertex& aVertex)
+	ClosedSet AStar::getClosedSet() const
 	{
-		std::unique_lock< std::recursive_mutex > lock( closedSetMutex);
-		ClosedSet::iterator i = findInClosedSet( aVertex);
-		removeFromClosedSet( i);
+		return progress.getClosedSet();
 	}
 	/**
 	 *
 	 */
-	void AStar::removeFromClosedSet( ClosedSet::iterator& i)
+	OpenSet AStar::getOpenSet() const
 	{
-		std::unique_lock< std::recursive_mutex > lock( closedSetMutex);
-		closedSet.erase( i);
-		notifyObservers();
+		return progress.getOpenSet();
 	}
 	/**
 	 *
 	 */
-	ClosedSet::iterator AStar::findInClosedSet( const Vertex& aVertex)
+	/* static */int AStar::freeRadius( const Size& aRobotSize)
 	{
-		std::unique_lock< std::recursive_mutex > lock( closedSetMutex);
-		//return std::find_if(closedSet.begin(),closedSet.end(),[aVertex](const Vertex& rhs){return aVertex.equalPoint(rhs);});
-		return closedSet.find( aVertex);
+		return std::ceil(std::sqrt( (aRobotSize.x / 2.0) * (aRobotSize.x / 2.0) + (aRobotSize.y / 2.0) * (aRobotSize.y / 2.0)));
 	}
 	/**
 	 *
 	 */
-	ClosedSet AStar::getClosedSet() const
+	/* static */void AStar::fillOccupancyGrid(	OccupancyGrid& aGrid,
+												int aFreeRadius,
+												const std::string& aRobotName)
 	{
-		std::lock_guard< std::recursive_mutex > lock( closedSetMutex);
-		ClosedSet c = getCS();
-		return c;
+		std::vector< OccupancyGrid::Line > lines;
+		getObstacleLines( aFreeRadius, aRobotName, lines);
+		fillOccupancyGrid( aGrid, lines);
 	}
 	/**
 	 *
 	 */
-	bool AStar::findRemoveClosedSet( const Vertex& aVertex)
+	/* static */void AStar::fillOccupancyGrid(	OccupancyGrid& aGrid,
+												const std::vector< OccupancyGrid::Line >& someLines)
 	{
-		std::lock_guard< std::recursive_mutex > lock( closedSetMutex);
-		ClosedSet::iterator i = findInClosedSet( aVertex);
-		if (i != closedSet.end())
+		const Size worldSize = Model::RobotWorld::getRobotWorld().getWorldSize();
+
+		aGrid.reset( worldSize.x + 1, worldSize.y + 1);
+		for (const OccupancyGrid::Line& line : someLines)
 		{
-			closedSet.erase( i);
-			return true;
+			aGrid.addLine( line);
 		}
-		return false;
 	}
 	/**
 	 *
 	 */
-	OpenSet AStar::getOpenSet() const
+	/* static */void AStar::getObstacleLines(	int aFreeRadius,
+												const std::string& aRobotName,
+												std::vector< OccupancyGrid::Line >& aLines)
 	{
-		std::lock_guard< std::recursive_mutex > lock( openSetMutex);
-		OpenSet o = getOS();
-		return o;
+		getObstacleLines( aFreeRadius, std::vector< std::string >{ aRobotName }, aLines);
 	}
 	/**
-	 *
+	 * The walls get 2 pixels extra clearance, the borders only 2 pixels because the robot
+	 * cannot cross them anyway. These are the clearances the neighbour test used before the grid existed.
 	 */
-	VertexMap AStar::getPredecessorMap() const
+	/* static */void AStar::getObstacleLines(	int aFreeRadius,
+												const std::vector< std::string >& someIgnoredRobots,
+												std::vector< OccupancyGrid::Line >& aLines)
 	{
-		std::lock_guard< std::recursive_mutex > lock( predecessorMapMutex);
-		VertexMap p = getPM();
-		return p;
-	}
+		const Size worldSize = Model::RobotWorld::getRobotWorld().getWorldSize();
 
-	/**
-	 *
-	 */
-	ClosedSet& AStar::getCS()
-	{
-		std::unique_lock< std::recursive_mutex > lock( closedSetMutex);
-		return closedSet;
+		aLines.clear();
+
+		const std::vector< Model::WallPtr >& walls = Model::RobotWorld::getRobotWorld().getWalls();
+		for (Model::WallPtr wall : walls)
+		{
+			aLines.push_back( OccupancyGrid::Line{ wall->getPoint1(), wall->getPoint2(), aFreeRadius + 2 });
+		}
+
+		const std::vector< Model::RobotPtr >& robots = Model::RobotWorld::getRobotWorld().getRobots();
+		for (Model::RobotPtr otherRobot : robots)
+		{
+			if (std::find( someIgnoredRobots.begin(), someIgnoredRobots.end(), otherRobot->getName()) == someIgnoredRobots.end())
+			{
+				AddRobotLines( otherRobot->getPose(), aFreeRadius, aLines);
+			}
+		}
+
+		aLines.push_back( OccupancyGrid::Line{ Point( 0, 0), Point( worldSize.x, 0), 2 });
+		aLines.push_back( OccupancyGrid::Line{ Point( 0, 0), Point( 0, worldSize.y), 2 });
+		aLines.push_back( OccupancyGrid::Line{ Point( worldSize.x, worldSize.y), Point( worldSize.x, 0), 2 });
+		aLines.push_back( OccupancyGrid::Line{ Point( worldSize.x, worldSize.y), Point( 0, worldSize.y), 2 });
 	}
 	/**
-	 *
+	 * The cells of aPath are walked like OccupancyGrid::isLineFree walks them and tested against the robot
+	 * lines like OccupancyGrid::addLine tests them, so nothing is rasterised for the few cells of a route.
 	 */
-	const ClosedSet& AStar::getCS() const
+	/* static */bool AStar::isFreeOfRobots(	const Path& aPath,
+											int aFreeRadius,
+											const std::string& aRobotName)
 	{
-		std::unique_lock< std::recursive_mutex > lock( closedSetMutex);
-		return closedSet;
+		std::vector< OccupancyGrid::Line > lines;
+		const std::vector< Model::RobotPtr >& robots = Model::RobotWorld::getRobotWorld().getRobots();
+		for (Model::RobotPtr otherRobot : robots)
+		{
+			if (otherRobot->getName() != aRobotName)
+			{
+				AddRobotLines( otherRobot->getPose(), aFreeRadius, lines);
+			}
+		}
+		if (lines.empty() || aPath.empty())
+		{
+			return true;
+		}
+
+		auto isFree = [&lines]( int x, int y)
+		{
+			for (const OccupancyGrid::Line& line : lines)
+			{
+				if (x >= std::min( line.startPoint.x, line.endPoint.x) - line.radius && x <= std::max( line.startPoint.x, line.endPoint.x) + line.radius &&
+					y >= std::min( line.startPoint.y, line.endPoint.y) - line.radius && y <= std::max( line.startPoint.y, line.endPoint.y) + line.radius &&
+					Utils::Shape2DUtils::isOnLine( line.startPoint, line.endPoint, Point( x, y), line.radius))
+				{
+					return false;
+				}
+			}
+			return true;
+		};
+
+		if (!isFree( aPath.front().x, aPath.front().y))
+		{
+			return false;
+		}
+		for (std::size_t i = 1; i < aPath.size(); ++i)
+		{
+			const int dx = aPath[i].x - aPath[i - 1].x;
+			const int dy = aPath[i].y - aPath[i - 1].y;
+			const int numberOfSteps = std::max( std::abs( dx), std::abs( dy));
+			for (int step = 1; step <= numberOfSteps; ++step)
+			{
+				const int x = aPath[i - 1].x + static_cast< int >( std::lround( static_cast< double >( dx) * step / numberOfSteps));
+				const int y = aPath[i - 1].y + static_cast< int >( std::lround( static_cast< double >( dy) * step / numberOfSteps));
+				if (!isFree( x, y))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
 	}
 	/**
 	 *
 	 */
-	OpenSet& AStar::getOS()
+	VertexHeap& AStar::getOS()
 	{
-		std::unique_lock< std::recursive_mutex > lock( openSetMutex);
 		return openSet;
 	}
 	/**
 	 *
 	 */
-	const OpenSet& AStar::getOS() const
+	const VertexHeap& AStar::getOS() const
 	{
-		std::unique_lock< std::recursive_mutex > lock( openSetMutex);
 		return openSet;
 	}
 	/**
 	 *
 	 */
-	VertexMap& AStar::getPM()
+	void AStar::publishProgress()
 	{
-		std::unique_lock< std::recursive_mutex > lock( predecessorMapMutex);
-		return predecessorMap;
+		if (!progress.isEnabled())
+		{
+			return;
+		}
+		progress.publish( openSet.getVertices(), vertexTable.getClosedVertices());
+		notifyObservers();
 	}
 	/**
 	 *
 	 */
-	const VertexMap& AStar::getPM() const
+	void AStar::publishBidirectionalProgress()
 	{
-		std::unique_lock< std::recursive_mutex > lock( predecessorMapMutex);
-		return predecessorMap;
+		if (!progress.isEnabled())
+		{
+			return;
+		}
+		OpenSet open = openSet.getVertices();
+		open.insert( open.end(), backwardOpenSet.getVertices().begin(), backwardOpenSet.getVertices().end());
+		ClosedSet closed = vertexTable.getClosedVertices();
+		ClosedSet backwardClosed = backwardVertexTable.getClosedVertices();
+		closed.insert( closed.end(), backwardClosed.begin(), backwardClosed.end());
+
+		progress.publish( std::move( open), std::move( closed));
+		notifyObservers();
 	}
 }// namespace PathAlgorithm
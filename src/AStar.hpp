@@ -3,186 +3,29 @@
 
 #include "Config.hpp"
 
+#include <cstddef>
 #include <iostream>
-#include <map>
-#include <mutex>
-#include <set>
+#include <string>
 #include <vector>
 
 #include "Notifier.hpp"
+#include "OccupancyGrid.hpp"
 #include "Point.hpp"
+#include "SearchProgress.hpp"
 #include "Size.hpp"
+#include "Vertex.hpp"
+#include "VertexHeap.hpp"
+#include "VertexTable.hpp"
 
 
 namespace PathAlgorithm
 {
-	struct Vertex
-	{
-			/**
-			 *
-			 */
-			Vertex( int anX,
-					int anY) :
-						x( anX),
-						y( anY),
-						actualCost( 0.0),
-						heuristicCost( 0.0)
-			{
-			}
-			/**
-			 *
-			 */
-			Vertex( const Point& aPoint) :
-				x( aPoint.x),
-				y( aPoint.y),
-				actualCost( 0.0),
-				heuristicCost( 0.0)
-			{
-			}
-			/**
-			 *
-			 */
-			Point asPoint() const
-			{
-				return Point( x, y);
-			}
-			/**
-			 *
-			 */
-			bool lessCost( const Vertex& aVertex) const
-			{
-				if (heuristicCost < aVertex.heuristicCost)
-					return true;
-				// less uncertainty if the actual cost is smaller
-				if (heuristicCost == aVertex.heuristicCost)
-					return actualCost > aVertex.actualCost;
-				return false;
-			}
-			/**
-			 *
-			 */
-			bool lessId( const Vertex& aVertex) const
-			{
-				if(x < aVertex.x) return true;
-				if(x == aVertex.x) return y < aVertex.y;
-				return false;
-			}
-			/**
-			 *
-			 */
-			bool equalPoint( const Vertex& aVertex) const
-			{
-				return x == aVertex.x && y == aVertex.y;
-			}
-
-			int x;
-			int y;
-
-			double actualCost;
-			double heuristicCost;
-	};
-	// struct Vertex
-
-	/**
-	 *
-	 */
-	struct VertexLessCostCompare
-	{
-			bool operator()(	const Vertex& lhs,
-								const Vertex& rhs) const
-			{
-				return lhs.lessCost( rhs);
-			}
-	};
-	// struct VertexCostCompare
-	/**
-	 *
-	 */
-	struct VertexLessIdCompare
-	{
-			bool operator()(	const Vertex& lhs,
-								const Vertex& rhs) const
-			{
-				return lhs.lessId( rhs);
-			}
-	};
-	// struct VertexIdCompare
-	/**
-	 *
-	 */
-	struct VertexEqualPointCompare
-	{
-			bool operator()(	const Vertex& lhs,
-								const Vertex& rhs) const
-			{
-				return lhs.equalPoint( rhs);
-			}
-	};
-	// struct VertexPointCompare
-	struct Edge
-	{
-			Edge(	const Vertex& aVertex1,
-					const Vertex& aVertex2) :
-						vertex1( aVertex1),
-						vertex2( aVertex2)
-			{
-			}
-			Edge( const Edge& anEdge) :
-				vertex1( anEdge.vertex1),
-				vertex2( anEdge.vertex2)
-			{
-			}
-
-			const Vertex& thisSide( const Vertex& aVertex) const
-			{
-				if (vertex1.equalPoint( aVertex))
-					return vertex1;
-				if (vertex2.equalPoint( aVertex))
-					return vertex2;
-				throw std::logic_error( "thisSide: huh???");
-			}
-
-			const Vertex& otherSide( const Vertex& aVertex) const
-			{
-				if (vertex1.equalPoint( aVertex))
-					return vertex2;
-				if (vertex2.equalPoint( aVertex))
-					return vertex1;
-				throw std::logic_error( "otherSide: huh???");
-			}
-
-			Vertex vertex1;
-			Vertex vertex2;
-	}; // struct Edge
-	/**
-	 *
-	 * @param os
-	 * @param aVertex
-	 * @return
-	 */
-	inline std::ostream& operator<<( 	std::ostream& os,
-										const Vertex & aVertex)
-	{
-		return os << "(" << aVertex.x << "," << aVertex.y << "), " << aVertex.actualCost << " " << aVertex.heuristicCost;
-	}
-	/**
-	 *
-	 * @param os
-	 * @param anEdge
-	 * @return
-	 */
-	inline std::ostream& operator<<( 	std::ostream& os,
-										const Edge& anEdge)
-	{
-		return os << anEdge.vertex1 << " -> " << anEdge.vertex2;
-	}
 	/*
 	 *
 	 */
 	typedef std::vector< Vertex > Path;
 	typedef std::vector< Vertex > OpenSet;
-	typedef std::set< Vertex, VertexLessIdCompare > ClosedSet;
-	typedef std::map< Vertex, Vertex, VertexLessIdCompare > VertexMap;
+	typedef std::vector< Vertex > ClosedSet;
 	/**
 	 *
 	 */
@@ -202,106 +45,217 @@ namespace PathAlgorithm
 						const Vertex& aGoal,
 						const Size& aRobotSize);
 			/**
+			 * Puts the route in aPath instead of returning a new Path. aPath keeps its capacity so
+			 * replanning with the same aPath does not allocate.
 			 *
+			 * @return True if there is a route, aPath is empty otherwise
 			 */
-			void addToOpenSet( const Vertex& aVertex);
+			bool search(Vertex aStart,
+						const Vertex& aGoal,
+						const Size& aRobotSize,
+						Path& aPath);
 			/**
-			 *
+			 * Searches on aGrid instead of on the current obstacles of the world, aGrid must
+			 * already be inflated with the clearance of the robot
 			 */
-			void removeFromOpenSet( const Vertex& aVertex);
+			Path search(Vertex aStart,
+						const Vertex& aGoal,
+						const OccupancyGrid& aGrid);
 			/**
 			 *
 			 */
-			void removeFromOpenSet( OpenSet::iterator& i);
+			bool search(Vertex aStart,
+						const Vertex& aGoal,
+						const OccupancyGrid& aGrid,
+						Path& aPath);
 			/**
+			 * Searches the route to the nearest of someGoals that can be reached in one search,
+			 * the last Vertex of aPath is the goal that was reached
 			 *
+			 * @return True if there is a route to one of the goals, aPath is empty otherwise
 			 */
-			OpenSet::iterator findInOpenSet( const Vertex& aVertex);
+			bool search(Vertex aStart,
+						const std::vector< Vertex >& someGoals,
+						const Size& aRobotSize,
+						Path& aPath);
 			/**
 			 *
 			 */
-			bool findRemoveInOpenSet( const Vertex& aVertex);
+			bool search(Vertex aStart,
+						const std::vector< Vertex >& someGoals,
+						const OccupancyGrid& aGrid,
+						Path& aPath);
 			/**
+			 * Searches from aStart and from aGoal at the same time until the two searches meet. The route is
+			 * as short as the route of search, for long routes in open worlds fewer Vertices are expanded.
 			 *
+			 * @return True if there is a route, aPath is empty otherwise
 			 */
-			void removeFirstFromOpenSet();
+			bool searchBidirectional(	Vertex aStart,
+										const Vertex& aGoal,
+										const Size& aRobotSize,
+										Path& aPath);
 			/**
 			 *
 			 */
-			void addToClosedSet( const Vertex& aVertex);
+			bool searchBidirectional(	Vertex aStart,
+										const Vertex& aGoal,
+										const OccupancyGrid& aGrid,
+										Path& aPath);
+			/**
+			 * Adds aVertex to the openSet or, if the point is already in the openSet, replaces
+			 * its costs by those of aVertex. O(log n). The functions on the sets are not synchronised,
+			 * use getOpenSet and getClosedSet from another thread.
+			 */
+			void addToOpenSet( const Vertex& aVertex);
 			/**
 			 *
+			 * @return The Vertex in the openSet with the same point as aVertex or nullptr if not in the openSet. O(1).
 			 */
-			void removeFromClosedSet( const Vertex& aVertex);
+			const Vertex* findInOpenSet( const Vertex& aVertex) const;
+			/**
+			 * Removes the Vertex with the lowest cost from the openSet. O(log n).
+			 */
+			void removeFirstFromOpenSet();
 			/**
 			 *
 			 */
-			void removeFromClosedSet( ClosedSet::iterator& i);
+			void addToClosedSet( const Vertex& aVertex);
 			/**
 			 *
 			 */
-			ClosedSet::iterator findInClosedSet( const Vertex& aVertex);
+			void removeFromClosedSet( const Vertex& aVertex);
 			/**
 			 *
 			 */
-			bool findRemoveClosedSet( const Vertex& aVertex);
+			bool isInClosedSet( const Vertex& aVertex) const;
 			/**
 			 *
+			 * @return The closedSet of the last snapshot of the search
 			 */
 			ClosedSet getClosedSet() const;
 			/**
 			 *
+			 * @return The openSet of the last snapshot of the search
 			 */
 			OpenSet getOpenSet() const;
 			/**
-			 *
+			 * The Robot that plans with this AStar is not an obstacle for its own routes, with an
+			 * empty name all Robots are obstacles
 			 */
-			VertexMap getPredecessorMap() const;
-
-		protected:
+			void setRobotName( const std::string& aRobotName)
+			{
+				robotName = aRobotName;
+			}
 			/**
 			 *
 			 */
-			ClosedSet& getCS();
+			const std::string& getRobotName() const
+			{
+				return robotName;
+			}
+			/**
+			 * The snapshots of the search for a visualiser, every snapshot notifies the observers
+			 */
+			SearchProgress& getProgress()
+			{
+				return progress;
+			}
 			/**
 			 *
+			 * @return The grid the last search was done on
 			 */
-			const ClosedSet& getCS() const;
+			const OccupancyGrid& getOccupancyGrid() const
+			{
+				return occupancyGrid;
+			}
 			/**
 			 *
+			 * @return The clearance a robot of aRobotSize needs around its centre, i.e. half its diagonal
+			 */
+			static int freeRadius( const Size& aRobotSize);
+			/**
+			 * Rasterises the walls, the robots other than aRobotName and the borders of the world
+			 * into aGrid, inflated with aFreeRadius
+			 */
+			static void fillOccupancyGrid(	OccupancyGrid& aGrid,
+											int aFreeRadius,
+											const std::string& aRobotName);
+			/**
+			 * Sizes aGrid for the world and rasterises someLines into it
+			 */
+			static void fillOccupancyGrid(	OccupancyGrid& aGrid,
+											const std::vector< OccupancyGrid::Line >& someLines);
+			/**
+			 * Fills aLines with the obstacles that fillOccupancyGrid rasterises for aRobotName
 			 */
-			OpenSet& getOS();
+			static void getObstacleLines(	int aFreeRadius,
+											const std::string& aRobotName,
+											std::vector< OccupancyGrid::Line >& aLines);
 			/**
+			 * Fills aLines with the obstacles except the robots with a name in someIgnoredRobots
+			 */
+			static void getObstacleLines(	int aFreeRadius,
+											const std::vector< std::string >& someIgnoredRobots,
+											std::vector< OccupancyGrid::Line >& aLines);
+			/**
+			 * A route that was planned earlier is still valid if the other robots moved out of its way
 			 *
+			 * @return True if none of the cells of aPath is covered by a robot other than aRobotName,
+			 * inflated with aFreeRadius like fillOccupancyGrid does
 			 */
-			const OpenSet& getOS() const;
+			static bool isFreeOfRobots(	const Path& aPath,
+										int aFreeRadius,
+										const std::string& aRobotName);
+
+		protected:
 			/**
 			 *
 			 */
-			VertexMap& getPM();
+			VertexHeap& getOS();
 			/**
 			 *
 			 */
-			const VertexMap& getPM() const;
+			const VertexHeap& getOS() const;
 
 		private:
 			/**
-			 *
+			 * The search of search and of the search for several goals
 			 */
-			ClosedSet closedSet;
+			bool searchGoals(	Vertex aStart,
+								const Vertex* someGoals,
+								std::size_t aNumberOfGoals,
+								const OccupancyGrid& aGrid,
+								Path& aPath);
 			/**
-			 *
+			 * Copies the openSet and the closedSet into the snapshot and notifies the observers
+			 */
+			void publishProgress();
+			/**
+			 * Copies the openSets and the closedSets of both searches into the snapshot and notifies the observers
 			 */
-			OpenSet openSet;
+			void publishBidirectionalProgress();
 			/**
 			 *
 			 */
-			VertexMap predecessorMap;
-
-			mutable std::recursive_mutex openSetMutex;
-			mutable std::recursive_mutex closedSetMutex;
-			mutable std::recursive_mutex predecessorMapMutex;
+			VertexHeap openSet;
+			/**
+			 * The costs, closed flags and predecessors of all visited Vertices, the closedSet
+			 * and the predecessor map of the search
+			 */
+			VertexTable vertexTable;
+			/**
+			 * The openSet and the Vertices of the search from the goal of searchBidirectional
+			 */
+			VertexHeap backwardOpenSet;
+			VertexTable backwardVertexTable;
+			/**
+			 * The obstacles of the world, inflated with the clearance of the robot
+			 */
+			OccupancyGrid occupancyGrid;
 
+			std::string robotName;
+			SearchProgress progress;
 	}; // class AStar
 } // namespace PathAlgorithm
 #endif // ASTAR_HPP_
@@ -9,7 +9,8 @@ namespace Model
 	 */
 	AbstractSensor::AbstractSensor() :
 								agent( nullptr),
-								running( false)
+								running( false),
+								sensorTask( Scheduler::NoTask)
 	{
 	}
 	/**
@@ -17,7 +18,8 @@ namespace Model
 	 */
 	AbstractSensor::AbstractSensor( AbstractAgent* anAgent) :
 								agent( anAgent),
-								running( false)
+								running( false),
+								sensorTask( Scheduler::NoTask)
 	{
 
 	}
@@ -26,6 +28,10 @@ namespace Model
 	 */
 	AbstractSensor::~AbstractSensor()
 	{
+		if (running)
+		{
+			setOff();
+		}
 	}
 	/**
 	 *
@@ -36,9 +42,8 @@ namespace Model
 		if (running == false)
 		{
 			running = true;
-			std::thread newSensorThread( [this, aSleepTime]
-										  {	run(aSleepTime);});
-			sensorThread.swap( newSensorThread);
+			Scheduler& scheduler = Scheduler::getScheduler();
+			sensorTask = scheduler.schedule( [this]{ return step();}, scheduler.getTicksFor( std::chrono::milliseconds( aSleepTime)));
 		}
 	}
 	/**
@@ -49,8 +54,8 @@ namespace Model
 		std::unique_lock< std::recursive_mutex > lock( sensorMutex);
 
 		running = false;
-		//sensorThread.interrupt();
-		sensorThread.join();
+		Scheduler::getScheduler().unschedule( sensorTask);
+		sensorTask = Scheduler::NoTask;
 	}
 	/**
 	 *
@@ -62,35 +67,16 @@ namespace Model
 	/**
 	 *
 	 */
-	void AbstractSensor::run( unsigned long aSleepTime)
+	bool AbstractSensor::step()
 	{
-		try
-		{
-			while (running == true)
-			{
-				std::shared_ptr< AbstractStimulus > currentStimulus = getStimulus();
-				std::shared_ptr< AbstractPercept > currentPercept = getPerceptFor( currentStimulus);
-				sendPercept( currentPercept);
-
-				std::this_thread::sleep_for( std::chrono::milliseconds( aSleepTime));
-
-
-				// this should be either the last call in the loop or
-				// part of the while.
-				//			if (sensorThread.interruption_requested())
-				//			{
-				//				break;
-				//			}
-			}
-		}
-		catch (std::exception& e)
-		{
-			std::cerr << __PRETTY_FUNCTION__ << ": " << e.what() << std::endl;
-		}
-		catch (...)
+		if (running == false)
 		{
-			std::cerr << __PRETTY_FUNCTION__ << ": unknown exception" << std::endl;
+			return false;
 		}
+		std::shared_ptr< AbstractStimulus > currentStimulus = getStimulus();
+		std::shared_ptr< AbstractPercept > currentPercept = getPerceptFor( currentStimulus);
+		sendPercept( currentPercept);
+		return true;
 	}
 	/**
 	 *
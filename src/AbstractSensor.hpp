@@ -5,6 +5,7 @@
 
 #include "Thread.hpp"
 #include "ModelObject.hpp"
+#include "Scheduler.hpp"
 
 namespace Model
 {
@@ -56,7 +57,8 @@ namespace Model
 			 */
 			virtual ~AbstractSensor();
 			/**
-			 * A sensor reads 10 stimuli/second (it sleeps for 100 ms) by default
+			 * A sensor reads 10 stimuli/second (one every 100 ms of simulated time) by default,
+			 * the Scheduler calls step every aSleepTime ms
 			 */
 			virtual void setOn( unsigned long aSleepTime = 100);
 			/**
@@ -76,9 +78,11 @@ namespace Model
 			 */
 			virtual void sendPercept( std::shared_ptr< AbstractPercept > anAbstractPercept);
 			/**
+			 * Reads one stimulus and sends its percept to the agent
 			 *
+			 * @return False if the sensor is off
 			 */
-			virtual void run( unsigned long aSleepTime);
+			virtual bool step();
 			/**
 			 *
 			 */
@@ -104,7 +108,7 @@ namespace Model
 		protected:
 			AbstractAgent* agent;
 			bool running;
-			std::thread sensorThread;
+			Scheduler::TaskId sensorTask;
 			mutable std::recursive_mutex sensorMutex;
 
 		private:
@@ -0,0 +1,351 @@
+#include "AnytimeAStar.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	static const double Infinity = std::numeric_limits< double >::infinity();
+	/**
+	 * The number of expansions of a search or an improvement that is only limited by its deadline
+	 */
+	static const std::size_t NoLimit = std::numeric_limits< std::size_t >::max();
+	/**
+	 * The 8 neighbours of a cell and the cost to move there
+	 */
+	static const int xOffset[] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+	static const int yOffset[] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+	static const double stepCost[] = { 1.0, std::sqrt( 2.0), 1.0, std::sqrt( 2.0), 1.0, std::sqrt( 2.0), 1.0, std::sqrt( 2.0) };
+	/**
+	 *
+	 */
+	static double Distance(	const Vertex& aStart,
+							const Vertex& aGoal)
+	{
+		return std::sqrt( (aStart.x - aGoal.x) * (aStart.x - aGoal.x) + (aStart.y - aGoal.y) * (aStart.y - aGoal.y));
+	}
+	/**
+	 *
+	 */
+	AnytimeAStar::AnytimeAStar(	double anInitialInflation,
+								double anInflationStep) :
+									initialInflation( std::max( 1.0, anInitialInflation)),
+									inflationStep( anInflationStep),
+									inflation( initialInflation),
+									suboptimality( 1.0),
+									finished( true),
+									iterationDone( false),
+									routeCost( Infinity),
+									start( 0, 0),
+									goal( 0, 0),
+									iteration( 0)
+	{
+	}
+	/**
+	 *
+	 */
+	Path AnytimeAStar::search(	const Point& aStartPoint,
+								const Point& aGoalPoint,
+								const Size& aRobotSize,
+								std::chrono::milliseconds aBudget)
+	{
+		Vertex startVertex( aStartPoint);
+		Vertex goalVertex( aGoalPoint);
+
+		return search( startVertex, goalVertex, aRobotSize, aBudget);
+	}
+	/**
+	 *
+	 */
+	Path AnytimeAStar::search(	Vertex aStart,
+								const Vertex& aGoal,
+								const Size& aRobotSize,
+								std::chrono::milliseconds aBudget)
+	{
+		const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + aBudget;
+
+		AStar::fillOccupancyGrid( occupancyGrid, AStar::freeRadius( aRobotSize), robotName);
+		progress.start();
+		closedSet.clear();
+
+		start = Vertex( aStart.x, aStart.y);
+		goal = Vertex( aGoal.x, aGoal.y);
+		inflation = initialInflation;
+		suboptimality = initialInflation;
+		finished = true;
+		iterationDone = false;
+		routeCost = Infinity;
+
+		if (!occupancyGrid.isInside( start.x, start.y) || !occupancyGrid.isInside( goal.x, goal.y))
+		{
+			std::cerr << "**** No route from " << start << " to " << goal << ", outside the world" << std::endl;
+			publishProgress();
+			return Path();
+		}
+
+		const std::size_t numberOfCells = static_cast< std::size_t >( occupancyGrid.getWidth()) * occupancyGrid.getHeight();
+		costs.assign( numberOfCells, Infinity);
+		predecessors.assign( numberOfCells, -1);
+		closedIterations.assign( numberOfCells, 0);
+		isInconsistent.assign( numberOfCells, false);
+		inconsistent.clear();
+		iteration = 1;
+		openSet.reset( occupancyGrid.getWidth(), occupancyGrid.getHeight());
+
+		costs[indexOf( start)] = 0.0;
+		openSet.push( calculateKey( indexOf( start)));
+
+		// The Robot can not move without a route so the first iteration has no deadline
+		std::size_t unlimited = NoLimit;
+		improvePath( std::chrono::steady_clock::time_point::max(), unlimited);
+		iterationDone = true;
+
+		Path path;
+		if (costs[indexOf( goal)] == Infinity)
+		{
+			std::cerr << "**** No route from " << start << " to " << goal << std::endl;
+			publishProgress();
+			return path;
+		}
+
+		suboptimality = calculateSuboptimality();
+		finished = suboptimality <= 1.0;
+		routeCost = costs[indexOf( goal)];
+		constructPath( path);
+
+		improveUntil( path, deadline, NoLimit);
+		return path;
+	}
+	/**
+	 *
+	 */
+	bool AnytimeAStar::improve(	Path& aPath,
+								std::chrono::microseconds aBudget)
+	{
+		return improveUntil( aPath, std::chrono::steady_clock::now() + aBudget, NoLimit);
+	}
+	/**
+	 *
+	 */
+	bool AnytimeAStar::improve(	Path& aPath,
+								std::size_t aNumberOfExpansions)
+	{
+		return improveUntil( aPath, std::chrono::steady_clock::time_point::max(), aNumberOfExpansions);
+	}
+	/**
+	 *
+	 */
+	OpenSet AnytimeAStar::getOpenSet() const
+	{
+		return progress.getOpenSet();
+	}
+	/**
+	 *
+	 */
+	ClosedSet AnytimeAStar::getClosedSet() const
+	{
+		return progress.getClosedSet();
+	}
+	/**
+	 * An interrupted iteration leaves the predecessors consistent: the cost of a cell is always
+	 * higher than the cost of its predecessor, so the route to the goal can be taken at any time.
+	 */
+	bool AnytimeAStar::improveUntil(	Path& aPath,
+										std::chrono::steady_clock::time_point aDeadline,
+										std::size_t aNumberOfExpansions)
+	{
+		std::size_t expansionsLeft = aNumberOfExpansions;
+		while (!finished && expansionsLeft > 0 && std::chrono::steady_clock::now() < aDeadline)
+		{
+			if (iterationDone)
+			{
+				nextIteration();
+				iterationDone = false;
+			}
+			if (!improvePath( aDeadline, expansionsLeft))
+			{
+				break;
+			}
+			iterationDone = true;
+			suboptimality = calculateSuboptimality();
+			finished = suboptimality <= 1.0;
+		}
+		publishProgress();
+
+		const double cost = costs.empty() ? Infinity : costs[indexOf( goal)];
+		if (cost < routeCost)
+		{
+			routeCost = cost;
+			constructPath( aPath);
+			return true;
+		}
+		return false;
+	}
+	/**
+	 *
+	 */
+	bool AnytimeAStar::improvePath(	std::chrono::steady_clock::time_point aDeadline,
+									std::size_t& anExpansionsLeft)
+	{
+		const int goalIndex = indexOf( goal);
+		const int width = occupancyGrid.getWidth();
+
+		std::size_t numberOfExpansions = 0;
+		while (!openSet.empty() && openSet.top().heuristicCost < costs[goalIndex])
+		{
+			if (anExpansionsLeft == 0)
+			{
+				return false;
+			}
+			// Reading the clock costs more than an expansion, it is only read every 64 expansions
+			if ((++numberOfExpansions & 63) == 0 && std::chrono::steady_clock::now() >= aDeadline)
+			{
+				return false;
+			}
+			if (anExpansionsLeft != NoLimit)
+			{
+				--anExpansionsLeft;
+			}
+
+			Vertex current = openSet.top();
+			openSet.pop();
+			const int currentIndex = indexOf( current);
+			closedIterations[currentIndex] = iteration;
+			closedSet.push_back( current);
+
+			for (int i = 0; i < 8; ++i)
+			{
+				int x = current.x + xOffset[i];
+				int y = current.y + yOffset[i];
+				if (!occupancyGrid.isFree( x, y))
+				{
+					continue;
+				}
+
+				const int index = y * width + x;
+				const double cost = costs[currentIndex] + stepCost[i];
+				if (cost < costs[index])
+				{
+					costs[index] = cost;
+					predecessors[index] = currentIndex;
+					if (closedIterations[index] != iteration)
+					{
+						openSet.push( calculateKey( index));
+					} else if (!isInconsistent[index])
+					{
+						// Expanded in this iteration already, it is expanded again in the next iteration
+						isInconsistent[index] = true;
+						inconsistent.push_back( index);
+					}
+				}
+			}
+
+			if (progress.expand())
+			{
+				publishProgress();
+			}
+		}
+		return true;
+	}
+	/**
+	 *
+	 */
+	void AnytimeAStar::nextIteration()
+	{
+		inflation = std::max( 1.0, inflation - inflationStep);
+		// Nothing is expanded in the new iteration yet
+		++iteration;
+		closedSet.clear();
+
+		std::vector< Vertex > open = openSet.getVertices();
+		openSet.clear();
+		for (const Vertex& vertex : open)
+		{
+			openSet.push( calculateKey( indexOf( vertex)));
+		}
+		for (int index : inconsistent)
+		{
+			isInconsistent[index] = false;
+			openSet.push( calculateKey( index));
+		}
+		inconsistent.clear();
+	}
+	/**
+	 * No route through a Vertex in the openSet or in the inconsistent list can be shorter than the
+	 * lowest uninflated cost of those Vertices, which bounds how much longer the route is than the shortest one
+	 */
+	double AnytimeAStar::calculateSuboptimality() const
+	{
+		double minimum = Infinity;
+		for (const Vertex& vertex : openSet.getVertices())
+		{
+			const int index = indexOf( vertex);
+			minimum = std::min( minimum, costs[index] + heuristic( index));
+		}
+		for (int index : inconsistent)
+		{
+			minimum = std::min( minimum, costs[index] + heuristic( index));
+		}
+
+		const double cost = costs[indexOf( goal)];
+		if (minimum >= cost)
+		{
+			return 1.0;
+		}
+		return std::min( inflation, cost / minimum);
+	}
+	/**
+	 *
+	 */
+	Vertex AnytimeAStar::calculateKey( int anIndex) const
+	{
+		Vertex key( anIndex % occupancyGrid.getWidth(), anIndex / occupancyGrid.getWidth());
+		key.actualCost = costs[anIndex];
+		key.heuristicCost = costs[anIndex] + inflation * heuristic( anIndex);
+		return key;
+	}
+	/**
+	 * The costs along the route are recalculated from the cells, during an iteration the cost of a
+	 * cell on the route may already be lower than the cost it had when its successor was reached
+	 */
+	void AnytimeAStar::constructPath( Path& aPath) const
+	{
+		aPath.clear();
+
+		const int width = occupancyGrid.getWidth();
+		for (int index = indexOf( goal); index != -1; index = predecessors[index])
+		{
+			aPath.push_back( Vertex( index % width, index / width));
+		}
+		std::reverse( aPath.begin(), aPath.end());
+
+		for (std::size_t i = 0; i < aPath.size(); ++i)
+		{
+			aPath[i].actualCost = i == 0 ? 0.0 : aPath[i - 1].actualCost + Distance( aPath[i - 1], aPath[i]);
+			aPath[i].heuristicCost = aPath[i].actualCost + Distance( aPath[i], goal);
+		}
+	}
+	/**
+	 *
+	 */
+	void AnytimeAStar::publishProgress()
+	{
+		if (!progress.isEnabled())
+		{
+			return;
+		}
+		progress.publish( openSet.getVertices(), closedSet);
+		notifyObservers();
+	}
+	/**
+	 *
+	 */
+	double AnytimeAStar::heuristic( int anIndex) const
+	{
+		return Distance( Vertex( anIndex % occupancyGrid.getWidth(), anIndex / occupancyGrid.getWidth()), goal);
+	}
+} // namespace PathAlgorithm
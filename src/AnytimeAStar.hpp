@@ -0,0 +1,217 @@
+#ifndef ANYTIMEASTAR_HPP_
+#define ANYTIMEASTAR_HPP_
+
+#include "Config.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "AStar.hpp"
+#include "Notifier.hpp"
+#include "OccupancyGrid.hpp"
+#include "Point.hpp"
+#include "SearchProgress.hpp"
+#include "Size.hpp"
+#include "Vertex.hpp"
+#include "VertexHeap.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 * Anytime Repairing A* (Likhachev, Gordon & Thrun) on the same grid as AStar.
+	 *
+	 * The first route is searched with a heuristic that is inflated by a factor, which expands far
+	 * fewer cells than AStar and gives a route that is at most that factor longer than the shortest one.
+	 * The search is kept and can be continued with improve: every iteration lowers the inflation and
+	 * only re-expands the cells whose cost got lower, until the route is the shortest route.
+	 */
+	class AnytimeAStar : public Base::Notifier
+	{
+		public:
+			/**
+			 *
+			 */
+			explicit AnytimeAStar(	double anInitialInflation = 3.0,
+									double anInflationStep = 0.5);
+			/**
+			 *
+			 */
+			Path search(const Point& aStartPoint,
+						const Point& aGoalPoint,
+						const Size& aRobotSize,
+						std::chrono::milliseconds aBudget);
+			/**
+			 * Searches the first route and improves it until aBudget has passed or the route is the
+			 * shortest route. The first route is always completed, aBudget only limits the improvements.
+			 *
+			 * @return The best route found, empty if there is no route
+			 */
+			Path search(Vertex aStart,
+						const Vertex& aGoal,
+						const Size& aRobotSize,
+						std::chrono::milliseconds aBudget);
+			/**
+			 * Continues the improvement of the last search for at most aBudget
+			 *
+			 * @return True if a shorter route than the last one that was returned was put in aPath
+			 */
+			bool improve(	Path& aPath,
+							std::chrono::microseconds aBudget);
+			/**
+			 * Continues the improvement of the last search for at most aNumberOfExpansions expansions.
+			 * Unlike a budget of time it improves the route the same way on every computer.
+			 *
+			 * @return True if a shorter route than the last one that was returned was put in aPath
+			 */
+			bool improve(	Path& aPath,
+							std::size_t aNumberOfExpansions);
+			/**
+			 *
+			 * @return True if the last route that was returned is the shortest route or if there is no route
+			 */
+			bool isFinished() const
+			{
+				return finished;
+			}
+			/**
+			 *
+			 * @return The factor the last route that was returned is at most longer than the shortest route
+			 */
+			double getSuboptimality() const
+			{
+				return suboptimality;
+			}
+			/**
+			 *
+			 * @return The openSet of the last snapshot of the search
+			 */
+			OpenSet getOpenSet() const;
+			/**
+			 *
+			 * @return The Vertices that were expanded in the last snapshot of the search
+			 */
+			ClosedSet getClosedSet() const;
+			/**
+			 *
+			 * @return The grid the last search was done on
+			 */
+			const OccupancyGrid& getOccupancyGrid() const
+			{
+				return occupancyGrid;
+			}
+			/**
+			 * The Robot that plans with this AnytimeAStar is not an obstacle for its own routes, with
+			 * an empty name all Robots are obstacles
+			 */
+			void setRobotName( const std::string& aRobotName)
+			{
+				robotName = aRobotName;
+			}
+			/**
+			 *
+			 */
+			const std::string& getRobotName() const
+			{
+				return robotName;
+			}
+			/**
+			 * The snapshots of the search for a visualiser, every snapshot notifies the observers
+			 */
+			SearchProgress& getProgress()
+			{
+				return progress;
+			}
+
+		private:
+			/**
+			 * Runs and starts iterations until aDeadline has passed, aNumberOfExpansions cells were
+			 * expanded or the route is the shortest route
+			 */
+			bool improveUntil(	Path& aPath,
+								std::chrono::steady_clock::time_point aDeadline,
+								std::size_t aNumberOfExpansions);
+			/**
+			 * The ImprovePath of the paper: expands the openSet until no Vertex in it can lead to a
+			 * shorter route to the goal with the current inflation.
+			 *
+			 * @param anExpansionsLeft The number of cells that may still be expanded, lowered by every expansion
+			 * @return False if aDeadline passed or no expansions were left first, the expansion can then be continued by a next call
+			 */
+			bool improvePath(	std::chrono::steady_clock::time_point aDeadline,
+								std::size_t& anExpansionsLeft);
+			/**
+			 * Lowers the inflation, moves the inconsistent Vertices back into the openSet and gives
+			 * every Vertex in the openSet the key for the new inflation
+			 */
+			void nextIteration();
+			/**
+			 *
+			 * @return The bound on the length of the route found by the last iteration
+			 */
+			double calculateSuboptimality() const;
+			/**
+			 *
+			 */
+			Vertex calculateKey( int anIndex) const;
+			/**
+			 *
+			 */
+			void constructPath( Path& aPath) const;
+			/**
+			 * Copies the openSet and the closedSet into the snapshot and notifies the observers
+			 */
+			void publishProgress();
+			/**
+			 *
+			 */
+			int indexOf( const Vertex& aVertex) const
+			{
+				return aVertex.y * occupancyGrid.getWidth() + aVertex.x;
+			}
+			/**
+			 *
+			 */
+			double heuristic( int anIndex) const;
+
+			double initialInflation;
+			double inflationStep;
+			double inflation;
+			double suboptimality;
+			bool finished;
+			/**
+			 * True if improvePath ran until its end with the current inflation
+			 */
+			bool iterationDone;
+			/**
+			 * The length of the last route that was returned
+			 */
+			double routeCost;
+
+			Vertex start;
+			Vertex goal;
+			OccupancyGrid occupancyGrid;
+			std::string robotName;
+			/**
+			 * The cost from the start per cell, g of the paper
+			 */
+			std::vector< double > costs;
+			std::vector< int > predecessors;
+			/**
+			 * The iteration in which a cell was expanded, a cell is in CLOSED of the paper if it is the current iteration
+			 */
+			std::vector< unsigned int > closedIterations;
+			unsigned int iteration;
+			/**
+			 * The cells that got a lower cost after they were expanded in the current iteration, INCONS of the paper
+			 */
+			std::vector< int > inconsistent;
+			std::vector< bool > isInconsistent;
+			VertexHeap openSet;
+			ClosedSet closedSet;
+
+			SearchProgress progress;
+	}; // class AnytimeAStar
+} // namespace PathAlgorithm
+#endif // ANYTIMEASTAR_HPP_
@@ -0,0 +1,158 @@
+#include "Benchmark.hpp"
+#include <chrono>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "AStar.hpp"
+#include "Goal.hpp"
+#include "JumpPointSearch.hpp"
+#include "PlanningService.hpp"
+#include "Robot.hpp"
+#include "RobotWorld.hpp"
+
+namespace Application
+{
+	/**
+	 * Plans the route of aRobot to aGoal aNumberOfRuns times with aPlanner and reports the results as aName
+	 */
+	template< typename Planner >
+	void MeasurePlanner(	std::ostream& os,
+							const std::string& aName,
+							Planner& aPlanner,
+							Model::RobotPtr aRobot,
+							Model::GoalPtr aGoal,
+							unsigned long aNumberOfRuns)
+	{
+		PathAlgorithm::Path path;
+		aPlanner.setRobotName( aRobot->getName());
+
+		std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+		for (unsigned long run = 0; run < aNumberOfRuns; ++run)
+		{
+			path = aPlanner.search( aRobot->getPosition(), aGoal->getPosition(), aRobot->getSize());
+		}
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+		long long totalMicroseconds = std::chrono::duration_cast< std::chrono::microseconds >( end - begin).count();
+		os << "  " << aName
+		   << ": path length " << path.size()
+		   << ", expansions " << aPlanner.getProgress().getNumberOfExpansions()
+		   << ", " << totalMicroseconds / static_cast< long long >( aNumberOfRuns ? aNumberOfRuns : 1) << " us/search"
+		   << std::endl;
+	}
+	/**
+	 *
+	 */
+	/* static */void Benchmark::runSituations(	std::ostream& os,
+												unsigned long aNumberOfRuns /*= 10*/)
+	{
+		Model::RobotWorld& robotWorld = Model::RobotWorld::getRobotWorld();
+
+		std::vector< std::function< void() > > situations = {	[&robotWorld]{ robotWorld.situationOne();},
+																[&robotWorld]{ robotWorld.situationTwo();},
+																[&robotWorld]{ robotWorld.situationThree();},
+																[&robotWorld]{ robotWorld.situationFour();},
+																[&robotWorld]{ robotWorld.situationFive();},
+																[&robotWorld]{ robotWorld.situationSix();}};
+
+		for (std::size_t i = 0; i < situations.size(); ++i)
+		{
+			situations[i]();
+
+			Model::RobotPtr robot = robotWorld.getRobot( "Robot");
+			Model::GoalPtr goal = robotWorld.getGoal( "Goal");
+			if (!robot || !goal)
+			{
+				os << "situation " << i + 1 << ": no Robot or Goal" << std::endl;
+				continue;
+			}
+			// The size a RobotShape gives a Robot with the default title
+			robot->setSize( Size( 37, 29), false);
+
+			os << "situation " << i + 1 << std::endl;
+
+			PathAlgorithm::AStar astar;
+			MeasurePlanner( os, "astar", astar, robot, goal, aNumberOfRuns);
+
+			PathAlgorithm::JumpPointSearch jumpPointSearch;
+			MeasurePlanner( os, "jps", jumpPointSearch, robot, goal, aNumberOfRuns);
+		}
+	}
+	/**
+	 * Plans someRequests on aPlanningService and reports the results
+	 */
+	void MeasureBatch(	std::ostream& os,
+						PathAlgorithm::PlanningService& aPlanningService,
+						const std::vector< PathAlgorithm::PlanningService::Request >& someRequests)
+	{
+		std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+		std::vector< std::future< PathAlgorithm::Path > > futures = aPlanningService.plan( someRequests);
+
+		unsigned long numberOfRoutes = 0;
+		for (std::future< PathAlgorithm::Path >& future : futures)
+		{
+			if (!future.get().empty())
+			{
+				++numberOfRoutes;
+			}
+		}
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+		long long totalMicroseconds = std::chrono::duration_cast< std::chrono::microseconds >( end - begin).count();
+		os << "  " << aPlanningService.getNumberOfWorkers() << " worker(s)"
+		   << ": " << numberOfRoutes << " routes"
+		   << ", " << totalMicroseconds / 1000 << " ms"
+		   << ", " << static_cast< double >( someRequests.size()) * 1000000.0 / static_cast< double >( totalMicroseconds ? totalMicroseconds : 1) << " routes/s"
+		   << std::endl;
+	}
+	/**
+	 *
+	 */
+	/* static */void Benchmark::runBatch(	std::ostream& os,
+											unsigned long aNumberOfRequests /*= 128*/)
+	{
+		Model::RobotWorld& robotWorld = Model::RobotWorld::getRobotWorld();
+		robotWorld.situationThree();
+
+		// The size a RobotShape gives a Robot with the default title
+		const Size robotSize( 37, 29);
+		// The routes are those of the Robot of the situation, the other robots are obstacles
+		const std::string robotName( "Robot");
+
+		PathAlgorithm::OccupancyGrid occupancyGrid;
+		PathAlgorithm::AStar::fillOccupancyGrid( occupancyGrid, PathAlgorithm::AStar::freeRadius( robotSize), robotName);
+
+		// A fixed seed so that every run plans the same routes
+		std::mt19937 generator( 1);
+		std::uniform_int_distribution< int > xDistribution( 0, occupancyGrid.getWidth() - 1);
+		std::uniform_int_distribution< int > yDistribution( 0, occupancyGrid.getHeight() - 1);
+		std::function< Point() > randomFreePoint = [&]
+		{
+			for (;;)
+			{
+				Point point( xDistribution( generator), yDistribution( generator));
+				if (occupancyGrid.isFree( point.x, point.y))
+				{
+					return point;
+				}
+			}
+		};
+
+		std::vector< PathAlgorithm::PlanningService::Request > requests;
+		for (unsigned long i = 0; i < aNumberOfRequests; ++i)
+		{
+			Point start = randomFreePoint();
+			Point goal = randomFreePoint();
+			requests.push_back( PathAlgorithm::PlanningService::Request{ start, goal, robotSize, robotName, false });
+		}
+
+		os << "batch of " << aNumberOfRequests << " requests" << std::endl;
+
+		PathAlgorithm::PlanningService singleWorker( 1);
+		MeasureBatch( os, singleWorker, requests);
+
+		PathAlgorithm::PlanningService allWorkers;
+		MeasureBatch( os, allWorkers, requests);
+	}
+} // namespace Application
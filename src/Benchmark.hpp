@@ -0,0 +1,40 @@
+#ifndef BENCHMARK_HPP_
+#define BENCHMARK_HPP_
+
+#include "Config.hpp"
+
+#include <iostream>
+
+namespace Application
+{
+	/**
+	 * Measures the path planning of the Robot in the built-in situations of the RobotWorld.
+	 *
+	 * Run the application with "-benchmark" (and optionally "-benchmark_runs=n" and
+	 * "-benchmark_batch=n") to print the results on std::cout instead of starting the GUI.
+	 */
+	class Benchmark
+	{
+		public:
+			/**
+			 * Plans the route of "Robot" to "Goal" aNumberOfRuns times in each situation with every
+			 * planner and reports the path length, the closedSet and the average duration of a search.
+			 *
+			 * @param os The stream to write the results to
+			 * @param aNumberOfRuns The number of searches per situation
+			 */
+			static void runSituations(	std::ostream& os,
+										unsigned long aNumberOfRuns = 10);
+			/**
+			 * Plans aNumberOfRequests routes between random free points of situation three as one batch
+			 * on a PlanningService with one worker and on one with a worker per hardware thread.
+			 *
+			 * @param os The stream to write the results to
+			 * @param aNumberOfRequests The number of routes in the batch
+			 */
+			static void runBatch(	std::ostream& os,
+									unsigned long aNumberOfRequests = 128);
+	};
+	// class Benchmark
+} // namespace Application
+#endif // BENCHMARK_HPP_
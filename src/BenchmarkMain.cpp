@@ -0,0 +1,117 @@
+#include "Config.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Commandline.hpp"
+#include "MapBenchmark.hpp"
+#include "RobotWorld.hpp"
+#include "SelfCheck.hpp"
+
+/**
+ * The allocations of the planners are counted by replacing the global operator new of this program
+ */
+void* operator new( std::size_t aSize)
+{
+	Application::MapBenchmark::countAllocation();
+	if (void* memory = std::malloc( aSize ? aSize : 1))
+	{
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+void* operator new[]( std::size_t aSize)
+{
+	return operator new( aSize);
+}
+void operator delete( void* aMemory) noexcept
+{
+	std::free( aMemory);
+}
+void operator delete[]( void* aMemory) noexcept
+{
+	std::free( aMemory);
+}
+void operator delete(	void* aMemory,
+						std::size_t) noexcept
+{
+	std::free( aMemory);
+}
+void operator delete[](	void* aMemory,
+						std::size_t) noexcept
+{
+	std::free( aMemory);
+}
+
+/**
+ * Runs the planners on the generated maps without starting the GUI:
+ *
+ * robotworld_benchmark [-runs=n] [-seed=n] [-world_size=n] [-format=text|csv|json] [-output=file]
+ * robotworld_benchmark -check
+ *
+ * With -check it runs the checks of the planners instead and fails if one of them fails.
+ */
+int main( 	int argc,
+			char* argv[])
+{
+	try
+	{
+		Application::Commandline::setCommandlineArguments( argc, argv);
+
+		if (Application::Commandline::isArgGiven( "-check"))
+		{
+			return Application::SelfCheck::run( std::cout) ? 0 : 1;
+		}
+
+		unsigned long numberOfRuns = 10;
+		if (Application::Commandline::isArgGiven( "-runs"))
+		{
+			numberOfRuns = std::stoul( Application::Commandline::getArg( "-runs").value);
+		}
+		unsigned long seed = 1;
+		if (Application::Commandline::isArgGiven( "-seed"))
+		{
+			seed = std::stoul( Application::Commandline::getArg( "-seed").value);
+		}
+		// As in the application, the situations and the generated maps have the size of the RobotWorld
+		if (Application::Commandline::isArgGiven( "-world_size"))
+		{
+			int worldSize = std::stoi( Application::Commandline::getArg( "-world_size").value);
+			Model::RobotWorld::getRobotWorld().setWorldSize( Size( worldSize, worldSize), false);
+		}
+		Application::MapBenchmark::Format format = Application::MapBenchmark::Format::Text;
+		if (Application::Commandline::isArgGiven( "-format"))
+		{
+			format = Application::MapBenchmark::asFormat( Application::Commandline::getArg( "-format").value);
+		}
+
+		// The size a RobotShape gives a Robot with the default title
+		std::vector< Application::MapBenchmark::Result > results = Application::MapBenchmark::run( Application::MapBenchmark::getMaps( seed, Model::RobotWorld::getRobotWorld().getWorldSize()), Size( 37, 29), numberOfRuns);
+
+		if (Application::Commandline::isArgGiven( "-output"))
+		{
+			std::ofstream file( Application::Commandline::getArg( "-output").value);
+			if (!file)
+			{
+				throw std::runtime_error( "Can not open " + Application::Commandline::getArg( "-output").value);
+			}
+			Application::MapBenchmark::write( file, results, format);
+		} else
+		{
+			Application::MapBenchmark::write( std::cout, results, format);
+		}
+		return 0;
+	}
+	catch (std::exception& e)
+	{
+		std::cerr << __PRETTY_FUNCTION__ << ": " << e.what() << std::endl;
+	}
+	catch (...)
+	{
+		std::cerr << __PRETTY_FUNCTION__ << ": unknown exception" << std::endl;
+	}
+	return 1;
+}
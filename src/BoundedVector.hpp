@@ -49,6 +49,15 @@ class BoundedVector
 						y( aPolarCoord.y)
 		{
 		}
+		/**
+		 *
+		 */
+		BoundedVector& operator=( const BoundedVector& aVector)
+		{
+			x = aVector.x;
+			y = aVector.y;
+			return *this;
+		}
 		/**
 		 *
 		 */
@@ -0,0 +1,164 @@
+#include "CollisionGrid.hpp"
+
+#include <algorithm>
+
+namespace Model
+{
+	/**
+	 *
+	 */
+	bool CollisionGrid::CellRange::operator==( const CellRange& aCellRange) const
+	{
+		return left == aCellRange.left && top == aCellRange.top && right == aCellRange.right && bottom == aCellRange.bottom;
+	}
+	/**
+	 *
+	 */
+	CollisionGrid::CollisionGrid( int aCellSize /*= DefaultCellSize*/) :
+								cellSize( std::max( aCellSize, 1))
+	{
+	}
+	/**
+	 *
+	 */
+	void CollisionGrid::addRobot(	Robot* aRobot,
+									const Point& aTopLeft,
+									const Point& aBottomRight)
+	{
+		const CellRange cellRange = getCellRange( aTopLeft, aBottomRight);
+
+		std::lock_guard< std::mutex > lock( gridMutex);
+		auto i = robotRanges.find( aRobot);
+		if (i != robotRanges.end())
+		{
+			removeRobotFromCells( aRobot, i->second);
+			robotRanges.erase( i);
+		}
+		robotRanges.insert( std::make_pair( aRobot, cellRange));
+		addRobotToCells( aRobot, cellRange);
+	}
+	/**
+	 *
+	 */
+	void CollisionGrid::moveRobot(	Robot* aRobot,
+									const Point& aTopLeft,
+									const Point& aBottomRight)
+	{
+		const CellRange cellRange = getCellRange( aTopLeft, aBottomRight);
+
+		std::lock_guard< std::mutex > lock( gridMutex);
+		auto i = robotRanges.find( aRobot);
+		// Most moves stay within the same cells
+		if (i == robotRanges.end() || i->second == cellRange)
+		{
+			return;
+		}
+		removeRobotFromCells( aRobot, i->second);
+		i->second = cellRange;
+		addRobotToCells( aRobot, cellRange);
+	}
+	/**
+	 *
+	 */
+	void CollisionGrid::removeRobot( Robot* aRobot)
+	{
+		std::lock_guard< std::mutex > lock( gridMutex);
+		auto i = robotRanges.find( aRobot);
+		if (i != robotRanges.end())
+		{
+			removeRobotFromCells( aRobot, i->second);
+			robotRanges.erase( i);
+		}
+	}
+	/**
+	 *
+	 */
+	void CollisionGrid::clear()
+	{
+		std::lock_guard< std::mutex > lock( gridMutex);
+		robotCells.clear();
+		robotRanges.clear();
+	}
+	/**
+	 *
+	 */
+	void CollisionGrid::findRobots(	const Point& aTopLeft,
+									const Point& aBottomRight,
+									std::vector< Robot* >& someRobots) const
+	{
+		someRobots.clear();
+		const CellRange cellRange = getCellRange( aTopLeft, aBottomRight);
+
+		std::lock_guard< std::mutex > lock( gridMutex);
+		for (int row = cellRange.top; row <= cellRange.bottom; ++row)
+		{
+			for (int column = cellRange.left; column <= cellRange.right; ++column)
+			{
+				auto i = robotCells.find( getKey( column, row));
+				if (i != robotCells.end())
+				{
+					someRobots.insert( someRobots.end(), i->second.begin(), i->second.end());
+				}
+			}
+		}
+		// A Robot that is in more than one of the cells is found more than once
+		std::sort( someRobots.begin(), someRobots.end());
+		someRobots.erase( std::unique( someRobots.begin(), someRobots.end()), someRobots.end());
+	}
+	/**
+	 * Rounds towards minus infinity, objects left of or above the world are in negative cells
+	 */
+	CollisionGrid::CellRange CollisionGrid::getCellRange(	const Point& aTopLeft,
+															const Point& aBottomRight) const
+	{
+		auto cell = [this]( int aCoordinate)
+		{
+			return aCoordinate >= 0 ? aCoordinate / cellSize : -((-aCoordinate - 1) / cellSize) - 1;
+		};
+		return CellRange{ cell( std::min( aTopLeft.x, aBottomRight.x)), cell( std::min( aTopLeft.y, aBottomRight.y)), cell( std::max( aTopLeft.x, aBottomRight.x)), cell( std::max( aTopLeft.y, aBottomRight.y)) };
+	}
+	/**
+	 *
+	 */
+	/* static */long long CollisionGrid::getKey(	int aColumn,
+												int aRow)
+	{
+		return (static_cast< long long >( aColumn) << 32) ^ static_cast< long long >( static_cast< unsigned int >( aRow));
+	}
+	/**
+	 *
+	 */
+	void CollisionGrid::addRobotToCells(	Robot* aRobot,
+											const CellRange& aCellRange)
+	{
+		for (int row = aCellRange.top; row <= aCellRange.bottom; ++row)
+		{
+			for (int column = aCellRange.left; column <= aCellRange.right; ++column)
+			{
+				robotCells[getKey( column, row)].push_back( aRobot);
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	void CollisionGrid::removeRobotFromCells(	Robot* aRobot,
+												const CellRange& aCellRange)
+	{
+		for (int row = aCellRange.top; row <= aCellRange.bottom; ++row)
+		{
+			for (int column = aCellRange.left; column <= aCellRange.right; ++column)
+			{
+				auto i = robotCells.find( getKey( column, row));
+				if (i != robotCells.end())
+				{
+					i->second.erase( std::remove( i->second.begin(), i->second.end(), aRobot), i->second.end());
+					if (i->second.empty())
+					{
+						robotCells.erase( i);
+					}
+				}
+			}
+		}
+	}
+} // namespace Model
@@ -0,0 +1,109 @@
+#ifndef COLLISIONGRID_HPP_
+#define COLLISIONGRID_HPP_
+
+#include "Config.hpp"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "Point.hpp"
+
+namespace Model
+{
+	class Robot;
+
+	/**
+	 * The broadphase of the collision tests between Robots: a uniform grid of square cells that
+	 * knows which Robots of the RobotWorld are in which cells. The Walls, which hardly ever move,
+	 * are in the WallTree.
+	 *
+	 * A Robot is in every cell its bounding box touches and moves to other cells when its pose
+	 * changes. A query returns the Robots in the cells of a bounding box, a superset of the Robots
+	 * that can overlap it, so the exact tests only run on Robots nearby. Only the cells that contain
+	 * something are stored.
+	 */
+	class CollisionGrid
+	{
+		public:
+			/**
+			 * The width and height of a cell, about two robots
+			 */
+			static const int DefaultCellSize = 64;
+			/**
+			 *
+			 */
+			explicit CollisionGrid( int aCellSize = DefaultCellSize);
+			/**
+			 * Adds aRobot with the bounding box from aTopLeft to aBottomRight
+			 */
+			void addRobot(	Robot* aRobot,
+							const Point& aTopLeft,
+							const Point& aBottomRight);
+			/**
+			 * Moves aRobot to the cells of its new bounding box, a Robot that was not added is ignored
+			 */
+			void moveRobot(	Robot* aRobot,
+							const Point& aTopLeft,
+							const Point& aBottomRight);
+			/**
+			 *
+			 */
+			void removeRobot( Robot* aRobot);
+			/**
+			 * Removes all Robots
+			 */
+			void clear();
+			/**
+			 * Replaces someRobots by the Robots in the cells of the bounding box from aTopLeft to
+			 * aBottomRight, every Robot once and in no particular order
+			 */
+			void findRobots(	const Point& aTopLeft,
+								const Point& aBottomRight,
+								std::vector< Robot* >& someRobots) const;
+			/**
+			 *
+			 */
+			int getCellSize() const
+			{
+				return cellSize;
+			}
+
+		private:
+			/**
+			 * The columns and rows of the cells of a bounding box, both inclusive
+			 */
+			struct CellRange
+			{
+					bool operator==( const CellRange& aCellRange) const;
+
+					int left;
+					int top;
+					int right;
+					int bottom;
+			};
+			/**
+			 *
+			 */
+			CellRange getCellRange(	const Point& aTopLeft,
+									const Point& aBottomRight) const;
+			/**
+			 *
+			 */
+			static long long getKey(	int aColumn,
+										int aRow);
+			/**
+			 * Adds or removes aRobot in the cells of aCellRange, the caller holds gridMutex
+			 */
+			void addRobotToCells(	Robot* aRobot,
+									const CellRange& aCellRange);
+			void removeRobotFromCells(	Robot* aRobot,
+										const CellRange& aCellRange);
+
+			int cellSize;
+			std::unordered_map< long long, std::vector< Robot* > > robotCells;
+			std::unordered_map< Robot*, CellRange > robotRanges;
+			mutable std::mutex gridMutex;
+	}; // class CollisionGrid
+} // namespace Model
+#endif // COLLISIONGRID_HPP_
@@ -0,0 +1,96 @@
+#include "Commandline.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace Application
+{
+	/* static */std::vector< CommandlineArgument > Commandline::commandlineArguments;
+	/* static */std::vector< std::string > Commandline::commandlineFiles;
+
+	/* static */void Commandline::setCommandlineArguments( 	int argc,
+																char* argv[])
+	{
+		// Setting the arguments again replaces them, a replay runs with the arguments of the recorded run
+		Commandline::commandlineArguments.clear();
+		Commandline::commandlineFiles.clear();
+
+		// argv[0] contains the executable name as one types on the command line (with or without extension)
+		Commandline::commandlineArguments.push_back( CommandlineArgument( 0, "Executable", argv[0]));
+
+		for (int i = 1; i < argc; ++i)
+		{
+			char* currentArg = argv[i];
+			size_t argLength = std::strlen( currentArg);
+
+
+			// If the first char of the argument is not a "-" we assume that is is
+			// a filename otherwise it is an ordinary argument
+
+			if (currentArg[0] == '-') // ordinary argument
+			{
+				bool inserted = false;
+
+				// First handle the arguments in the form of "variable=value", and find the "="
+
+				for (size_t j = 0; j < argLength; ++j)
+				{
+					if (currentArg[j] == '=')
+					{
+						std::string variable( currentArg, j);
+						std::string value( &currentArg[j + 1]);
+						Commandline::commandlineArguments.push_back( CommandlineArgument( i, variable, value));
+						inserted = true;
+					}
+				}
+
+				// Second handle the stand alone arguments.
+
+				// If inserted is
+
+				// It is assumed that they are actually booleans.
+				// If given on the command line than the variable will be set to true as if
+				// variable=true is passed
+				if (inserted == false)
+				{
+					std::string variable( currentArg);
+					std::string value( "true");
+					Commandline::commandlineArguments.push_back( CommandlineArgument( i, variable, value));
+				}
+			} else // file argument
+			{
+				Commandline::commandlineFiles.push_back( currentArg);
+			}
+		}
+	}
+
+	/* static */bool Commandline::isArgGiven( const std::string& aVariable)
+	{
+		std::vector< CommandlineArgument >::iterator i = std::find( Commandline::commandlineArguments.begin(), Commandline::commandlineArguments.end(), aVariable);
+		return i != commandlineArguments.end();
+	}
+
+	/* static */CommandlineArgument& Commandline::getArg( const std::string& aVariable)
+	{
+		std::vector< CommandlineArgument >::iterator i = std::find( Commandline::commandlineArguments.begin(), Commandline::commandlineArguments.end(), aVariable);
+		if (i == Commandline::commandlineArguments.end())
+		{
+			throw std::invalid_argument( "No such command line argument");
+		}
+		return *i;
+	}
+
+	/* static */CommandlineArgument& Commandline::getArg( unsigned long anArgumentNumber)
+	{
+		if(anArgumentNumber >= Commandline::commandlineArguments.size())
+		{
+			throw std::invalid_argument( "No such command line argument");
+		}
+		return Commandline::commandlineArguments[anArgumentNumber];
+	}
+
+	/* static */std::vector< std::string >& Commandline::getCommandlineFiles()
+	{
+		return commandlineFiles;
+	}
+} // namespace Application
@@ -0,0 +1,68 @@
+#ifndef COMMANDLINE_HPP_
+#define COMMANDLINE_HPP_
+
+#include "Config.hpp"
+
+#include <string>
+#include <vector>
+
+#include "CommandlineArgument.hpp"
+
+namespace Application
+{
+	/**
+	 * The arguments the program was started with, for the GUI and the programs without one
+	 */
+	class Commandline
+	{
+		public:
+			/**
+			 * @name Command line handling functions
+			 */
+			//@{
+			/**
+			 * The handling of the arguments is:
+			 * 1. Any argument starting with "-" that has "=" in it somewhere is treated as "argument = value". Spaces are not allowed.
+			 * 2. Any argument starting with a "-" that has no "=" in it somewhere is treated as a boolean with the value "true". There are no variables that can be false.
+			 * 3. Arguments without "-" prefix are assumed to be files.
+			 * 4. The "-" is NOT stripped from the argument.
+			 *
+			 * @param argc the count of the arguments
+			 * @param argv the array with the values of the arguments
+			 */
+			static void setCommandlineArguments( 	int argc,
+													char* argv[]);
+			/**
+			 *
+			 * @param aVariable The format of the variable is implementation defined.
+			 * 					Be aware that "-" is NOT stripped from the argument.
+			 * 					The comparisson is done by operator==( const string&).
+			 * @return true if the argument is given, false otherwise.
+			 */
+			static bool isArgGiven( const std::string& aVariable);
+			/**
+			 *
+			 * @param aVariable The requested variable
+			 * @return The requested argument if available, throws an exception otherwise
+			 */
+			static CommandlineArgument& getArg( const std::string& aVariable);
+			/**
+			 *
+			 * @param anArgumentNumber The requested variable
+			 * @return The requested argument if available, throws an exception otherwise
+			 */
+			static CommandlineArgument& getArg( unsigned long anArgumentNumber);
+			/**
+			 *
+			 * @return Any files that are given on the command line.
+			 */
+			static std::vector< std::string >& getCommandlineFiles();
+			//@}
+
+		private:
+			static std::vector< CommandlineArgument > commandlineArguments;
+			static std::vector< std::string > commandlineFiles;
+	};
+	//	class Commandline
+} // namespace Application
+#endif // COMMANDLINE_HPP_
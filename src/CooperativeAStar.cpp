@@ -0,0 +1,292 @@
+#include "CooperativeAStar.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+
+namespace PathAlgorithm
+{
+	/**
+	 * Waiting and the 8 neighbours of a cell
+	 */
+	static const int xOffset[] = { 0, 0, 1, 1, 1, 0, -1, -1, -1 };
+	static const int yOffset[] = { 0, 1, 1, 0, -1, -1, -1, 0, 1 };
+	/**
+	 *
+	 */
+	CooperativeAStar::CooperativeAStar() :
+								step( DefaultStep),
+								maximumDelay( DefaultMaximumDelay),
+								maximumExpansions( DefaultMaximumExpansions)
+	{
+	}
+	/**
+	 *
+	 */
+	Path CooperativeAStar::search(	const std::string& anOwner,
+									const Point& aStartPoint,
+									const Point& aGoalPoint,
+									const Size& aRobotSize,
+									ReservationTable& aTable)
+	{
+		int radius = AStar::freeRadius( aRobotSize);
+
+		std::vector< std::string > ignoredRobots = aTable.getOwners();
+		ignoredRobots.push_back( anOwner);
+		fillOccupancyGrid( radius, ignoredRobots);
+
+		long startTick = ReservationTable::getCurrentTick();
+		Path path = search( anOwner, Vertex( aStartPoint), Vertex( aGoalPoint), radius, occupancyGrid, aTable, startTick);
+		if (path.empty())
+		{
+			aTable.release( anOwner);
+		} else
+		{
+			aTable.reserve( anOwner, path, radius, startTick);
+		}
+		return path;
+	}
+	/**
+	 *
+	 */
+	std::vector< Path > CooperativeAStar::search(	const std::vector< Agent >& someAgents,
+													ReservationTable& aTable,
+													long aStartTick)
+	{
+		std::vector< std::string > ignoredRobots = aTable.getOwners();
+		for (const Agent& agent : someAgents)
+		{
+			ignoredRobots.push_back( agent.name);
+		}
+
+		std::vector< Path > paths;
+		int filledRadius = -1;
+		for (const Agent& agent : someAgents)
+		{
+			int radius = AStar::freeRadius( agent.robotSize);
+			if (radius != filledRadius)
+			{
+				fillOccupancyGrid( radius, ignoredRobots);
+				filledRadius = radius;
+			}
+
+			paths.push_back( search( agent.name, Vertex( agent.start), Vertex( agent.goal), radius, occupancyGrid, aTable, aStartTick));
+			if (paths.back().empty())
+			{
+				// Without a route the agent stays where it is
+				aTable.reserve( agent.name, Path( 1, Vertex( agent.start)), radius, aStartTick);
+			} else
+			{
+				aTable.reserve( agent.name, paths.back(), radius, aStartTick);
+			}
+		}
+		return paths;
+	}
+	/**
+	 * The search moves aStep pixels per move and a move takes aStep ticks, so that the number of
+	 * states is independent of the resolution of the grid. A move is only allowed if the line of
+	 * pixels it covers is free. Between two moves the robots can come aStep pixels closer than at
+	 * the moves themselves, so the conflicts are checked with aStep pixels extra clearance.
+	 *
+	 * Every move takes the same time so the cost of a state is its number of moves and the first
+	 * time a state is reached is the cheapest. Ties are broken towards the goal.
+	 */
+	Path CooperativeAStar::search(	const std::string& anOwner,
+									const Vertex& aStart,
+									const Vertex& aGoal,
+									int aRadius,
+									const OccupancyGrid& aGrid,
+									const ReservationTable& aTable,
+									long aStartTick)
+	{
+		if (!aGrid.isInside( aStart.x, aStart.y) || !aGrid.isInside( aGoal.x, aGoal.y))
+		{
+			std::cerr << "**** No route from " << aStart << " to " << aGoal << ", outside the world" << std::endl;
+			return Path();
+		}
+
+		calculateDistances( aStart, aGoal, aGrid);
+
+		const int width = aGrid.getWidth();
+		const int height = aGrid.getHeight();
+		auto distanceOf = [this, width]( int anX, int anY)
+		{
+			return distances[static_cast< std::size_t >( anY) * width + anX];
+		};
+		// The number of moves of aStep pixels that is at least needed for a distance in pixels
+		auto movesOf = [this]( int aDistance)
+		{
+			return (aDistance + step - 1) / step;
+		};
+		auto stateOf = [width, height]( int anX, int anY, long aMove)
+		{
+			return (static_cast< std::uint64_t >( aMove) * height + anY) * width + anX;
+		};
+
+		if (distanceOf( aStart.x, aStart.y) < 0)
+		{
+			std::cerr << "**** No route from " << aStart << " to " << aGoal << std::endl;
+			return Path();
+		}
+		const long maximumMove = movesOf( distanceOf( aStart.x, aStart.y)) + maximumDelay / step;
+
+		typedef std::tuple< long, int, std::uint64_t > Entry;
+		std::priority_queue< Entry, std::vector< Entry >, std::greater< Entry > > openSet;
+		// The predecessor of every state that was reached, the start is its own predecessor
+		std::unordered_map< std::uint64_t, std::uint64_t > predecessors;
+
+		std::uint64_t startState = stateOf( aStart.x, aStart.y, 0);
+		predecessors[startState] = startState;
+		openSet.push( Entry( movesOf( distanceOf( aStart.x, aStart.y)), distanceOf( aStart.x, aStart.y), startState));
+
+		std::size_t numberOfExpansions = 0;
+		while (!openSet.empty() && numberOfExpansions < maximumExpansions)
+		{
+			std::uint64_t state = std::get< 2 >( openSet.top());
+			openSet.pop();
+			++numberOfExpansions;
+
+			Vertex current( static_cast< int >( state % width), static_cast< int >( (state / width) % height));
+			long move = static_cast< long >( state / width / height);
+
+			if (current.equalPoint( aGoal) && aTable.isFreeFrom( anOwner, aGoal, aRadius, aStartTick + move * step))
+			{
+				return constructPath( predecessors, state, width, height);
+			}
+			if (move >= maximumMove)
+			{
+				continue;
+			}
+
+			for (int i = 0; i < 10; ++i)
+			{
+				Vertex next( current.x, current.y);
+				if (i < 9)
+				{
+					next = Vertex( current.x + xOffset[i] * step, current.y + yOffset[i] * step);
+				} else if (std::max( std::abs( aGoal.x - current.x), std::abs( aGoal.y - current.y)) <= step)
+				{
+					// The goal is not on the lattice of the start, it is reached with one shorter move
+					next = aGoal;
+				} else
+				{
+					break;
+				}
+
+				// The robot may always stay where it is, even if it starts too close to a wall
+				if (!next.equalPoint( current) && (!aGrid.isInside( next.x, next.y) || distanceOf( next.x, next.y) < 0 || !aGrid.isLineFree( current, next)))
+				{
+					continue;
+				}
+				std::uint64_t nextState = stateOf( next.x, next.y, move + 1);
+				if (predecessors.count( nextState) != 0 || !aTable.isFree( anOwner, next, aRadius + step, aStartTick + (move + 1) * step))
+				{
+					continue;
+				}
+				predecessors[nextState] = state;
+				int distance = distanceOf( next.x, next.y);
+				openSet.push( Entry( move + 1 + movesOf( distance), distance, nextState));
+			}
+		}
+
+		std::cerr << "**** No cooperative route from " << aStart << " to " << aGoal << " after " << numberOfExpansions << " expansions" << std::endl;
+		return Path();
+	}
+	/**
+	 * Every move becomes step cells, one per tick. A move is a straight or diagonal line or a
+	 * shorter move to the goal, the robot waits at the end of a shorter move.
+	 */
+	Path CooperativeAStar::constructPath(	const std::unordered_map< std::uint64_t, std::uint64_t >& somePredecessors,
+											std::uint64_t aState,
+											int aWidth,
+											int aHeight) const
+	{
+		std::vector< Vertex > moves;
+		for (std::uint64_t state = aState;; state = somePredecessors.at( state))
+		{
+			moves.push_back( Vertex( static_cast< int >( state % aWidth), static_cast< int >( (state / aWidth) % aHeight)));
+			if (somePredecessors.at( state) == state)
+			{
+				break;
+			}
+		}
+		std::reverse( moves.begin(), moves.end());
+
+		Path path;
+		path.push_back( moves.front());
+		for (std::size_t i = 1; i < moves.size(); ++i)
+		{
+			const Vertex& from = moves[i - 1];
+			const Vertex& to = moves[i];
+			int numberOfSteps = std::max( std::abs( to.x - from.x), std::abs( to.y - from.y));
+			for (int tick = 1; tick <= step; ++tick)
+			{
+				Vertex cell( to.x, to.y);
+				if (tick < numberOfSteps)
+				{
+					cell = Vertex( from.x + (to.x - from.x) * tick / numberOfSteps, from.y + (to.y - from.y) * tick / numberOfSteps);
+				}
+				path.push_back( cell);
+			}
+		}
+		for (std::size_t tick = 0; tick < path.size(); ++tick)
+		{
+			path[tick].actualCost = static_cast< double >( tick);
+			path[tick].heuristicCost = path[tick].actualCost;
+		}
+		return path;
+	}
+	/**
+	 * A breadth-first search from the goal, every move costs one tick. The start is passable
+	 * even if it is not free, the robot has to be able to leave it.
+	 */
+	void CooperativeAStar::calculateDistances(	const Vertex& aStart,
+												const Vertex& aGoal,
+												const OccupancyGrid& aGrid)
+	{
+		const int width = aGrid.getWidth();
+		distances.assign( static_cast< std::size_t >( width) * aGrid.getHeight(), -1);
+
+		std::deque< Vertex > queue;
+		distances[static_cast< std::size_t >( aGoal.y) * width + aGoal.x] = 0;
+		queue.push_back( aGoal);
+
+		while (!queue.empty())
+		{
+			Vertex current = queue.front();
+			queue.pop_front();
+			int distance = distances[static_cast< std::size_t >( current.y) * width + current.x];
+
+			for (int i = 1; i < 9; ++i)
+			{
+				int x = current.x + xOffset[i];
+				int y = current.y + yOffset[i];
+				if (!aGrid.isFree( x, y) && !(x == aStart.x && y == aStart.y))
+				{
+					continue;
+				}
+				int& neighbourDistance = distances[static_cast< std::size_t >( y) * width + x];
+				if (neighbourDistance < 0)
+				{
+					neighbourDistance = distance + 1;
+					queue.push_back( Vertex( x, y));
+				}
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	void CooperativeAStar::fillOccupancyGrid(	int aRadius,
+												const std::vector< std::string >& someIgnoredRobots)
+	{
+		std::vector< OccupancyGrid::Line > lines;
+		AStar::getObstacleLines( aRadius, someIgnoredRobots, lines);
+		AStar::fillOccupancyGrid( occupancyGrid, lines);
+	}
+} // namespace PathAlgorithm
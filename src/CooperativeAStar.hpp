@@ -0,0 +1,149 @@
+#ifndef COOPERATIVEASTAR_HPP_
+#define COOPERATIVEASTAR_HPP_
+
+#include "Config.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AStar.hpp"
+#include "OccupancyGrid.hpp"
+#include "Point.hpp"
+#include "ReservationTable.hpp"
+#include "Size.hpp"
+#include "Vertex.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 * Prioritised cooperative planning (Silver's Cooperative A*): every robot searches in space
+	 * and time around the reservations of the robots that planned before it and then reserves its
+	 * own route. The route is the cell of the robot per tick, a waiting robot repeats its cell.
+	 *
+	 * The walls and the robots without a reservation are obstacles in the occupancy grid, the
+	 * robots with a reservation are only obstacles where and when they reserved their route.
+	 * The heuristic is the true distance to the goal in the grid, so without conflicts the search
+	 * only expands the cells of the route.
+	 */
+	class CooperativeAStar
+	{
+		public:
+			/**
+			 *
+			 */
+			struct Agent
+			{
+					std::string name;
+					Point start;
+					Point goal;
+					Size robotSize;
+			};
+			/**
+			 * The number of pixels and ticks of one move of the search
+			 */
+			static const int DefaultStep = 4;
+			/**
+			 * The number of ticks a robot may lose waiting for or driving around other robots
+			 */
+			static const long DefaultMaximumDelay = 1000;
+			/**
+			 * The number of states the search expands before it gives up
+			 */
+			static const std::size_t DefaultMaximumExpansions = 500000;
+			/**
+			 *
+			 */
+			CooperativeAStar();
+			/**
+			 * Plans the route of anOwner from now on around the reservations in aTable and reserves it
+			 *
+			 * @return The cell per tick, empty if there is no route without conflicts within the limits
+			 */
+			Path search(const std::string& anOwner,
+						const Point& aStartPoint,
+						const Point& aGoalPoint,
+						const Size& aRobotSize,
+						ReservationTable& aTable);
+			/**
+			 * Plans the agents in the order of someAgents from aStartTick on, every agent is reserved
+			 * in aTable before the next one is planned
+			 *
+			 * @return The routes in the order of someAgents
+			 */
+			std::vector< Path > search(	const std::vector< Agent >& someAgents,
+										ReservationTable& aTable,
+										long aStartTick);
+			/**
+			 * The search itself, aGrid must be inflated with aRadius. Nothing is reserved.
+			 *
+			 * @return The cell per tick from aStartTick on, empty if there is no route without conflicts within the limits
+			 */
+			Path search(const std::string& anOwner,
+						const Vertex& aStart,
+						const Vertex& aGoal,
+						int aRadius,
+						const OccupancyGrid& aGrid,
+						const ReservationTable& aTable,
+						long aStartTick);
+			/**
+			 *
+			 */
+			void setStep( int aStep)
+			{
+				step = std::max( aStep, 1);
+			}
+			/**
+			 *
+			 */
+			void setMaximumDelay( long aMaximumDelay)
+			{
+				maximumDelay = aMaximumDelay;
+			}
+			/**
+			 *
+			 */
+			void setMaximumExpansions( std::size_t aMaximumExpansions)
+			{
+				maximumExpansions = aMaximumExpansions;
+			}
+			/**
+			 *
+			 * @return The grid the last search was done on
+			 */
+			const OccupancyGrid& getOccupancyGrid() const
+			{
+				return occupancyGrid;
+			}
+
+		private:
+			/**
+			 * Fills distances with the number of moves from every cell to aGoal, -1 if aGoal can not be reached
+			 */
+			void calculateDistances(const Vertex& aStart,
+									const Vertex& aGoal,
+									const OccupancyGrid& aGrid);
+			/**
+			 * Fills occupancyGrid with the obstacles for aRadius, without the robots in someIgnoredRobots
+			 */
+			void fillOccupancyGrid(	int aRadius,
+									const std::vector< std::string >& someIgnoredRobots);
+			/**
+			 * Turns the moves that end in aState into the cell per tick
+			 */
+			Path constructPath(	const std::unordered_map< std::uint64_t, std::uint64_t >& somePredecessors,
+								std::uint64_t aState,
+								int aWidth,
+								int aHeight) const;
+
+			int step;
+			long maximumDelay;
+			std::size_t maximumExpansions;
+
+			OccupancyGrid occupancyGrid;
+			std::vector< int > distances;
+	}; // class CooperativeAStar
+} // namespace PathAlgorithm
+#endif // COOPERATIVEASTAR_HPP_
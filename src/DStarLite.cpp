@@ -0,0 +1,355 @@
+#include "DStarLite.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	static const double Infinity = std::numeric_limits< double >::infinity();
+	/**
+	 * The 8 neighbours of a cell and the cost to move there
+	 */
+	static const int xOffset[] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+	static const int yOffset[] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+	static const double stepCost[] = { 1.0, std::sqrt( 2.0), 1.0, std::sqrt( 2.0), 1.0, std::sqrt( 2.0), 1.0, std::sqrt( 2.0) };
+	/**
+	 *
+	 */
+	static double Distance(	const Vertex& aStart,
+							const Vertex& aGoal)
+	{
+		return std::sqrt( (aStart.x - aGoal.x) * (aStart.x - aGoal.x) + (aStart.y - aGoal.y) * (aStart.y - aGoal.y));
+	}
+	/**
+	 *
+	 */
+	DStarLite::DStarLite() :
+								initialised( false),
+								start( 0, 0),
+								goal( 0, 0),
+								radius( 0),
+								keyModifier( 0.0)
+	{
+	}
+	/**
+	 *
+	 */
+	Path DStarLite::search(	const Point& aStartPoint,
+							const Point& aGoalPoint,
+							const Size& aRobotSize)
+	{
+		Vertex startVertex( aStartPoint);
+		Vertex goalVertex( aGoalPoint);
+
+		return search( startVertex, goalVertex, aRobotSize);
+	}
+	/**
+	 *
+	 */
+	Path DStarLite::search(	Vertex aStart,
+							const Vertex& aGoal,
+							const Size& aRobotSize)
+	{
+		int newRadius = AStar::freeRadius( aRobotSize);
+
+		std::vector< OccupancyGrid::Line > lines;
+		AStar::getObstacleLines( newRadius, robotName, lines);
+		std::sort( lines.begin(), lines.end());
+
+		{
+			std::lock_guard< std::mutex > lock( searchMutex);
+
+			if (!initialised || !goal.equalPoint( aGoal) || radius != newRadius)
+			{
+				start = aStart;
+				radius = newRadius;
+				obstacleLines.swap( lines);
+				AStar::fillOccupancyGrid( occupancyGrid, obstacleLines);
+				initialise( aGoal, occupancyGrid.getWidth(), occupancyGrid.getHeight());
+			} else
+			{
+				// The keys in the openSet are relative to the old start, instead of recalculating
+				// them all the keys of new Vertices are raised by the distance the start moved
+				keyModifier += Distance( start, aStart);
+				start = aStart;
+				updateObstacles( lines);
+			}
+		}
+
+		if (!occupancyGrid.isInside( start.x, start.y) || !occupancyGrid.isInside( goal.x, goal.y))
+		{
+			std::cerr << "**** No route from " << start << " to " << goal << ", outside the world" << std::endl;
+			reset();
+			return Path();
+		}
+
+		computeShortestPath();
+
+		Path path = constructPath();
+		if (path.empty())
+		{
+			std::cerr << "**** No route from " << start << " to " << goal << std::endl;
+		}
+		return path;
+	}
+	/**
+	 *
+	 */
+	void DStarLite::reset()
+	{
+		std::lock_guard< std::mutex > lock( searchMutex);
+		initialised = false;
+	}
+	/**
+	 *
+	 */
+	OpenSet DStarLite::getOpenSet() const
+	{
+		return progress.getOpenSet();
+	}
+	/**
+	 *
+	 */
+	ClosedSet DStarLite::getClosedSet() const
+	{
+		return progress.getClosedSet();
+	}
+	/**
+	 *
+	 */
+	void DStarLite::initialise(	const Vertex& aGoal,
+								int aWidth,
+								int aHeight)
+	{
+		initialised = true;
+		goal = Vertex( aGoal.x, aGoal.y);
+		keyModifier = 0.0;
+
+		costs.assign( static_cast< std::size_t >( aWidth) * aHeight, Infinity);
+		lookaheads.assign( static_cast< std::size_t >( aWidth) * aHeight, Infinity);
+		openSet.reset( aWidth, aHeight);
+
+		if (occupancyGrid.isInside( goal.x, goal.y))
+		{
+			lookaheads[indexOf( goal)] = 0.0;
+			openSet.push( calculateKey( goal));
+		}
+	}
+	/**
+	 * Only the cells whose state changed matter. A changed cell changes the cost of the moves
+	 * into it, so the lookahead of its neighbours has to be recalculated.
+	 */
+	void DStarLite::updateObstacles( std::vector< OccupancyGrid::Line >& someNewLines)
+	{
+		std::vector< Vertex > changedCells;
+		occupancyGrid.replaceLines( obstacleLines, someNewLines, &changedCells);
+		obstacleLines.swap( someNewLines);
+
+		for (const Vertex& changedCell : changedCells)
+		{
+			for (int i = 0; i < 8; ++i)
+			{
+				Vertex neighbour( changedCell.x + xOffset[i], changedCell.y + yOffset[i]);
+				if (occupancyGrid.isInside( neighbour.x, neighbour.y) && !neighbour.equalPoint( goal))
+				{
+					lookaheads[indexOf( neighbour)] = getLookahead( neighbour);
+					updateVertex( neighbour);
+				}
+			}
+		}
+	}
+	/**
+	 * The optimised version of ComputeShortestPath of the paper. A move into a cell is only
+	 * possible if that cell is free, so only a free cell has predecessors.
+	 */
+	void DStarLite::computeShortestPath()
+	{
+		closedSet.clear();
+		progress.start();
+
+		const int startIndex = indexOf( start);
+		for (;;)
+		{
+			if (openSet.empty())
+			{
+				break;
+			}
+			Vertex top = openSet.top();
+			if (!top.lessCost( calculateKey( start)) && lookaheads[startIndex] <= costs[startIndex])
+			{
+				break;
+			}
+
+			Vertex current( top.x, top.y);
+			const int currentIndex = indexOf( current);
+			Vertex newKey = calculateKey( current);
+
+			if (top.lessCost( newKey))
+			{
+				// The start moved since the key was calculated
+				openSet.push( newKey);
+				continue;
+			}
+
+			closedSet.push_back( current);
+			bool isFree = occupancyGrid.isFree( current);
+
+			if (costs[currentIndex] > lookaheads[currentIndex])
+			{
+				costs[currentIndex] = lookaheads[currentIndex];
+				openSet.erase( current);
+
+				for (int i = 0; isFree && i < 8; ++i)
+				{
+					Vertex predecessor( current.x + xOffset[i], current.y + yOffset[i]);
+					if (occupancyGrid.isInside( predecessor.x, predecessor.y) && !predecessor.equalPoint( goal))
+					{
+						double& lookahead = lookaheads[indexOf( predecessor)];
+						lookahead = std::min( lookahead, costs[currentIndex] + stepCost[i]);
+						updateVertex( predecessor);
+					}
+				}
+			} else
+			{
+				double oldCost = costs[currentIndex];
+				costs[currentIndex] = Infinity;
+
+				for (int i = 0; isFree && i < 8; ++i)
+				{
+					Vertex predecessor( current.x + xOffset[i], current.y + yOffset[i]);
+					if (occupancyGrid.isInside( predecessor.x, predecessor.y) && !predecessor.equalPoint( goal))
+					{
+						double& lookahead = lookaheads[indexOf( predecessor)];
+						if (lookahead == oldCost + stepCost[i])
+						{
+							lookahead = getLookahead( predecessor);
+						}
+						updateVertex( predecessor);
+					}
+				}
+				if (!current.equalPoint( goal))
+				{
+					lookaheads[currentIndex] = getLookahead( current);
+				}
+				updateVertex( current);
+			}
+
+			if (progress.expand())
+			{
+				publishProgress();
+			}
+		}
+		publishProgress();
+	}
+	/**
+	 *
+	 */
+	void DStarLite::publishProgress()
+	{
+		if (!progress.isEnabled())
+		{
+			return;
+		}
+		progress.publish( openSet.getVertices(), closedSet);
+		notifyObservers();
+	}
+	/**
+	 *
+	 */
+	void DStarLite::updateVertex( const Vertex& aVertex)
+	{
+		const int index = indexOf( aVertex);
+		if (costs[index] != lookaheads[index])
+		{
+			openSet.push( calculateKey( aVertex));
+		} else
+		{
+			openSet.erase( aVertex);
+		}
+	}
+	/**
+	 *
+	 */
+	double DStarLite::getLookahead( const Vertex& aVertex) const
+	{
+		double lookahead = Infinity;
+		for (int i = 0; i < 8; ++i)
+		{
+			int x = aVertex.x + xOffset[i];
+			int y = aVertex.y + yOffset[i];
+			if (occupancyGrid.isFree( x, y))
+			{
+				lookahead = std::min( lookahead, costs[y * occupancyGrid.getWidth() + x] + stepCost[i]);
+			}
+		}
+		return lookahead;
+	}
+	/**
+	 *
+	 */
+	Vertex DStarLite::calculateKey( const Vertex& aVertex) const
+	{
+		const int index = indexOf( aVertex);
+		double minimum = std::min( costs[index], lookaheads[index]);
+
+		Vertex key( aVertex.x, aVertex.y);
+		key.heuristicCost = minimum + Distance( start, aVertex) + keyModifier;
+		key.actualCost = -minimum;
+		return key;
+	}
+	/**
+	 * Follows the cheapest move from the start until the goal is reached
+	 */
+	Path DStarLite::constructPath() const
+	{
+		Path path;
+		if (lookaheads[indexOf( start)] == Infinity)
+		{
+			return path;
+		}
+
+		Vertex current( start.x, start.y);
+		path.push_back( current);
+
+		// A route can not visit a cell twice, this only guards against a loop on an inconsistent grid
+		std::size_t maximumLength = costs.size();
+		while (!current.equalPoint( goal) && path.size() <= maximumLength)
+		{
+			Vertex next( 0, 0);
+			double nextCost = Infinity;
+			double nextStep = 0.0;
+			for (int i = 0; i < 8; ++i)
+			{
+				int x = current.x + xOffset[i];
+				int y = current.y + yOffset[i];
+				if (occupancyGrid.isFree( x, y))
+				{
+					double cost = stepCost[i] + costs[y * occupancyGrid.getWidth() + x];
+					if (cost < nextCost)
+					{
+						next = Vertex( x, y);
+						nextCost = cost;
+						nextStep = stepCost[i];
+					}
+				}
+			}
+			if (nextCost == Infinity)
+			{
+				return Path();
+			}
+			next.actualCost = current.actualCost + nextStep;
+			next.heuristicCost = next.actualCost + (nextCost - nextStep);
+			path.push_back( next);
+			current = next;
+		}
+		if (!current.equalPoint( goal))
+		{
+			return Path();
+		}
+		return path;
+	}
+} // namespace PathAlgorithm
@@ -0,0 +1,170 @@
+#ifndef DSTARLITE_HPP_
+#define DSTARLITE_HPP_
+
+#include "Config.hpp"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "AStar.hpp"
+#include "Notifier.hpp"
+#include "OccupancyGrid.hpp"
+#include "Point.hpp"
+#include "SearchProgress.hpp"
+#include "Size.hpp"
+#include "Vertex.hpp"
+#include "VertexHeap.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 * D* Lite (Koenig & Likhachev), an incremental planner on the same grid as AStar.
+	 *
+	 * The search runs backwards from the goal to the robot and is kept between calls to search.
+	 * As long as the goal and the size of the robot stay the same, the next search only rasterises
+	 * the obstacles that were added or removed since the previous search and repairs the costs of
+	 * the cells around them. The start may move between searches, i.e. the robot may have driven.
+	 */
+	class DStarLite : public Base::Notifier
+	{
+		public:
+			/**
+			 *
+			 */
+			DStarLite();
+			/**
+			 *
+			 */
+			Path search(const Point& aStartPoint,
+						const Point& aGoalPoint,
+						const Size& aRobotSize);
+			/**
+			 * Plans from aStart to aGoal, reusing the previous search if the goal and the robot size did not change
+			 */
+			Path search(Vertex aStart,
+						const Vertex& aGoal,
+						const Size& aRobotSize);
+			/**
+			 * Throws away the kept search, the next search starts from scratch
+			 */
+			void reset();
+			/**
+			 *
+			 * @return The openSet of the last snapshot of the search
+			 */
+			OpenSet getOpenSet() const;
+			/**
+			 *
+			 * @return The Vertices that were expanded in the last snapshot of the search
+			 */
+			ClosedSet getClosedSet() const;
+			/**
+			 *
+			 * @return The grid the last search was done on
+			 */
+			const OccupancyGrid& getOccupancyGrid() const
+			{
+				return occupancyGrid;
+			}
+			/**
+			 * The Robot that plans with this DStarLite is not an obstacle for its own routes, with
+			 * an empty name all Robots are obstacles
+			 */
+			void setRobotName( const std::string& aRobotName)
+			{
+				robotName = aRobotName;
+			}
+			/**
+			 *
+			 */
+			const std::string& getRobotName() const
+			{
+				return robotName;
+			}
+			/**
+			 * The snapshots of the search for a visualiser, every snapshot notifies the observers
+			 */
+			SearchProgress& getProgress()
+			{
+				return progress;
+			}
+
+		private:
+			/**
+			 * Starts a new search towards aGoal on the obstacles in obstacleLines
+			 */
+			void initialise(	const Vertex& aGoal,
+								int aWidth,
+								int aHeight);
+			/**
+			 * Rasterises the difference between obstacleLines and someNewLines and repairs the cells around the changed cells
+			 */
+			void updateObstacles( std::vector< OccupancyGrid::Line >& someNewLines);
+			/**
+			 *
+			 */
+			void computeShortestPath();
+			/**
+			 * Puts aVertex in the openSet with its current key if it is inconsistent and takes it out if it is not
+			 */
+			void updateVertex( const Vertex& aVertex);
+			/**
+			 *
+			 * @return The minimum over the free neighbours of the cost to get there and their cost to the goal
+			 */
+			double getLookahead( const Vertex& aVertex) const;
+			/**
+			 * The key of aVertex as a Vertex for the openSet: heuristicCost is the first part of the key,
+			 * actualCost is the negated second part so that VertexHeap orders the keys lexicographically.
+			 */
+			Vertex calculateKey( const Vertex& aVertex) const;
+			/**
+			 *
+			 */
+			Path constructPath() const;
+			/**
+			 * Copies the openSet and the closedSet into the snapshot and notifies the observers
+			 */
+			void publishProgress();
+			/**
+			 *
+			 */
+			int indexOf( const Vertex& aVertex) const
+			{
+				return aVertex.y * occupancyGrid.getWidth() + aVertex.x;
+			}
+
+			bool initialised;
+			Vertex start;
+			Vertex goal;
+			int radius;
+			/**
+			 * The sum of the heuristic distances the start moved, see the "km" of the paper
+			 */
+			double keyModifier;
+			/**
+			 * The obstacles that are rasterised in occupancyGrid, sorted
+			 */
+			std::vector< OccupancyGrid::Line > obstacleLines;
+			OccupancyGrid occupancyGrid;
+			std::string robotName;
+			/**
+			 * The cost to the goal per cell, g of the paper
+			 */
+			std::vector< double > costs;
+			/**
+			 * The one-step lookahead of the cost to the goal per cell, rhs of the paper
+			 */
+			std::vector< double > lookaheads;
+			VertexHeap openSet;
+			ClosedSet closedSet;
+
+			SearchProgress progress;
+			/**
+			 * Guards the kept search against a reset during the start of a search
+			 */
+			mutable std::mutex searchMutex;
+	}; // class DStarLite
+} // namespace PathAlgorithm
+#endif // DSTARLITE_HPP_
@@ -0,0 +1,168 @@
+#include "EventLog.hpp"
+
+#include <stdexcept>
+
+#include "Scheduler.hpp"
+
+namespace Model
+{
+	/**
+	 * The first line of a log, a log of another version can not be replayed
+	 */
+	static const std::string Header = "robotworld-event-log 1";
+	/**
+	 *
+	 */
+	EventLog::EventLog() :
+								mode( Mode::Off),
+								numberOfEvents( 0)
+	{
+	}
+	/**
+	 *
+	 */
+	/* static */EventLog& EventLog::getEventLog()
+	{
+		static EventLog eventLog;
+		return eventLog;
+	}
+	/**
+	 *
+	 */
+	void EventLog::startRecording(	const std::string& aFileName,
+									const std::vector< std::string >& someArguments)
+	{
+		std::lock_guard< std::mutex > lock( logMutex);
+		file.close();
+		file.clear();
+		file.open( aFileName);
+		if (!file)
+		{
+			throw std::runtime_error( "Can not open " + aFileName);
+		}
+		file << Header << '\n';
+		for (const std::string& argument : someArguments)
+		{
+			file << "argument " << argument << '\n';
+		}
+		file << "events" << '\n';
+		recordedEvents.clear();
+		numberOfEvents = 0;
+		divergence.clear();
+		mode = Mode::Recording;
+	}
+	/**
+	 *
+	 */
+	std::vector< std::string > EventLog::startReplaying( const std::string& aFileName)
+	{
+		std::ifstream input( aFileName);
+		if (!input)
+		{
+			throw std::runtime_error( "Can not open " + aFileName);
+		}
+		std::string line;
+		if (!std::getline( input, line) || line != Header)
+		{
+			throw std::runtime_error( aFileName + " is not an event log");
+		}
+
+		const std::string argumentPrefix = "argument ";
+		std::vector< std::string > arguments;
+		while (std::getline( input, line) && line != "events")
+		{
+			if (line.compare( 0, argumentPrefix.size(), argumentPrefix) != 0)
+			{
+				throw std::runtime_error( aFileName + ": no argument: " + line);
+			}
+			arguments.push_back( line.substr( argumentPrefix.size()));
+		}
+
+		std::lock_guard< std::mutex > lock( logMutex);
+		file.close();
+		recordedEvents.clear();
+		while (std::getline( input, line))
+		{
+			recordedEvents.push_back( line);
+		}
+		numberOfEvents = 0;
+		divergence.clear();
+		mode = Mode::Replaying;
+		return arguments;
+	}
+	/**
+	 *
+	 */
+	void EventLog::stop()
+	{
+		std::lock_guard< std::mutex > lock( logMutex);
+		if (mode == Mode::Replaying && divergence.empty() && numberOfEvents < recordedEvents.size())
+		{
+			divergence = "expected \"" + recordedEvents[numberOfEvents] + "\" but the replay ended";
+		}
+		mode = Mode::Off;
+		file.close();
+	}
+	/**
+	 *
+	 */
+	void EventLog::record(	const std::string& aSource,
+							const std::string& anEvent)
+	{
+		const std::string line = std::to_string( Scheduler::getScheduler().getTick()) + ' ' + aSource + ' ' + anEvent;
+
+		std::lock_guard< std::mutex > lock( logMutex);
+		switch (mode.load())
+		{
+			case Mode::Recording:
+			{
+				file << line << '\n';
+				break;
+			}
+			case Mode::Replaying:
+			{
+				// Only the first divergence is interesting, everything after it follows from it
+				if (divergence.empty())
+				{
+					if (numberOfEvents >= recordedEvents.size())
+					{
+						divergence = "expected the end of the recording but the replay gave \"" + line + "\"";
+					} else if (recordedEvents[numberOfEvents] != line)
+					{
+						divergence = "expected \"" + recordedEvents[numberOfEvents] + "\" but the replay gave \"" + line + "\"";
+					}
+				}
+				break;
+			}
+			case Mode::Off:
+			{
+				return;
+			}
+		}
+		++numberOfEvents;
+	}
+	/**
+	 *
+	 */
+	std::size_t EventLog::getNumberOfEvents() const
+	{
+		std::lock_guard< std::mutex > lock( logMutex);
+		return numberOfEvents;
+	}
+	/**
+	 *
+	 */
+	bool EventLog::isIdentical() const
+	{
+		std::lock_guard< std::mutex > lock( logMutex);
+		return divergence.empty();
+	}
+	/**
+	 *
+	 */
+	std::string EventLog::getDivergence() const
+	{
+		std::lock_guard< std::mutex > lock( logMutex);
+		return divergence;
+	}
+} // namespace Model
@@ -0,0 +1,103 @@
+#ifndef EVENTLOG_HPP_
+#define EVENTLOG_HPP_
+
+#include "Config.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Model
+{
+	/**
+	 * Records what the Robots do in a run of the simulation, or checks a replay of a recorded run.
+	 *
+	 * An event is a line "tick source what" with the tick of the Scheduler, the name of the Robot
+	 * and what it did. The log starts with the command line arguments of the run, a replay runs
+	 * with the same arguments. If the Scheduler is deterministic the replay gives the same events
+	 * in the same order, the first event that differs is where the replay diverged.
+	 */
+	class EventLog
+	{
+		public:
+			/**
+			 *
+			 * @return The log of all Robots
+			 */
+			static EventLog& getEventLog();
+			/**
+			 * Writes the events to aFileName, after someArguments
+			 */
+			void startRecording(	const std::string& aFileName,
+									const std::vector< std::string >& someArguments);
+			/**
+			 * Reads the events that the replay must give from aFileName
+			 *
+			 * @return The command line arguments of the recorded run
+			 */
+			std::vector< std::string > startReplaying( const std::string& aFileName);
+			/**
+			 * Stops recording or replaying, a recording is complete after this
+			 */
+			void stop();
+			/**
+			 *
+			 * @return True if the events are recorded or checked, the Robots only describe their events if so
+			 */
+			bool isEnabled() const
+			{
+				return mode.load() != Mode::Off;
+			}
+			/**
+			 *
+			 */
+			bool isReplaying() const
+			{
+				return mode.load() == Mode::Replaying;
+			}
+			/**
+			 * Records anEvent of aSource at the current tick of the Scheduler
+			 */
+			void record(	const std::string& aSource,
+							const std::string& anEvent);
+			/**
+			 *
+			 * @return The number of events since the recording or replay started
+			 */
+			std::size_t getNumberOfEvents() const;
+			/**
+			 *
+			 * @return True if the replay gave exactly the recorded events
+			 */
+			bool isIdentical() const;
+			/**
+			 *
+			 * @return The first recorded event and the event of the replay that differ, empty if there is none
+			 */
+			std::string getDivergence() const;
+
+		private:
+			/**
+			 *
+			 */
+			enum class Mode
+			{
+				Off,
+				Recording,
+				Replaying
+			};
+
+			EventLog();
+
+			std::atomic< Mode > mode;
+			std::ofstream file;
+			std::vector< std::string > recordedEvents;
+			std::size_t numberOfEvents;
+			std::string divergence;
+			mutable std::mutex logMutex;
+	}; // class EventLog
+} // namespace Model
+#endif // EVENTLOG_HPP_
@@ -0,0 +1,323 @@
+#include "FlowField.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+
+#include "PathSmoother.hpp"
+#include "Robot.hpp"
+#include "RobotWorld.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	static const double Infinity = std::numeric_limits< double >::infinity();
+	/**
+	 * The 8 neighbours of a cell and the cost to move there
+	 */
+	static const int xOffset[] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+	static const int yOffset[] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+	static const double stepCost[] = { 1.0, std::sqrt( 2.0), 1.0, std::sqrt( 2.0), 1.0, std::sqrt( 2.0), 1.0, std::sqrt( 2.0) };
+	/**
+	 *
+	 */
+	FlowField::FlowField(	const Vertex& aGoal,
+							int aFreeRadius) :
+								goal( aGoal.x, aGoal.y),
+								radius( aFreeRadius),
+								built( false),
+								version( 0)
+	{
+	}
+	/**
+	 * The fields are never removed, there are only a few goals in a world
+	 */
+	/* static */FlowField& FlowField::getFlowField(	const Point& aGoalPoint,
+													const Size& aRobotSize)
+	{
+		static std::map< std::tuple< long, long, int >, std::unique_ptr< FlowField > > flowFields;
+		static std::mutex flowFieldsMutex;
+
+		const int freeRadius = AStar::freeRadius( aRobotSize);
+
+		std::lock_guard< std::mutex > lock( flowFieldsMutex);
+		std::unique_ptr< FlowField >& flowField = flowFields[std::make_tuple( aGoalPoint.x, aGoalPoint.y, freeRadius)];
+		if (!flowField)
+		{
+			flowField.reset( new FlowField( Vertex( aGoalPoint), freeRadius));
+		}
+		return *flowField;
+	}
+	/**
+	 *
+	 */
+	void FlowField::update()
+	{
+		std::lock_guard< std::mutex > lock( fieldMutex);
+		refresh();
+	}
+	/**
+	 *
+	 */
+	Path FlowField::getPath( const Vertex& aStart)
+	{
+		std::lock_guard< std::mutex > lock( fieldMutex);
+		refresh();
+		return follow( aStart);
+	}
+	/**
+	 *
+	 */
+	Path FlowField::getSmoothPath( const Vertex& aStart)
+	{
+		std::lock_guard< std::mutex > lock( fieldMutex);
+		refresh();
+		return PathSmoother::smooth( follow( aStart), occupancyGrid);
+	}
+	/**
+	 *
+	 */
+	OccupancyGrid FlowField::getOccupancyGrid() const
+	{
+		std::lock_guard< std::mutex > lock( fieldMutex);
+		return occupancyGrid;
+	}
+	/**
+	 *
+	 */
+	Path FlowField::follow( const Vertex& aStart) const
+	{
+		Path path;
+		if (!occupancyGrid.isInside( aStart.x, aStart.y) || costs[indexOf( aStart)] == Infinity)
+		{
+			std::cerr << "**** No route from " << aStart << " to " << goal << std::endl;
+			return path;
+		}
+
+		Vertex current( aStart.x, aStart.y);
+		current.heuristicCost = costs[indexOf( current)];
+		path.push_back( current);
+		for (int cell = next[indexOf( current)]; cell != -1; cell = next[cell])
+		{
+			Vertex vertex = vertexAt( cell);
+			vertex.actualCost = path.back().actualCost + (vertex.x != path.back().x && vertex.y != path.back().y ? std::sqrt( 2.0) : 1.0);
+			vertex.heuristicCost = vertex.actualCost + costs[cell];
+			path.push_back( vertex);
+		}
+		return path;
+	}
+	/**
+	 *
+	 */
+	double FlowField::getCost( const Vertex& aVertex) const
+	{
+		std::lock_guard< std::mutex > lock( fieldMutex);
+		if (!built || !occupancyGrid.isInside( aVertex.x, aVertex.y))
+		{
+			return Infinity;
+		}
+		return costs[indexOf( aVertex)];
+	}
+	/**
+	 *
+	 */
+	Vertex FlowField::getNext( const Vertex& aVertex) const
+	{
+		std::lock_guard< std::mutex > lock( fieldMutex);
+		if (!built || !occupancyGrid.isInside( aVertex.x, aVertex.y) || next[indexOf( aVertex)] == -1)
+		{
+			return Vertex( aVertex.x, aVertex.y);
+		}
+		return vertexAt( next[indexOf( aVertex)]);
+	}
+	/**
+	 * The wall version also changes with the size of the world, the walls are compared
+	 * line by line so that a new version without changed walls costs no search
+	 */
+	void FlowField::refresh()
+	{
+		unsigned long newVersion = Model::RobotWorld::getRobotWorld().getWallVersion();
+		if (built && newVersion == version)
+		{
+			return;
+		}
+		version = newVersion;
+
+		const Size worldSize = Model::RobotWorld::getRobotWorld().getWorldSize();
+		if (!built || occupancyGrid.getWidth() != worldSize.x + 1 || occupancyGrid.getHeight() != worldSize.y + 1)
+		{
+			build();
+			return;
+		}
+
+		std::vector< OccupancyGrid::Line > lines;
+		getWallLines( lines);
+
+		std::vector< Vertex > changedCells;
+		occupancyGrid.replaceLines( obstacleLines, lines, &changedCells);
+		obstacleLines.swap( lines);
+
+		if (!changedCells.empty())
+		{
+			repair( changedCells);
+		}
+	}
+	/**
+	 *
+	 */
+	void FlowField::build()
+	{
+		getWallLines( obstacleLines);
+		AStar::fillOccupancyGrid( occupancyGrid, obstacleLines);
+		built = true;
+
+		const std::size_t numberOfCells = static_cast< std::size_t >( occupancyGrid.getWidth()) * occupancyGrid.getHeight();
+		costs.assign( numberOfCells, Infinity);
+		next.assign( numberOfCells, -1);
+		openSet.reset( occupancyGrid.getWidth(), occupancyGrid.getHeight());
+
+		if (!occupancyGrid.isInside( goal.x, goal.y))
+		{
+			return;
+		}
+
+		costs[indexOf( goal)] = 0.0;
+		Vertex key( goal.x, goal.y);
+		openSet.push( key);
+		propagate();
+	}
+	/**
+	 * A cell that became occupied takes the cells that move through it with it: their costs are
+	 * thrown away and they get the best cost of their remaining neighbours. A cell that became free
+	 * gets the best cost of its neighbours. Then the lowered costs are propagated as in the first search.
+	 */
+	void FlowField::repair( const std::vector< Vertex >& someChangedCells)
+	{
+		const int goalCell = occupancyGrid.isInside( goal.x, goal.y) ? indexOf( goal) : -1;
+		const int width = occupancyGrid.getWidth();
+
+		std::vector< int > invalidCells;
+		for (const Vertex& changedCell : someChangedCells)
+		{
+			const int cell = indexOf( changedCell);
+			if (cell != goalCell && !occupancyGrid.isFree( changedCell) && costs[cell] != Infinity)
+			{
+				costs[cell] = Infinity;
+				next[cell] = -1;
+				invalidCells.push_back( cell);
+			}
+		}
+		for (std::size_t i = 0; i < invalidCells.size(); ++i)
+		{
+			const Vertex vertex = vertexAt( invalidCells[i]);
+			for (int n = 0; n < 8; ++n)
+			{
+				const int x = vertex.x + xOffset[n];
+				const int y = vertex.y + yOffset[n];
+				if (occupancyGrid.isInside( x, y) && next[y * width + x] == invalidCells[i])
+				{
+					costs[y * width + x] = Infinity;
+					next[y * width + x] = -1;
+					invalidCells.push_back( y * width + x);
+				}
+			}
+		}
+
+		openSet.clear();
+		for (int cell : invalidCells)
+		{
+			seed( cell);
+		}
+		for (const Vertex& changedCell : someChangedCells)
+		{
+			seed( indexOf( changedCell));
+		}
+		propagate();
+	}
+	/**
+	 *
+	 */
+	void FlowField::propagate()
+	{
+		const int width = occupancyGrid.getWidth();
+
+		while (!openSet.empty())
+		{
+			const Vertex current = openSet.top();
+			openSet.pop();
+			const int currentCell = indexOf( current);
+
+			for (int n = 0; n < 8; ++n)
+			{
+				const int x = current.x + xOffset[n];
+				const int y = current.y + yOffset[n];
+				if (!occupancyGrid.isFree( x, y))
+				{
+					continue;
+				}
+				const int cell = y * width + x;
+				const double cost = costs[currentCell] + stepCost[n];
+				if (cost < costs[cell])
+				{
+					costs[cell] = cost;
+					next[cell] = currentCell;
+
+					Vertex key( x, y);
+					key.heuristicCost = cost;
+					key.actualCost = cost;
+					openSet.push( key);
+				}
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	void FlowField::seed( int aCell)
+	{
+		const Vertex vertex = vertexAt( aCell);
+		if (!occupancyGrid.isFree( vertex) || vertex.equalPoint( goal))
+		{
+			return;
+		}
+
+		const int width = occupancyGrid.getWidth();
+		for (int n = 0; n < 8; ++n)
+		{
+			const int x = vertex.x + xOffset[n];
+			const int y = vertex.y + yOffset[n];
+			// The goal is the only cell that can be moved to without being free
+			if (occupancyGrid.isInside( x, y) && (occupancyGrid.isFree( x, y) || goal.equalPoint( Vertex( x, y))) && costs[y * width + x] + stepCost[n] < costs[aCell])
+			{
+				costs[aCell] = costs[y * width + x] + stepCost[n];
+				next[aCell] = y * width + x;
+			}
+		}
+		if (costs[aCell] != Infinity)
+		{
+			Vertex key( vertex.x, vertex.y);
+			key.heuristicCost = costs[aCell];
+			key.actualCost = costs[aCell];
+			openSet.push( key);
+		}
+	}
+	/**
+	 *
+	 */
+	void FlowField::getWallLines( std::vector< OccupancyGrid::Line >& aLines) const
+	{
+		std::vector< std::string > robotNames;
+		for (Model::RobotPtr robot : Model::RobotWorld::getRobotWorld().getRobots())
+		{
+			robotNames.push_back( robot->getName());
+		}
+		AStar::getObstacleLines( radius, robotNames, aLines);
+		std::sort( aLines.begin(), aLines.end());
+	}
+} // namespace PathAlgorithm
@@ -0,0 +1,150 @@
+#ifndef FLOWFIELD_HPP_
+#define FLOWFIELD_HPP_
+
+#include "Config.hpp"
+
+#include <mutex>
+#include <vector>
+
+#include "AStar.hpp"
+#include "OccupancyGrid.hpp"
+#include "Point.hpp"
+#include "Size.hpp"
+#include "Vertex.hpp"
+#include "VertexHeap.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 * The cost to one goal from every cell of the world, for all robots that drive to that goal.
+	 *
+	 * A Dijkstra search from the goal gives every free cell its cost and the neighbour it has to
+	 * move to, so a robot anywhere in the world finds its next step in O(1). The field is shared
+	 * by all robots with the same goal and clearance, the cost of planning does not grow with
+	 * the number of robots. Because the field is shared the robots are not obstacles in it,
+	 * only the walls and the borders of the world are.
+	 *
+	 * When the walls change only the cells whose route went through a cell that became occupied,
+	 * and the cells that can now be reached cheaper through a cell that became free, are searched again.
+	 */
+	class FlowField
+	{
+		public:
+			/**
+			 *
+			 */
+			FlowField(	const Vertex& aGoal,
+						int aFreeRadius);
+			/**
+			 *
+			 * @return The field that is shared by all robots of aRobotSize that drive to aGoalPoint
+			 */
+			static FlowField& getFlowField(	const Point& aGoalPoint,
+											const Size& aRobotSize);
+			/**
+			 * Brings the field up to date with the walls of the world if the wall version of the RobotWorld changed
+			 */
+			void update();
+			/**
+			 * Follows the field from aStart to the goal, updating the field first if needed
+			 *
+			 * @return The route, empty if the goal can not be reached from aStart
+			 */
+			Path getPath( const Vertex& aStart);
+			/**
+			 * The route of getPath reduced to its waypoints by the PathSmoother. The grid of the field
+			 * is shared with the other robots, it is smoothed against while the field is locked.
+			 *
+			 * @return The route, empty if the goal can not be reached from aStart
+			 */
+			Path getSmoothPath( const Vertex& aStart);
+			/**
+			 *
+			 * @return The cost from aVertex to the goal, infinity if the goal can not be reached
+			 */
+			double getCost( const Vertex& aVertex) const;
+			/**
+			 *
+			 * @return The neighbour of aVertex on the shortest route to the goal, aVertex itself at the goal or if the goal can not be reached
+			 */
+			Vertex getNext( const Vertex& aVertex) const;
+			/**
+			 *
+			 */
+			const Vertex& getGoal() const
+			{
+				return goal;
+			}
+			/**
+			 *
+			 * @return A copy of the grid of the walls the field was last calculated on
+			 */
+			OccupancyGrid getOccupancyGrid() const;
+
+		private:
+			/**
+			 * The update of update and getPath, fieldMutex must be locked
+			 */
+			void refresh();
+			/**
+			 * The route of getPath and getSmoothPath, fieldMutex must be locked
+			 */
+			Path follow( const Vertex& aStart) const;
+			/**
+			 * Rasterises the walls and searches the whole field
+			 */
+			void build();
+			/**
+			 * Repairs the field for someChangedCells
+			 */
+			void repair( const std::vector< Vertex >& someChangedCells);
+			/**
+			 * Lowers the cost of the cells in the openSet and of the cells that can be reached cheaper through them
+			 */
+			void propagate();
+			/**
+			 * Gives aCell the lowest cost over its neighbours and puts it in the openSet if that is lower than its cost
+			 */
+			void seed( int aCell);
+			/**
+			 *
+			 */
+			void getWallLines( std::vector< OccupancyGrid::Line >& aLines) const;
+			/**
+			 *
+			 */
+			int indexOf( const Vertex& aVertex) const
+			{
+				return aVertex.y * occupancyGrid.getWidth() + aVertex.x;
+			}
+			/**
+			 *
+			 */
+			Vertex vertexAt( int aCell) const
+			{
+				return Vertex( aCell % occupancyGrid.getWidth(), aCell / occupancyGrid.getWidth());
+			}
+
+			Vertex goal;
+			int radius;
+			bool built;
+			unsigned long version;
+			/**
+			 * The walls that are rasterised in occupancyGrid, sorted
+			 */
+			std::vector< OccupancyGrid::Line > obstacleLines;
+			OccupancyGrid occupancyGrid;
+			/**
+			 * The cost to the goal per cell
+			 */
+			std::vector< double > costs;
+			/**
+			 * The cell a cell moves to on its route to the goal, -1 if there is none
+			 */
+			std::vector< int > next;
+			VertexHeap openSet;
+
+			mutable std::mutex fieldMutex;
+	}; // class FlowField
+} // namespace PathAlgorithm
+#endif // FLOWFIELD_HPP_
@@ -0,0 +1,730 @@
+#include "HPAStar.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <tuple>
+
+#include "RobotWorld.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	static const double Infinity = std::numeric_limits< double >::infinity();
+	/**
+	 * The 8 neighbours of a cell and the cost to move there
+	 */
+	static const int xOffset[] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+	static const int yOffset[] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+	static const double stepCost[] = { 1.0, std::sqrt( 2.0), 1.0, std::sqrt( 2.0), 1.0, std::sqrt( 2.0), 1.0, std::sqrt( 2.0) };
+	/**
+	 * A run of free cells along a border that is shorter than this gets one entrance in the middle,
+	 * a longer run gets an entrance at both ends
+	 */
+	static const int MaxSingleEntranceWidth = 6;
+	/**
+	 * The length of the shortest route between two cells if there are no obstacles
+	 */
+	static double OctileDistance(	const Vertex& aStart,
+									const Vertex& aGoal)
+	{
+		int dx = std::abs( aStart.x - aGoal.x);
+		int dy = std::abs( aStart.y - aGoal.y);
+		return std::max( dx, dy) + (std::sqrt( 2.0) - 1.0) * std::min( dx, dy);
+	}
+	/**
+	 * The openSet entries of the searches: the total cost, the negated actual cost and the index.
+	 * Like in AStar the entry with the larger actual cost goes first if the total costs are equal.
+	 */
+	typedef std::tuple< double, double, int > QueueEntry;
+	typedef std::priority_queue< QueueEntry, std::vector< QueueEntry >, std::greater< QueueEntry > > Queue;
+	/**
+	 *
+	 */
+	HPAStar::HPAStar( int aClusterSize /*= DefaultClusterSize*/) :
+								clusterSize( std::max( aClusterSize, 2)),
+								clustersX( 0),
+								clustersY( 0),
+								radius( 0),
+								built( false),
+								clusterMinX( 0),
+								clusterMinY( 0),
+								clusterGeneration( 0),
+								abstractGeneration( 0)
+	{
+	}
+	/**
+	 *
+	 */
+	Path HPAStar::search(	const Point& aStartPoint,
+							const Point& aGoalPoint,
+							const Size& aRobotSize)
+	{
+		Vertex start( aStartPoint);
+		Vertex goal( aGoalPoint);
+
+		return search( start, goal, aRobotSize);
+	}
+	/**
+	 *
+	 */
+	Path HPAStar::search(	Vertex aStart,
+							const Vertex& aGoal,
+							const Size& aRobotSize)
+	{
+		int newRadius = AStar::freeRadius( aRobotSize);
+
+		std::vector< OccupancyGrid::Line > lines;
+		AStar::getObstacleLines( newRadius, robotName, lines);
+		std::sort( lines.begin(), lines.end());
+
+		const Size worldSize = Model::RobotWorld::getRobotWorld().getWorldSize();
+		if (!built || radius != newRadius || occupancyGrid.getWidth() != worldSize.x + 1 || occupancyGrid.getHeight() != worldSize.y + 1)
+		{
+			radius = newRadius;
+			obstacleLines.swap( lines);
+			AStar::fillOccupancyGrid( occupancyGrid, obstacleLines);
+			build();
+		} else
+		{
+			std::vector< Vertex > changedCells;
+			occupancyGrid.replaceLines( obstacleLines, lines, &changedCells);
+			obstacleLines.swap( lines);
+			update( changedCells);
+		}
+
+		if (!occupancyGrid.isInside( aStart.x, aStart.y) || !occupancyGrid.isInside( aGoal.x, aGoal.y))
+		{
+			std::cerr << "**** No route from " << aStart << " to " << aGoal << ", outside the world" << std::endl;
+			return Path();
+		}
+		if (!occupancyGrid.isFree( aGoal))
+		{
+			std::cerr << "**** No route from " << aStart << " to " << aGoal << std::endl;
+			return Path();
+		}
+		if (aStart.equalPoint( aGoal))
+		{
+			return Path( 1, Vertex( aStart.x, aStart.y));
+		}
+
+		// The start and the goal are only added to the abstract graph for this search
+		bool temporaryStart = nodeOfCell.find( aStart.y * occupancyGrid.getWidth() + aStart.x) == nodeOfCell.end();
+		int startNode = getNode( aStart.x, aStart.y);
+		if (temporaryStart)
+		{
+			connect( startNode);
+		}
+		bool temporaryGoal = nodeOfCell.find( aGoal.y * occupancyGrid.getWidth() + aGoal.x) == nodeOfCell.end();
+		int goalNode = getNode( aGoal.x, aGoal.y);
+		if (temporaryGoal)
+		{
+			connect( goalNode);
+		}
+
+		std::vector< int > abstractPath = searchAbstract( startNode, goalNode);
+
+		Path path;
+		if (!abstractPath.empty())
+		{
+			path.push_back( nodes[abstractPath.front()].cell);
+			for (std::size_t i = 1; i < abstractPath.size(); ++i)
+			{
+				const Node& from = nodes[abstractPath[i - 1]];
+				const Node& to = nodes[abstractPath[i]];
+				if (std::abs( from.cell.x - to.cell.x) <= 1 && std::abs( from.cell.y - to.cell.y) <= 1)
+				{
+					path.push_back( to.cell);
+				} else
+				{
+					refine( from.cell, to.cell, from.cluster, path);
+				}
+			}
+			for (std::size_t i = 1; i < path.size(); ++i)
+			{
+				path[i].actualCost = path[i - 1].actualCost + OctileDistance( path[i - 1], path[i]);
+				path[i].heuristicCost = path[i].actualCost;
+			}
+		}
+
+		if (temporaryGoal)
+		{
+			disconnect( goalNode);
+		}
+		if (temporaryStart)
+		{
+			disconnect( startNode);
+		}
+
+		if (path.empty())
+		{
+			std::cerr << "**** No route from " << aStart << " to " << aGoal << std::endl;
+		}
+		return path;
+	}
+	/**
+	 *
+	 */
+	void HPAStar::reset()
+	{
+		built = false;
+	}
+	/**
+	 *
+	 */
+	std::size_t HPAStar::getNumberOfNodes() const
+	{
+		return nodes.size() - freeNodes.size();
+	}
+	/**
+	 *
+	 */
+	ClosedSet HPAStar::getClosedSet() const
+	{
+		std::lock_guard< std::mutex > lock( closedSetMutex);
+		return closedSet;
+	}
+	/**
+	 *
+	 */
+	void HPAStar::build()
+	{
+		clustersX = (occupancyGrid.getWidth() + clusterSize - 1) / clusterSize;
+		clustersY = (occupancyGrid.getHeight() + clusterSize - 1) / clusterSize;
+		const int numberOfClusters = clustersX * clustersY;
+
+		nodes.clear();
+		freeNodes.clear();
+		nodeOfCell.clear();
+		clusterNodes.assign( numberOfClusters, std::vector< int >());
+		clusterFree.assign( numberOfClusters, false);
+		verticalBorders.assign( std::max( clustersX - 1, 0) * clustersY, Entrances());
+		horizontalBorders.assign( clustersX * std::max( clustersY - 1, 0), Entrances());
+
+		const std::size_t clusterCells = static_cast< std::size_t >( clusterSize) * clusterSize;
+		clusterGeneration = 0;
+		clusterVisited.assign( clusterCells, 0);
+		clusterClosed.assign( clusterCells, false);
+		clusterCosts.assign( clusterCells, Infinity);
+		clusterPredecessors.assign( clusterCells, -1);
+
+		for (int cluster = 0; cluster < numberOfClusters; ++cluster)
+		{
+			clusterFree[cluster] = isClusterFree( cluster);
+		}
+		for (std::size_t border = 0; border < verticalBorders.size(); ++border)
+		{
+			buildBorder( true, static_cast< int >( border));
+		}
+		for (std::size_t border = 0; border < horizontalBorders.size(); ++border)
+		{
+			buildBorder( false, static_cast< int >( border));
+		}
+		for (int cluster = 0; cluster < numberOfClusters; ++cluster)
+		{
+			buildCluster( cluster);
+		}
+
+		built = true;
+	}
+	/**
+	 * A changed cell can change the entrances on every border of its cluster, which changes the
+	 * nodes of the neighbouring clusters, so those have to recalculate the edges within them too.
+	 */
+	void HPAStar::update( const std::vector< Vertex >& someChangedCells)
+	{
+		if (someChangedCells.empty())
+		{
+			return;
+		}
+
+		std::vector< bool > dirty( clusterFree.size(), false);
+		std::vector< int > dirtyClusters;
+		for (const Vertex& cell : someChangedCells)
+		{
+			int cluster = clusterOf( cell.x, cell.y);
+			if (!dirty[cluster])
+			{
+				dirty[cluster] = true;
+				dirtyClusters.push_back( cluster);
+			}
+		}
+
+		std::vector< bool > verticalDone( verticalBorders.size(), false);
+		std::vector< bool > horizontalDone( horizontalBorders.size(), false);
+		std::vector< bool > affected( clusterFree.size(), false);
+		std::vector< int > affectedClusters;
+
+		auto affect = [&affected, &affectedClusters]( int aCluster)
+		{
+			if (!affected[aCluster])
+			{
+				affected[aCluster] = true;
+				affectedClusters.push_back( aCluster);
+			}
+		};
+		auto rebuildBorder = [this]( bool aVertical, int aBorder, std::vector< bool >& aDone)
+		{
+			if (!aDone[aBorder])
+			{
+				aDone[aBorder] = true;
+				clearBorder( aVertical ? verticalBorders[aBorder] : horizontalBorders[aBorder]);
+				buildBorder( aVertical, aBorder);
+			}
+		};
+
+		for (int cluster : dirtyClusters)
+		{
+			clusterFree[cluster] = isClusterFree( cluster);
+
+			int cx = cluster % clustersX;
+			int cy = cluster / clustersX;
+
+			affect( cluster);
+			if (cx > 0)
+			{
+				rebuildBorder( true, cy * (clustersX - 1) + cx - 1, verticalDone);
+				affect( cluster - 1);
+			}
+			if (cx < clustersX - 1)
+			{
+				rebuildBorder( true, cy * (clustersX - 1) + cx, verticalDone);
+				affect( cluster + 1);
+			}
+			if (cy > 0)
+			{
+				rebuildBorder( false, (cy - 1) * clustersX + cx, horizontalDone);
+				affect( cluster - clustersX);
+			}
+			if (cy < clustersY - 1)
+			{
+				rebuildBorder( false, cy * clustersX + cx, horizontalDone);
+				affect( cluster + clustersX);
+			}
+		}
+
+		for (int cluster : affectedClusters)
+		{
+			buildCluster( cluster);
+		}
+	}
+	/**
+	 *
+	 */
+	void HPAStar::buildBorder(	bool aVertical,
+								int aBorder)
+	{
+		int first;
+		int last;
+		int side;
+		if (aVertical)
+		{
+			int cx = aBorder % (clustersX - 1);
+			int cy = aBorder / (clustersX - 1);
+			side = (cx + 1) * clusterSize - 1;
+			first = cy * clusterSize;
+			last = std::min( first + clusterSize, occupancyGrid.getHeight());
+		} else
+		{
+			int cx = aBorder % clustersX;
+			int cy = aBorder / clustersX;
+			side = (cy + 1) * clusterSize - 1;
+			first = cx * clusterSize;
+			last = std::min( first + clusterSize, occupancyGrid.getWidth());
+		}
+
+		Entrances& entrances = aVertical ? verticalBorders[aBorder] : horizontalBorders[aBorder];
+		auto addEntrance = [this, aVertical, side, &entrances]( int aPosition)
+		{
+			int node1 = aVertical ? getNode( side, aPosition) : getNode( aPosition, side);
+			int node2 = aVertical ? getNode( side + 1, aPosition) : getNode( aPosition, side + 1);
+			addEdge( node1, node2, 1.0, true);
+			addEdge( node2, node1, 1.0, true);
+			entrances.push_back( std::make_pair( node1, node2));
+		};
+
+		int runStart = -1;
+		for (int position = first; position <= last; ++position)
+		{
+			bool free = false;
+			if (position < last)
+			{
+				free = aVertical ? occupancyGrid.isFree( side, position) && occupancyGrid.isFree( side + 1, position) :
+								   occupancyGrid.isFree( position, side) && occupancyGrid.isFree( position, side + 1);
+			}
+			if (free && runStart < 0)
+			{
+				runStart = position;
+			} else if (!free && runStart >= 0)
+			{
+				int runEnd = position - 1;
+				if (runEnd - runStart + 1 < MaxSingleEntranceWidth)
+				{
+					addEntrance( (runStart + runEnd) / 2);
+				} else
+				{
+					addEntrance( runStart);
+					addEntrance( runEnd);
+				}
+				runStart = -1;
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	void HPAStar::clearBorder( Entrances& anEntrances)
+	{
+		for (const std::pair< int, int >& entrance : anEntrances)
+		{
+			std::vector< Edge >& edges1 = nodes[entrance.first].edges;
+			edges1.erase( std::remove_if( edges1.begin(), edges1.end(), [&entrance](const Edge& anEdge){ return anEdge.inter && anEdge.to == entrance.second;}), edges1.end());
+			std::vector< Edge >& edges2 = nodes[entrance.second].edges;
+			edges2.erase( std::remove_if( edges2.begin(), edges2.end(), [&entrance](const Edge& anEdge){ return anEdge.inter && anEdge.to == entrance.first;}), edges2.end());
+		}
+		anEntrances.clear();
+	}
+	/**
+	 *
+	 */
+	void HPAStar::buildCluster( int aCluster)
+	{
+		std::vector< int > clusterNodesCopy = clusterNodes[aCluster];
+		for (int node : clusterNodesCopy)
+		{
+			const std::vector< Edge >& edges = nodes[node].edges;
+			if (std::none_of( edges.begin(), edges.end(), [](const Edge& anEdge){ return anEdge.inter;}))
+			{
+				removeNode( node);
+			}
+		}
+
+		const std::vector< int >& nodesOfCluster = clusterNodes[aCluster];
+		for (int node : nodesOfCluster)
+		{
+			std::vector< Edge >& edges = nodes[node].edges;
+			edges.erase( std::remove_if( edges.begin(), edges.end(), [](const Edge& anEdge){ return !anEdge.inter;}), edges.end());
+		}
+
+		for (std::size_t i = 0; i < nodesOfCluster.size(); ++i)
+		{
+			if (!clusterFree[aCluster])
+			{
+				searchCluster( nodes[nodesOfCluster[i]].cell, aCluster, nullptr);
+			}
+			for (std::size_t j = i + 1; j < nodesOfCluster.size(); ++j)
+			{
+				double cost = clusterFree[aCluster] ? OctileDistance( nodes[nodesOfCluster[i]].cell, nodes[nodesOfCluster[j]].cell) :
+													  getClusterCost( nodes[nodesOfCluster[j]].cell);
+				if (cost < Infinity)
+				{
+					addEdge( nodesOfCluster[i], nodesOfCluster[j], cost, false);
+					addEdge( nodesOfCluster[j], nodesOfCluster[i], cost, false);
+				}
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	bool HPAStar::isClusterFree( int aCluster) const
+	{
+		int minX = (aCluster % clustersX) * clusterSize;
+		int minY = (aCluster / clustersX) * clusterSize;
+		int maxX = std::min( minX + clusterSize, occupancyGrid.getWidth());
+		int maxY = std::min( minY + clusterSize, occupancyGrid.getHeight());
+
+		for (int y = minY; y < maxY; ++y)
+		{
+			for (int x = minX; x < maxX; ++x)
+			{
+				if (!occupancyGrid.isFree( x, y))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+	/**
+	 *
+	 */
+	int HPAStar::getNode(	int anX,
+							int anY)
+	{
+		int cell = anY * occupancyGrid.getWidth() + anX;
+		std::unordered_map< int, int >::iterator i = nodeOfCell.find( cell);
+		if (i != nodeOfCell.end())
+		{
+			return i->second;
+		}
+
+		int node;
+		if (!freeNodes.empty())
+		{
+			node = freeNodes.back();
+			freeNodes.pop_back();
+		} else
+		{
+			node = static_cast< int >( nodes.size());
+			nodes.push_back( Node{ Vertex( anX, anY), 0, false, std::vector< Edge >() });
+		}
+
+		Node& newNode = nodes[node];
+		newNode.cell = Vertex( anX, anY);
+		newNode.cluster = clusterOf( anX, anY);
+		newNode.alive = true;
+		newNode.edges.clear();
+
+		clusterNodes[newNode.cluster].push_back( node);
+		nodeOfCell[cell] = node;
+		return node;
+	}
+	/**
+	 *
+	 */
+	void HPAStar::removeNode( int aNode)
+	{
+		Node& node = nodes[aNode];
+		nodeOfCell.erase( node.cell.y * occupancyGrid.getWidth() + node.cell.x);
+
+		std::vector< int >& nodesOfCluster = clusterNodes[node.cluster];
+		nodesOfCluster.erase( std::remove( nodesOfCluster.begin(), nodesOfCluster.end(), aNode), nodesOfCluster.end());
+
+		node.alive = false;
+		node.edges.clear();
+		freeNodes.push_back( aNode);
+	}
+	/**
+	 *
+	 */
+	void HPAStar::connect( int aNode)
+	{
+		const int cluster = nodes[aNode].cluster;
+		if (!clusterFree[cluster])
+		{
+			searchCluster( nodes[aNode].cell, cluster, nullptr);
+		}
+
+		for (int node : clusterNodes[cluster])
+		{
+			if (node == aNode)
+			{
+				continue;
+			}
+			double cost = clusterFree[cluster] ? OctileDistance( nodes[aNode].cell, nodes[node].cell) : getClusterCost( nodes[node].cell);
+			if (cost < Infinity)
+			{
+				addEdge( aNode, node, cost, false);
+				addEdge( node, aNode, cost, false);
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	void HPAStar::disconnect( int aNode)
+	{
+		for (const Edge& edge : nodes[aNode].edges)
+		{
+			std::vector< Edge >& edges = nodes[edge.to].edges;
+			edges.erase( std::remove_if( edges.begin(), edges.end(), [aNode](const Edge& anEdge){ return anEdge.to == aNode;}), edges.end());
+		}
+		removeNode( aNode);
+	}
+	/**
+	 *
+	 */
+	void HPAStar::addEdge(	int aFrom,
+							int aTo,
+							double aCost,
+							bool anInter)
+	{
+		nodes[aFrom].edges.push_back( Edge{ aTo, aCost, anInter });
+	}
+	/**
+	 *
+	 */
+	void HPAStar::searchCluster(	const Vertex& aSource,
+									int aCluster,
+									const Vertex* aTarget)
+	{
+		clusterMinX = (aCluster % clustersX) * clusterSize;
+		clusterMinY = (aCluster / clustersX) * clusterSize;
+		const int maxX = std::min( clusterMinX + clusterSize, occupancyGrid.getWidth());
+		const int maxY = std::min( clusterMinY + clusterSize, occupancyGrid.getHeight());
+
+		++clusterGeneration;
+		if (clusterGeneration == 0)
+		{
+			std::fill( clusterVisited.begin(), clusterVisited.end(), 0);
+			clusterGeneration = 1;
+		}
+
+		Queue queue;
+		int source = (aSource.y - clusterMinY) * clusterSize + (aSource.x - clusterMinX);
+		clusterVisited[source] = clusterGeneration;
+		clusterClosed[source] = false;
+		clusterCosts[source] = 0.0;
+		clusterPredecessors[source] = -1;
+		queue.push( QueueEntry( aTarget ? OctileDistance( aSource, *aTarget) : 0.0, 0.0, source));
+
+		while (!queue.empty())
+		{
+			int current = std::get< 2 >( queue.top());
+			queue.pop();
+			if (clusterClosed[current])
+			{
+				continue;
+			}
+			clusterClosed[current] = true;
+
+			Vertex cell( clusterMinX + current % clusterSize, clusterMinY + current / clusterSize);
+			if (aTarget && cell.equalPoint( *aTarget))
+			{
+				break;
+			}
+
+			for (int i = 0; i < 8; ++i)
+			{
+				int x = cell.x + xOffset[i];
+				int y = cell.y + yOffset[i];
+				if (x < clusterMinX || x >= maxX || y < clusterMinY || y >= maxY || !occupancyGrid.isFree( x, y))
+				{
+					continue;
+				}
+
+				int neighbour = (y - clusterMinY) * clusterSize + (x - clusterMinX);
+				double cost = clusterCosts[current] + stepCost[i];
+				if (clusterVisited[neighbour] != clusterGeneration || cost < clusterCosts[neighbour])
+				{
+					clusterVisited[neighbour] = clusterGeneration;
+					clusterClosed[neighbour] = false;
+					clusterCosts[neighbour] = cost;
+					clusterPredecessors[neighbour] = current;
+					queue.push( QueueEntry( cost + (aTarget ? OctileDistance( Vertex( x, y), *aTarget) : 0.0), -cost, neighbour));
+				}
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	double HPAStar::getClusterCost( const Vertex& aVertex) const
+	{
+		int index = (aVertex.y - clusterMinY) * clusterSize + (aVertex.x - clusterMinX);
+		return clusterVisited[index] == clusterGeneration ? clusterCosts[index] : Infinity;
+	}
+	/**
+	 *
+	 */
+	std::vector< int > HPAStar::searchAbstract(	int aStart,
+												int aGoal)
+	{
+		if (abstractVisited.size() < nodes.size())
+		{
+			abstractVisited.resize( nodes.size(), 0);
+			abstractClosed.resize( nodes.size(), false);
+			abstractCosts.resize( nodes.size(), Infinity);
+			abstractPredecessors.resize( nodes.size(), -1);
+		}
+		++abstractGeneration;
+		if (abstractGeneration == 0)
+		{
+			std::fill( abstractVisited.begin(), abstractVisited.end(), 0);
+			abstractGeneration = 1;
+		}
+
+		ClosedSet expanded;
+		const Vertex& goal = nodes[aGoal].cell;
+
+		Queue queue;
+		abstractVisited[aStart] = abstractGeneration;
+		abstractClosed[aStart] = false;
+		abstractCosts[aStart] = 0.0;
+		abstractPredecessors[aStart] = -1;
+		queue.push( QueueEntry( OctileDistance( nodes[aStart].cell, goal), 0.0, aStart));
+
+		bool found = false;
+		while (!queue.empty())
+		{
+			int current = std::get< 2 >( queue.top());
+			queue.pop();
+			if (abstractClosed[current])
+			{
+				continue;
+			}
+			abstractClosed[current] = true;
+			expanded.push_back( nodes[current].cell);
+
+			if (current == aGoal)
+			{
+				found = true;
+				break;
+			}
+
+			for (const Edge& edge : nodes[current].edges)
+			{
+				double cost = abstractCosts[current] + edge.cost;
+				if (abstractVisited[edge.to] != abstractGeneration || cost < abstractCosts[edge.to])
+				{
+					abstractVisited[edge.to] = abstractGeneration;
+					abstractClosed[edge.to] = false;
+					abstractCosts[edge.to] = cost;
+					abstractPredecessors[edge.to] = current;
+					queue.push( QueueEntry( cost + OctileDistance( nodes[edge.to].cell, goal), -cost, edge.to));
+				}
+			}
+		}
+		{
+			std::lock_guard< std::mutex > lock( closedSetMutex);
+			closedSet.swap( expanded);
+		}
+		notifyObservers();
+
+		std::vector< int > abstractPath;
+		if (found)
+		{
+			for (int node = aGoal; node != -1; node = abstractPredecessors[node])
+			{
+				abstractPath.push_back( node);
+			}
+			std::reverse( abstractPath.begin(), abstractPath.end());
+		}
+		return abstractPath;
+	}
+	/**
+	 * In a cluster without obstacles the route is the diagonal part followed by the straight part,
+	 * all of its cells are within the bounding box of aFrom and aTo and therefore free.
+	 */
+	void HPAStar::refine(	const Vertex& aFrom,
+							const Vertex& aTo,
+							int aCluster,
+							Path& aPath)
+	{
+		if (clusterFree[aCluster])
+		{
+			Vertex cell( aFrom.x, aFrom.y);
+			while (!cell.equalPoint( aTo))
+			{
+				cell = Vertex( cell.x + (aTo.x > cell.x) - (aTo.x < cell.x), cell.y + (aTo.y > cell.y) - (aTo.y < cell.y));
+				aPath.push_back( cell);
+			}
+			return;
+		}
+
+		searchCluster( aFrom, aCluster, &aTo);
+
+		Path segment;
+		int source = (aFrom.y - clusterMinY) * clusterSize + (aFrom.x - clusterMinX);
+		for (int index = (aTo.y - clusterMinY) * clusterSize + (aTo.x - clusterMinX); index != source && index != -1; index = clusterPredecessors[index])
+		{
+			segment.push_back( Vertex( clusterMinX + index % clusterSize, clusterMinY + index / clusterSize));
+		}
+		aPath.insert( aPath.end(), segment.rbegin(), segment.rend());
+	}
+} // namespace PathAlgorithm
@@ -0,0 +1,259 @@
+#ifndef HPASTAR_HPP_
+#define HPASTAR_HPP_
+
+#include "Config.hpp"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "AStar.hpp"
+#include "Notifier.hpp"
+#include "OccupancyGrid.hpp"
+#include "Point.hpp"
+#include "Size.hpp"
+#include "Vertex.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 * Hierarchical path-finding A* (Botea, Müller & Schaeffer) for worlds that are too large
+	 * to search cell by cell.
+	 *
+	 * The occupancy grid is split into square clusters. Where two neighbouring clusters share
+	 * a run of free cells an entrance is placed, the cells on both sides of an entrance are the
+	 * nodes of an abstract graph. Within a cluster the nodes are connected with their shortest
+	 * distance through that cluster. A search connects the start and the goal to the nodes of their
+	 * clusters, searches the abstract graph and refines every abstract edge into cells with a
+	 * search that is limited to one cluster.
+	 *
+	 * The grid and the abstract graph are kept between searches. Only the clusters that contain
+	 * cells that changed since the previous search are rebuilt, together with their borders.
+	 * The routes are near-optimal: they only cross cluster borders at the entrances.
+	 */
+	class HPAStar : public Base::Notifier
+	{
+		public:
+			/**
+			 * The default width and height of a cluster in cells
+			 */
+			static const int DefaultClusterSize = 64;
+			/**
+			 *
+			 */
+			explicit HPAStar( int aClusterSize = DefaultClusterSize);
+			/**
+			 *
+			 */
+			Path search(const Point& aStartPoint,
+						const Point& aGoalPoint,
+						const Size& aRobotSize);
+			/**
+			 *
+			 */
+			Path search(Vertex aStart,
+						const Vertex& aGoal,
+						const Size& aRobotSize);
+			/**
+			 * Throws away the grid and the abstract graph, the next search rebuilds them
+			 */
+			void reset();
+			/**
+			 *
+			 */
+			int getClusterSize() const
+			{
+				return clusterSize;
+			}
+			/**
+			 *
+			 * @return The number of nodes in the abstract graph
+			 */
+			std::size_t getNumberOfNodes() const;
+			/**
+			 *
+			 * @return The abstract nodes that were expanded during the last search
+			 */
+			ClosedSet getClosedSet() const;
+			/**
+			 *
+			 * @return The grid the last search was done on
+			 */
+			const OccupancyGrid& getOccupancyGrid() const
+			{
+				return occupancyGrid;
+			}
+			/**
+			 * The Robot that plans with this HPAStar is not an obstacle for its own routes, with
+			 * an empty name all Robots are obstacles
+			 */
+			void setRobotName( const std::string& aRobotName)
+			{
+				robotName = aRobotName;
+			}
+			/**
+			 *
+			 */
+			const std::string& getRobotName() const
+			{
+				return robotName;
+			}
+
+		private:
+			/**
+			 *
+			 */
+			struct Edge
+			{
+					int to;
+					double cost;
+					/**
+					 * True for the edge between the two sides of an entrance, false within a cluster
+					 */
+					bool inter;
+			};
+			/**
+			 *
+			 */
+			struct Node
+			{
+					Vertex cell;
+					int cluster;
+					bool alive;
+					std::vector< Edge > edges;
+			};
+			/**
+			 * The pairs of nodes of the entrances of one border between two clusters
+			 */
+			typedef std::vector< std::pair< int, int > > Entrances;
+			/**
+			 * Builds the abstract graph for the whole grid
+			 */
+			void build();
+			/**
+			 * Rebuilds the clusters that contain aChangedCells, their borders and their neighbours' edges
+			 */
+			void update( const std::vector< Vertex >& someChangedCells);
+			/**
+			 *
+			 */
+			void buildBorder(	bool aVertical,
+								int aBorder);
+			/**
+			 *
+			 */
+			void clearBorder( Entrances& anEntrances);
+			/**
+			 * Removes the nodes of aCluster that are no longer part of an entrance and recalculates
+			 * the edges within aCluster
+			 */
+			void buildCluster( int aCluster);
+			/**
+			 *
+			 */
+			bool isClusterFree( int aCluster) const;
+			/**
+			 *
+			 */
+			int clusterOf(	int anX,
+							int anY) const
+			{
+				return (anY / clusterSize) * clustersX + anX / clusterSize;
+			}
+			/**
+			 *
+			 */
+			int getNode(	int anX,
+							int anY);
+			/**
+			 *
+			 */
+			void removeNode( int aNode);
+			/**
+			 * Adds edges between aNode and the other nodes of its cluster that are reachable within the cluster
+			 */
+			void connect( int aNode);
+			/**
+			 * Removes a node that was only added for one search, together with the edges to it
+			 */
+			void disconnect( int aNode);
+			/**
+			 *
+			 */
+			void addEdge(	int aFrom,
+							int aTo,
+							double aCost,
+							bool anInter);
+			/**
+			 * Dijkstra from aSource over the free cells of aCluster, or A* if aTarget is given.
+			 * The costs and predecessors are left in the cluster arrays.
+			 */
+			void searchCluster(	const Vertex& aSource,
+								int aCluster,
+								const Vertex* aTarget);
+			/**
+			 *
+			 * @return The cost to aVertex found by the last searchCluster, infinity if not reached
+			 */
+			double getClusterCost( const Vertex& aVertex) const;
+			/**
+			 * Searches the abstract graph from aStart to aGoal
+			 *
+			 * @return The nodes of the abstract route, empty if there is no route
+			 */
+			std::vector< int > searchAbstract(	int aStart,
+												int aGoal);
+			/**
+			 * Appends the cells from aFrom (exclusive) to aTo (inclusive) to aPath, both nodes must be in aCluster
+			 */
+			void refine(	const Vertex& aFrom,
+							const Vertex& aTo,
+							int aCluster,
+							Path& aPath);
+
+			int clusterSize;
+			int clustersX;
+			int clustersY;
+			int radius;
+			bool built;
+
+			std::vector< OccupancyGrid::Line > obstacleLines;
+			OccupancyGrid occupancyGrid;
+			std::string robotName;
+
+			std::vector< Node > nodes;
+			std::vector< int > freeNodes;
+			std::unordered_map< int, int > nodeOfCell;
+			std::vector< std::vector< int > > clusterNodes;
+			std::vector< bool > clusterFree;
+			/**
+			 * The borders between a cluster and its right neighbour and between a cluster and the one below it
+			 */
+			std::vector< Entrances > verticalBorders;
+			std::vector< Entrances > horizontalBorders;
+			/**
+			 * Scratch arrays of searchCluster, one entry per cell of a cluster
+			 */
+			int clusterMinX;
+			int clusterMinY;
+			unsigned int clusterGeneration;
+			std::vector< unsigned int > clusterVisited;
+			std::vector< bool > clusterClosed;
+			std::vector< double > clusterCosts;
+			std::vector< int > clusterPredecessors;
+			/**
+			 * Scratch arrays of searchAbstract, one entry per node
+			 */
+			unsigned int abstractGeneration;
+			std::vector< unsigned int > abstractVisited;
+			std::vector< bool > abstractClosed;
+			std::vector< double > abstractCosts;
+			std::vector< int > abstractPredecessors;
+
+			ClosedSet closedSet;
+			mutable std::mutex closedSetMutex;
+	}; // class HPAStar
+} // namespace PathAlgorithm
+#endif // HPASTAR_HPP_
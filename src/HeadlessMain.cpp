@@ -0,0 +1,230 @@
+#include "Config.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Commandline.hpp"
+#include "EventLog.hpp"
+#include "Goal.hpp"
+#include "LaserDistanceSensor.hpp"
+#include "Logger.hpp"
+#include "Robot.hpp"
+#include "RobotWorld.hpp"
+#include "Scheduler.hpp"
+#include "StdOutDebugTraceFunction.hpp"
+#include "WayPoint.hpp"
+
+/**
+ * Runs a situation of the RobotWorld without a GUI and without an X display:
+ *
+ * robotworld_headless [-situation=1..6] [-other] [-duration=ms] [-world_size=n] [-log]
+ * 						[-tick_rate=n] [-fast] [-workers=n] [-deterministic] [-seed=n] [-record=file] [-laser]
+ * robotworld_headless -replay=file
+ *
+ * All Robots are started and the program waits until the Scheduler has nothing left to step
+ * or the duration has passed, then it prints where the Robots ended. With -laser every Robot
+ * scans its surroundings with a LaserDistanceSensor every tick.
+ *
+ * With -record the run is deterministic and its events are written to the file. With -replay the
+ * run is repeated with the arguments in the file, as fast as possible, and the program reports
+ * whether it gave exactly the same events or where it diverged.
+ */
+int main( 	int argc,
+			char* argv[])
+{
+	try
+	{
+		Application::Commandline::setCommandlineArguments( argc, argv);
+
+		// The arguments are set before anything reads them, a replay runs with the recorded ones
+		std::string recordFile;
+		Model::EventLog& eventLog = Model::EventLog::getEventLog();
+		if (Application::Commandline::isArgGiven( "-replay"))
+		{
+			std::vector< std::string > arguments = eventLog.startReplaying( Application::Commandline::getArg( "-replay").value);
+			arguments.insert( arguments.begin(), argv[0]);
+			arguments.push_back( "-deterministic");
+			arguments.push_back( "-fast");
+			std::vector< char* > replayArgv;
+			for (std::string& argument : arguments)
+			{
+				replayArgv.push_back( &argument[0]);
+			}
+			Application::Commandline::setCommandlineArguments( static_cast< int >( replayArgv.size()), replayArgv.data());
+		} else if (Application::Commandline::isArgGiven( "-record"))
+		{
+			recordFile = Application::Commandline::getArg( "-record").value;
+			std::vector< std::string > arguments;
+			for (int i = 1; i < argc; ++i)
+			{
+				const std::string argument( argv[i]);
+				if (argument.compare( 0, 8, "-record=") != 0 && argument != "-deterministic")
+				{
+					arguments.push_back( argument);
+				}
+			}
+			std::string deterministic( "-deterministic");
+			std::vector< char* > recordArgv( argv, argv + argc);
+			recordArgv.push_back( &deterministic[0]);
+			Application::Commandline::setCommandlineArguments( static_cast< int >( recordArgv.size()), recordArgv.data());
+			eventLog.startRecording( recordFile, arguments);
+		}
+
+		Base::StdOutDebugTraceFunction traceFunction;
+		if (Application::Commandline::isArgGiven( "-log"))
+		{
+			Application::Logger::setTraceFunction( &traceFunction);
+		} else
+		{
+			Application::Logger::setDisable();
+		}
+
+		unsigned long situation = 1;
+		if (Application::Commandline::isArgGiven( "-situation"))
+		{
+			situation = std::stoul( Application::Commandline::getArg( "-situation").value);
+		}
+		std::chrono::milliseconds duration( 10000);
+		if (Application::Commandline::isArgGiven( "-duration"))
+		{
+			duration = std::chrono::milliseconds( std::stoul( Application::Commandline::getArg( "-duration").value));
+		}
+
+		Model::RobotWorld& robotWorld = Model::RobotWorld::getRobotWorld();
+		if (Application::Commandline::isArgGiven( "-world_size"))
+		{
+			int worldSize = std::stoi( Application::Commandline::getArg( "-world_size").value);
+			robotWorld.setWorldSize( Size( worldSize, worldSize), false);
+		}
+
+		const bool other = Application::Commandline::isArgGiven( "-other");
+		switch (situation)
+		{
+			case 1:
+			{
+				robotWorld.situationOne( other);
+				break;
+			}
+			case 2:
+			{
+				robotWorld.situationTwo( other);
+				break;
+			}
+			case 3:
+			{
+				robotWorld.situationThree( other);
+				break;
+			}
+			case 4:
+			{
+				robotWorld.situationFour( other);
+				break;
+			}
+			case 5:
+			{
+				robotWorld.situationFive( other);
+				break;
+			}
+			case 6:
+			{
+				robotWorld.situationSix( other);
+				break;
+			}
+			default:
+			{
+				throw std::invalid_argument( "There is no situation " + std::to_string( situation));
+			}
+		}
+
+		// Without the shapes nobody gives the objects a size, these are about the sizes the shapes
+		// give them with their default titles
+		for (Model::WayPointPtr wayPoint : robotWorld.getWayPoints())
+		{
+			wayPoint->setSize( Size( 40, 25), false);
+		}
+		for (Model::GoalPtr goal : robotWorld.getGoals())
+		{
+			goal->setSize( Size( 40, 25), false);
+		}
+		// No tick runs before all Robots are started, otherwise the first Robot could already be
+		// driving while the others start
+		Model::Scheduler& scheduler = Model::Scheduler::getScheduler();
+		const unsigned long long firstTick = scheduler.getTick();
+		scheduler.pauseAt( firstTick);
+
+		// The Robots are copied because starting them adds Goals to the RobotWorld
+		std::vector< Model::RobotPtr > robots = robotWorld.getRobots();
+		for (Model::RobotPtr robot : robots)
+		{
+			robot->setSize( Size( 37, 29), false);
+		}
+		robotWorld.startRobots();
+
+		// The duration is simulated time, with -fast it passes faster than the wall clock. The run
+		// pauses at the last tick so it always ends at the same tick.
+		const unsigned long long lastTick = firstTick + scheduler.getTicksFor( duration);
+		std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+		scheduler.pauseAt( lastTick);
+		scheduler.waitUntilIdle( lastTick);
+		const double wallSeconds = std::chrono::duration< double >( std::chrono::steady_clock::now() - begin).count();
+		const double seconds = static_cast< double >( scheduler.getTick() - firstTick) / scheduler.getTickRate();
+
+		for (Model::RobotPtr robot : robots)
+		{
+			robot->stopActing();
+		}
+		const bool replaying = eventLog.isReplaying();
+		eventLog.stop();
+
+		Model::GoalPtr goal = robotWorld.getGoal( "Goal");
+		std::cout << "situation " << situation << (other ? " (other)" : "") << " after " << seconds << " s (" << wallSeconds << " s wall clock time)" << std::endl;
+		for (Model::RobotPtr robot : robots)
+		{
+			const Point position = robot->getPosition();
+			std::cout << "  " << robot->getName() << ": position (" << position.x << "," << position.y << ")";
+			if (goal)
+			{
+				const Point goalPosition = goal->getPosition();
+				std::cout << ", distance to the goal " << std::hypot( goalPosition.x - position.x, goalPosition.y - position.y);
+			}
+			std::shared_ptr< const Model::DistanceScanPercept > laserScan = robot->getLaserScan();
+			if (laserScan && !laserScan->distances.empty())
+			{
+				auto nearest = std::min_element( laserScan->distances.begin(), laserScan->distances.end(), []( const Model::DistancePercept& lhs, const Model::DistancePercept& rhs){ return lhs.distance < rhs.distance;});
+				std::cout << ", nearest obstacle of the last scan " << nearest->distance;
+			}
+			std::cout << std::endl;
+		}
+
+		if (!recordFile.empty())
+		{
+			std::cout << "recorded " << eventLog.getNumberOfEvents() << " events in " << recordFile << std::endl;
+		}
+		if (replaying)
+		{
+			if (!eventLog.isIdentical())
+			{
+				std::cout << "the replay diverged after " << eventLog.getNumberOfEvents() << " events: " << eventLog.getDivergence() << std::endl;
+				Application::Logger::setTraceFunction( nullptr);
+				return 1;
+			}
+			std::cout << "the replay gave the same " << eventLog.getNumberOfEvents() << " events" << std::endl;
+		}
+
+		Application::Logger::setTraceFunction( nullptr);
+		return 0;
+	}
+	catch (std::exception& e)
+	{
+		std::cerr << __PRETTY_FUNCTION__ << ": " << e.what() << std::endl;
+	}
+	catch (...)
+	{
+		std::cerr << __PRETTY_FUNCTION__ << ": unknown exception" << std::endl;
+	}
+	return 1;
+}
@@ -0,0 +1,343 @@
+#include "JumpPointSearch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	static double Distance(	const Vertex& aStart,
+							const Vertex& aGoal)
+	{
+		return std::sqrt( (aStart.x - aGoal.x) * (aStart.x - aGoal.x) + (aStart.y - aGoal.y) * (aStart.y - aGoal.y));
+	}
+	/**
+	 *
+	 */
+	static int Sign( int aValue)
+	{
+		return (aValue > 0) - (aValue < 0);
+	}
+	/**
+	 *
+	 */
+	Path JumpPointSearch::search(	const Point& aStartPoint,
+									const Point& aGoalPoint,
+									const Size& aRobotSize)
+	{
+		Vertex start( aStartPoint);
+		Vertex goal( aGoalPoint);
+
+		return search( start, goal, aRobotSize);
+	}
+	/**
+	 *
+	 */
+	Path JumpPointSearch::search(	Vertex aStart,
+									const Vertex& aGoal,
+									const Size& aRobotSize)
+	{
+		AStar::fillOccupancyGrid( occupancyGrid, AStar::freeRadius( aRobotSize), robotName);
+
+		return search( aStart, aGoal, occupancyGrid);
+	}
+	/**
+	 *
+	 */
+	Path JumpPointSearch::search(	Vertex aStart,
+									const Vertex& aGoal,
+									const OccupancyGrid& aGrid)
+	{
+		openSet.reset( aGrid.getWidth(), aGrid.getHeight());
+		vertexTable.reset( aGrid.getWidth(), aGrid.getHeight());
+		progress.start();
+
+		if (!vertexTable.isInside( aStart) || !vertexTable.isInside( aGoal))
+		{
+			std::cerr << "**** No route from " << aStart << " to " << aGoal << ", outside the world" << std::endl;
+			publishProgress();
+			return Path();
+		}
+
+		aStart.actualCost = 0.0;
+		aStart.heuristicCost = Distance( aStart, aGoal);
+		vertexTable.visit( aStart);
+		openSet.push( aStart);
+
+		std::vector< Vertex > successors;
+		successors.reserve( 8);
+
+		while (!openSet.empty())
+		{
+			Vertex current = openSet.top();
+
+			if (current.equalPoint( aGoal))
+			{
+				publishProgress();
+				return constructPath( current);
+			}
+
+			getSuccessors( current, aGoal, aGrid, successors);
+
+			openSet.pop();
+			vertexTable.setClosed( current);
+
+			for (Vertex& successor : successors)
+			{
+				double actualCost = current.actualCost + Distance( current, successor);
+				double heuristicCost = actualCost + Distance( successor, aGoal);
+
+				if (vertexTable.isVisited( successor) && vertexTable.get( successor).heuristicCost <= heuristicCost)
+				{
+					continue;
+				}
+
+				successor.actualCost = actualCost;
+				successor.heuristicCost = heuristicCost;
+
+				vertexTable.visit( successor, current);
+				openSet.push( successor);
+			}
+
+			if (progress.expand())
+			{
+				publishProgress();
+			}
+		}
+
+		std::cerr << "**** No route from " << aStart << " to " << aGoal << std::endl;
+		publishProgress();
+		return Path();
+	}
+	/**
+	 *
+	 */
+	OpenSet JumpPointSearch::getOpenSet() const
+	{
+		return progress.getOpenSet();
+	}
+	/**
+	 *
+	 */
+	ClosedSet JumpPointSearch::getClosedSet() const
+	{
+		return progress.getClosedSet();
+	}
+	/**
+	 *
+	 */
+	void JumpPointSearch::publishProgress()
+	{
+		if (!progress.isEnabled())
+		{
+			return;
+		}
+		progress.publish( openSet.getVertices(), vertexTable.getClosedVertices());
+		notifyObservers();
+	}
+	/**
+	 * The pruning rules for a robot that may always move diagonally: moving straight only the
+	 * straight direction is natural, moving diagonally the diagonal and its two straight components are.
+	 * A blocked cell next to the point makes the diagonal "around" that cell a forced direction.
+	 */
+	void JumpPointSearch::getSuccessors(	const Vertex& aVertex,
+											const Vertex& aGoal,
+											const OccupancyGrid& aGrid,
+											std::vector< Vertex >& aSuccessors) const
+	{
+		static int xOffset[] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+		static int yOffset[] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+
+		int x = aVertex.x;
+		int y = aVertex.y;
+
+		int xDirections[8];
+		int yDirections[8];
+		int numberOfDirections = 0;
+
+		if (!vertexTable.hasPredecessor( aVertex))
+		{
+			for (int i = 0; i < 8; ++i)
+			{
+				xDirections[numberOfDirections] = xOffset[i];
+				yDirections[numberOfDirections++] = yOffset[i];
+			}
+		} else
+		{
+			Vertex predecessor = vertexTable.getPredecessor( aVertex);
+			int dx = Sign( x - predecessor.x);
+			int dy = Sign( y - predecessor.y);
+
+			if (dx != 0 && dy != 0)
+			{
+				xDirections[numberOfDirections] = 0;
+				yDirections[numberOfDirections++] = dy;
+				xDirections[numberOfDirections] = dx;
+				yDirections[numberOfDirections++] = 0;
+				xDirections[numberOfDirections] = dx;
+				yDirections[numberOfDirections++] = dy;
+				if (!aGrid.isFree( x - dx, y))
+				{
+					xDirections[numberOfDirections] = -dx;
+					yDirections[numberOfDirections++] = dy;
+				}
+				if (!aGrid.isFree( x, y - dy))
+				{
+					xDirections[numberOfDirections] = dx;
+					yDirections[numberOfDirections++] = -dy;
+				}
+			} else if (dx == 0)
+			{
+				xDirections[numberOfDirections] = 0;
+				yDirections[numberOfDirections++] = dy;
+				if (!aGrid.isFree( x + 1, y))
+				{
+					xDirections[numberOfDirections] = 1;
+					yDirections[numberOfDirections++] = dy;
+				}
+				if (!aGrid.isFree( x - 1, y))
+				{
+					xDirections[numberOfDirections] = -1;
+					yDirections[numberOfDirections++] = dy;
+				}
+			} else
+			{
+				xDirections[numberOfDirections] = dx;
+				yDirections[numberOfDirections++] = 0;
+				if (!aGrid.isFree( x, y + 1))
+				{
+					xDirections[numberOfDirections] = dx;
+					yDirections[numberOfDirections++] = 1;
+				}
+				if (!aGrid.isFree( x, y - 1))
+				{
+					xDirections[numberOfDirections] = dx;
+					yDirections[numberOfDirections++] = -1;
+				}
+			}
+		}
+
+		aSuccessors.clear();
+
+		Vertex jumpPoint( 0, 0);
+		for (int i = 0; i < numberOfDirections; ++i)
+		{
+			if (jump( x + xDirections[i], y + yDirections[i], xDirections[i], yDirections[i], aGoal, aGrid, jumpPoint))
+			{
+				aSuccessors.push_back( jumpPoint);
+			}
+		}
+	}
+	/**
+	 * A diagonal step is a jump point if it has a forced neighbour or if one of its straight
+	 * components leads to a jump point. The jumps are loops so a long open corridor does not recurse.
+	 */
+	bool JumpPointSearch::jump(	int anX,
+								int anY,
+								int aDeltaX,
+								int aDeltaY,
+								const Vertex& aGoal,
+								const OccupancyGrid& aGrid,
+								Vertex& aJumpPoint) const
+	{
+		if (aDeltaX == 0 || aDeltaY == 0)
+		{
+			return jumpStraight( anX, anY, aDeltaX, aDeltaY, aGoal, aGrid, aJumpPoint);
+		}
+
+		Vertex straightJumpPoint( 0, 0);
+		for (;; anX += aDeltaX, anY += aDeltaY)
+		{
+			if (!aGrid.isFree( anX, anY))
+			{
+				return false;
+			}
+			if ((anX == aGoal.x && anY == aGoal.y) ||
+				(aGrid.isFree( anX - aDeltaX, anY + aDeltaY) && !aGrid.isFree( anX - aDeltaX, anY)) ||
+				(aGrid.isFree( anX + aDeltaX, anY - aDeltaY) && !aGrid.isFree( anX, anY - aDeltaY)) ||
+				jumpStraight( anX + aDeltaX, anY, aDeltaX, 0, aGoal, aGrid, straightJumpPoint) ||
+				jumpStraight( anX, anY + aDeltaY, 0, aDeltaY, aGoal, aGrid, straightJumpPoint))
+			{
+				aJumpPoint = Vertex( anX, anY);
+				return true;
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	bool JumpPointSearch::jumpStraight(	int anX,
+										int anY,
+										int aDeltaX,
+										int aDeltaY,
+										const Vertex& aGoal,
+										const OccupancyGrid& aGrid,
+										Vertex& aJumpPoint) const
+	{
+		for (;; anX += aDeltaX, anY += aDeltaY)
+		{
+			if (!aGrid.isFree( anX, anY))
+			{
+				return false;
+			}
+
+			bool isJumpPoint = anX == aGoal.x && anY == aGoal.y;
+			if (!isJumpPoint && aDeltaX != 0)
+			{
+				isJumpPoint = (aGrid.isFree( anX + aDeltaX, anY + 1) && !aGrid.isFree( anX, anY + 1)) ||
+							  (aGrid.isFree( anX + aDeltaX, anY - 1) && !aGrid.isFree( anX, anY - 1));
+			} else if (!isJumpPoint)
+			{
+				isJumpPoint = (aGrid.isFree( anX + 1, anY + aDeltaY) && !aGrid.isFree( anX + 1, anY)) ||
+							  (aGrid.isFree( anX - 1, anY + aDeltaY) && !aGrid.isFree( anX - 1, anY));
+			}
+			if (isJumpPoint)
+			{
+				aJumpPoint = Vertex( anX, anY);
+				return true;
+			}
+		}
+	}
+	/**
+	 * Two successive jump points always lie on a straight or a diagonal line so the cells
+	 * between them are found by stepping from one to the other.
+	 */
+	Path JumpPointSearch::constructPath( const Vertex& aGoal) const
+	{
+		std::vector< Vertex > jumpPoints;
+		for (Vertex vertex = aGoal;; vertex = vertexTable.getPredecessor( vertex))
+		{
+			jumpPoints.push_back( vertex);
+			if (!vertexTable.hasPredecessor( vertex))
+			{
+				break;
+			}
+		}
+		std::reverse( jumpPoints.begin(), jumpPoints.end());
+
+		Path path;
+		path.push_back( jumpPoints.front());
+		for (std::size_t i = 1; i < jumpPoints.size(); ++i)
+		{
+			const Vertex& from = jumpPoints[i - 1];
+			const Vertex& to = jumpPoints[i];
+			int dx = Sign( to.x - from.x);
+			int dy = Sign( to.y - from.y);
+			int steps = std::max( std::abs( to.x - from.x), std::abs( to.y - from.y));
+			double stepCost = (dx != 0 && dy != 0) ? std::sqrt( 2.0) : 1.0;
+
+			for (int step = 1; step < steps; ++step)
+			{
+				Vertex vertex( from.x + step * dx, from.y + step * dy);
+				vertex.actualCost = from.actualCost + step * stepCost;
+				vertex.heuristicCost = vertex.actualCost + Distance( vertex, aGoal);
+				path.push_back( vertex);
+			}
+			path.push_back( to);
+		}
+		return path;
+	}
+} // namespace PathAlgorithm
@@ -0,0 +1,142 @@
+#ifndef JUMPPOINTSEARCH_HPP_
+#define JUMPPOINTSEARCH_HPP_
+
+#include "Config.hpp"
+
+#include <string>
+#include <vector>
+
+#include "AStar.hpp"
+#include "Notifier.hpp"
+#include "OccupancyGrid.hpp"
+#include "Point.hpp"
+#include "SearchProgress.hpp"
+#include "Size.hpp"
+#include "Vertex.hpp"
+#include "VertexHeap.hpp"
+#include "VertexTable.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 * Jump Point Search (Harabor & Grastien) on the same 8-connected, uniform-cost grid as AStar.
+	 *
+	 * Instead of adding every free neighbour to the openSet, the search "jumps" in straight and
+	 * diagonal lines and only stops at the goal and at points with a forced neighbour. The routes
+	 * have the same length as the routes of AStar but far fewer Vertices are expanded.
+	 *
+	 * Like AStar the robot may always move diagonally, also between two blocked orthogonal
+	 * neighbours, so the pruning rules are those of the "always move diagonally" variant.
+	 * The jump points are expanded again into a route with one Vertex per grid cell.
+	 */
+	class JumpPointSearch : public Base::Notifier
+	{
+		public:
+			/**
+			 *
+			 */
+			Path search(const Point& aStartPoint,
+						const Point& aGoalPoint,
+						const Size& aRobotSize);
+			/**
+			 *
+			 */
+			Path search(Vertex aStart,
+						const Vertex& aGoal,
+						const Size& aRobotSize);
+			/**
+			 * Searches on an already filled aGrid, aGrid must contain the clearance of the robot
+			 */
+			Path search(Vertex aStart,
+						const Vertex& aGoal,
+						const OccupancyGrid& aGrid);
+			/**
+			 *
+			 * @return The jump points that are in the openSet of the last snapshot
+			 */
+			OpenSet getOpenSet() const;
+			/**
+			 *
+			 * @return The jump points that were expanded in the last snapshot
+			 */
+			ClosedSet getClosedSet() const;
+			/**
+			 *
+			 * @return The grid the last search was done on
+			 */
+			const OccupancyGrid& getOccupancyGrid() const
+			{
+				return occupancyGrid;
+			}
+			/**
+			 * The Robot that plans with this JumpPointSearch is not an obstacle for its own routes, with
+			 * an empty name all Robots are obstacles
+			 */
+			void setRobotName( const std::string& aRobotName)
+			{
+				robotName = aRobotName;
+			}
+			/**
+			 *
+			 */
+			const std::string& getRobotName() const
+			{
+				return robotName;
+			}
+			/**
+			 * The snapshots of the search for a visualiser, every snapshot notifies the observers
+			 */
+			SearchProgress& getProgress()
+			{
+				return progress;
+			}
+
+		private:
+			/**
+			 * Adds the jump points that are reachable from aVertex to aSuccessors. The directions
+			 * that are searched are pruned by the direction from which aVertex was reached.
+			 */
+			void getSuccessors(	const Vertex& aVertex,
+								const Vertex& aGoal,
+								const OccupancyGrid& aGrid,
+								std::vector< Vertex >& aSuccessors) const;
+			/**
+			 * Steps from (anX,anY) in direction (aDeltaX,aDeltaY) until it finds a jump point.
+			 *
+			 * @return True if a jump point was found, it is returned in aJumpPoint
+			 */
+			bool jump(	int anX,
+						int anY,
+						int aDeltaX,
+						int aDeltaY,
+						const Vertex& aGoal,
+						const OccupancyGrid& aGrid,
+						Vertex& aJumpPoint) const;
+			/**
+			 * The straight part of jump(), also used to scan the two straight directions of a diagonal jump
+			 */
+			bool jumpStraight(	int anX,
+								int anY,
+								int aDeltaX,
+								int aDeltaY,
+								const Vertex& aGoal,
+								const OccupancyGrid& aGrid,
+								Vertex& aJumpPoint) const;
+			/**
+			 * Expands the jump points from the start to aGoal into a route with a Vertex for every grid cell
+			 */
+			Path constructPath( const Vertex& aGoal) const;
+			/**
+			 * Copies the openSet and the closedSet into the snapshot and notifies the observers
+			 */
+			void publishProgress();
+
+			VertexHeap openSet;
+			VertexTable vertexTable;
+			OccupancyGrid occupancyGrid;
+			std::string robotName;
+
+			SearchProgress progress;
+	}; // class JumpPointSearch
+} // namespace PathAlgorithm
+#endif // JUMPPOINTSEARCH_HPP_
@@ -8,22 +8,92 @@
 #include "LaserDistanceSensor.hpp"
 #include "Robot.hpp"
 #include "Logger.hpp"
+#include "WallTree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace Model
 {
 	#pragma region LaserDistanceSensor
+	/**
+	 * The slab test in the frame of the box: the distance along the ray from anOrigin in the unit
+	 * direction (aDirectionX, aDirectionY) where it enters the oriented box of aPose, 0 if anOrigin is
+	 * in the box and infinity if the ray misses it
+	 */
+	static double RayEntersBox(	const Point& anOrigin,
+								double aDirectionX,
+								double aDirectionY,
+								const Robot::Pose& aPose)
+	{
+		const double centreX = (aPose.frontLeft.x + aPose.backRight.x) / 2.0;
+		const double centreY = (aPose.frontLeft.y + aPose.backRight.y) / 2.0;
+		const Point axes[] = { aPose.frontRight - aPose.frontLeft, aPose.backLeft - aPose.frontLeft };
+
+		double entry = 0.0;
+		double exit = std::numeric_limits< double >::infinity();
+		for (const Point& axis : axes)
+		{
+			const double length = std::hypot( axis.x, axis.y);
+			if (length == 0.0)
+			{
+				return std::numeric_limits< double >::infinity();
+			}
+			const double halfLength = length / 2.0;
+			const double origin = ((anOrigin.x - centreX) * axis.x + (anOrigin.y - centreY) * axis.y) / length;
+			const double direction = (aDirectionX * axis.x + aDirectionY * axis.y) / length;
+			if (direction == 0.0)
+			{
+				if (std::abs( origin) > halfLength)
+				{
+					return std::numeric_limits< double >::infinity();
+				}
+				continue;
+			}
+			double near = (-halfLength - origin) / direction;
+			double far = (halfLength - origin) / direction;
+			if (near > far)
+			{
+				std::swap( near, far);
+			}
+			entry = std::max( entry, near);
+			exit = std::min( exit, far);
+			if (entry > exit)
+			{
+				return std::numeric_limits< double >::infinity();
+			}
+		}
+		return entry;
+	}
 	/**
 	 *
 	 */
-	LaserDistanceSensor::LaserDistanceSensor()
+	LaserDistanceSensor::LaserDistanceSensor() :
+								robot( nullptr),
+								range( DefaultRange)
 	{
 	}
 	/**
 	 *
 	 */
-	LaserDistanceSensor::LaserDistanceSensor( Robot* aRobot) :
-								AbstractSensor( aRobot)
+	LaserDistanceSensor::LaserDistanceSensor(	Robot* aRobot,
+												unsigned short aNumberOfBeams /*= DefaultNumberOfBeams*/,
+												double aFieldOfView /*= 2 * Utils::PI*/,
+												double aRange /*= DefaultRange*/) :
+								AbstractSensor( aRobot),
+								robot( aRobot),
+								range( aRange)
 	{
+		const bool fullTurn = aFieldOfView >= 2 * Utils::PI;
+		const double step = aNumberOfBeams > 1 ? aFieldOfView / (fullTurn ? aNumberOfBeams : aNumberOfBeams - 1) : 0.0;
+		const double firstAngle = aNumberOfBeams > 1 ? -aFieldOfView / 2 : 0.0;
+		for (unsigned short beam = 0; beam < aNumberOfBeams; ++beam)
+		{
+			const double angle = firstAngle + beam * step;
+			beamAngles.push_back( angle);
+			beamCosines.push_back( std::cos( angle));
+			beamSines.push_back( std::sin( angle));
+		}
 	}
 	/**
 	 *
@@ -36,16 +106,55 @@ namespace Model
 	 */
 	std::shared_ptr< AbstractStimulus > LaserDistanceSensor::getStimulus() const
 	{
-		std::shared_ptr< AbstractStimulus > distanceStimulus( new DistanceStimulus( 666,666));
-		return distanceStimulus;
+		std::vector< DistanceStimulus > distances;
+		if (!robot)
+		{
+			return std::shared_ptr< AbstractStimulus >( new DistanceScanStimulus( distances));
+		}
+		const Robot::Pose pose = robot->getPose();
+		const Point origin = robot->getPosition();
+
+		// One snapshot of the Walls and the poses of the Robots within the range for the whole scan
+		std::shared_ptr< const WallTree > wallTree = RobotWorld::getRobotWorld().getWallTree();
+		const int reach = static_cast< int >( std::ceil( range));
+		std::vector< Robot* > robots;
+		RobotWorld::getRobotWorld().getCollisionGrid().findRobots( Point( origin.x - reach, origin.y - reach), Point( origin.x + reach, origin.y + reach), robots);
+		std::vector< Robot::Pose > otherPoses;
+		for (Robot* otherRobot : robots)
+		{
+			if (otherRobot != robot)
+			{
+				otherPoses.push_back( otherRobot->getPose());
+			}
+		}
+
+		distances.reserve( beamAngles.size());
+		for (std::size_t beam = 0; beam < beamAngles.size(); ++beam)
+		{
+			const double directionX = pose.headingX * beamCosines[beam] - pose.headingY * beamSines[beam];
+			const double directionY = pose.headingX * beamSines[beam] + pose.headingY * beamCosines[beam];
+
+			double distance = range;
+			double wallDistance;
+			if (wallTree->castRay( origin, directionX, directionY, range, &wallDistance))
+			{
+				distance = wallDistance;
+			}
+			for (const Robot::Pose& otherPose : otherPoses)
+			{
+				distance = std::min( distance, RayEntersBox( origin, directionX, directionY, otherPose));
+			}
+			distances.push_back( DistanceStimulus( beamAngles[beam], distance));
+		}
+		return std::shared_ptr< AbstractStimulus >( new DistanceScanStimulus( distances));
 	}
 	/**
 	 *
 	 */
 	std::shared_ptr< AbstractPercept > LaserDistanceSensor::getPerceptFor( std::shared_ptr< AbstractStimulus > anAbstractStimulus) const
 	{
-		DistanceStimulus* distanceStimulus = dynamic_cast< DistanceStimulus* >( anAbstractStimulus.get());
-		return std::shared_ptr< AbstractPercept >( new DistancePercept( distanceStimulus->angle,distanceStimulus->distance));
+		DistanceScanStimulus* distanceScanStimulus = dynamic_cast< DistanceScanStimulus* >( anAbstractStimulus.get());
+		return std::shared_ptr< AbstractPercept >( new DistanceScanPercept( *distanceScanStimulus));
 	}
 	/**
 	 *
@@ -66,7 +175,8 @@ namespace Model
 		/**
 	 *
 	 */
-	ProximitySensor::ProximitySensor()
+	ProximitySensor::ProximitySensor() :
+								_Robot(nullptr)
 	{
 	}
 	/**
@@ -113,22 +223,25 @@ namespace Model
 		return asString();
 	}
 
-	Region ProximitySensor::getRegion() const
-	{
-		Point translatedPoints[] = { getFrontRight(), getFrontLeft(), getBackLeft(), getBackRight() };
-		return Region( 4, translatedPoints);
-	}
 	/**
 	 *
 	 */
-
-	bool ProximitySensor::intersects( const Region& aRegion) const
+	bool ProximitySensor::intersects( const Point* aBox) const
 	{
-		Region region = getRegion();
-		region.Intersect( aRegion);
-		return !region.IsEmpty();
+		const Point corners[] = { getFrontRight(), getFrontLeft(), getBackLeft(), getBackRight() };
+		return Utils::Shape2DUtils::intersectBoxes( corners, aBox);
 	}
 	#pragma region getPoint
+	/**
+	 * The sensor is a rectangle in front of the Robot that turns with it, see Robot::getPose
+	 */
+	/* static */Point ProximitySensor::rotate(	const Robot::Pose& aPose,
+												const Point& aPosition,
+												const Point& aCorner)
+	{
+		return Point( (aCorner.x - aPosition.x) * aPose.cosine - (aCorner.y - aPosition.y) * aPose.sine + aPosition.x, (aCorner.y - aPosition.y) * aPose.cosine
+		+ (aCorner.x - aPosition.x) * aPose.sine + aPosition.y);
+	}
 	/**
 	 *
 	 */
@@ -138,13 +251,7 @@ namespace Model
 		int x = _Robot->position.x - (_Robot->size.x / 2);
 		int y = _Robot->position.y - (_Robot->size.y /2 );
 
-		Point originalFrontLeft( x - 0.3* _Robot->size.x, y - 1.5 * _Robot->size.y);
-		double angle = Utils::Shape2DUtils::getAngle( _Robot->front) + 0.5 * Utils::PI;
-
-		Point frontLeft( (originalFrontLeft.x - _Robot->position.x) * std::cos( angle) - (originalFrontLeft.y - _Robot->position.y) * std::sin( angle) + _Robot->position.x, (originalFrontLeft.y - _Robot->position.y) * std::cos( angle)
-		+ (originalFrontLeft.x - _Robot->position.x) * std::sin( angle) + _Robot->position.y);
-
-		return frontLeft;
+		return rotate( _Robot->getPose(), _Robot->position, Point( x - 0.3* _Robot->size.x, y - 1.5 * _Robot->size.y));
 	}
 	/**
 	 *
@@ -154,15 +261,8 @@ namespace Model
 		// x and y are pointing to top left now
 		int x = _Robot->position.x - (_Robot->size.x / 2);
 		int y = _Robot->position.y - (_Robot->size.y / 2);
-		
 
-		Point originalFrontRight( x + 1.3 * _Robot->size.x, y - 1.5 * _Robot->size.y);
-		double angle = Utils::Shape2DUtils::getAngle( _Robot->front) + 0.5 * Utils::PI;
-
-		Point frontRight( (originalFrontRight.x - _Robot->position.x) * std::cos( angle) - (originalFrontRight.y - _Robot->position.y) * std::sin( angle) + _Robot->position.x, (originalFrontRight.y - _Robot->position.y)
-						  * std::cos( angle) + (originalFrontRight.x - _Robot->position.x) * std::sin( angle) + _Robot->position.y);
-
-		return frontRight;
+		return rotate( _Robot->getPose(), _Robot->position, Point( x + 1.3 * _Robot->size.x, y - 1.5 * _Robot->size.y));
 	}
 	/**
 	 *
@@ -173,15 +273,7 @@ namespace Model
 		int x = _Robot->position.x - (_Robot->size.x / 2);
 		int y = _Robot->position.y - (_Robot->size.y / 2);
 
-		Point originalBackLeft( x - 0.3* _Robot->size.x, y);
-
-		double angle = Utils::Shape2DUtils::getAngle( _Robot->front) + 0.5 * Utils::PI;
-
-		Point backLeft( (originalBackLeft.x - _Robot->position.x) * std::cos( angle) - (originalBackLeft.y - _Robot->position.y) * std::sin( angle) + _Robot->position.x, (originalBackLeft.y - _Robot->position.y) * std::cos( angle)
-		+ (originalBackLeft.x - _Robot->position.x) * std::sin( angle) + _Robot->position.y);
-
-		return backLeft;
-
+		return rotate( _Robot->getPose(), _Robot->position, Point( x - 0.3* _Robot->size.x, y));
 	}
 	/**
 	 *
@@ -192,14 +284,7 @@ namespace Model
 		int x = _Robot->position.x - (_Robot->size.x / 2);
 		int y = _Robot->position.y - (_Robot->size.y / 2);
 
-		Point originalBackRight( x + 1.3 * _Robot->size.x + _Robot->size.x, y );
-
-		double angle = Utils::Shape2DUtils::getAngle( _Robot->front) + 0.5 * Utils::PI;
-
-		Point backRight( (originalBackRight.x - _Robot->position.x) * std::cos( angle) - (originalBackRight.y - _Robot->position.y) * std::sin( angle) + _Robot->position.x, (originalBackRight.y - _Robot->position.y) * std::cos( angle)
-		+ (originalBackRight.x - _Robot->position.x) * std::sin( angle) + _Robot->position.y);
-
-		return backRight;
+		return rotate( _Robot->getPose(), _Robot->position, Point( x + 1.3 * _Robot->size.x + _Robot->size.x, y ));
 	}
 	#pragma endregion
 
@@ -211,16 +296,21 @@ namespace Model
 		Point backRight = getBackRight();
 
 
-		const std::vector<RobotPtr>& robots = RobotWorld::getRobotWorld().getRobots();
-		for(RobotPtr otherRobot :  robots)
+		// Only the Robots near the sensor can touch it
+		const Point topLeft( std::min( { frontLeft.x, frontRight.x, backLeft.x, backRight.x }), std::min( { frontLeft.y, frontRight.y, backLeft.y, backRight.y }));
+		const Point bottomRight( std::max( { frontLeft.x, frontRight.x, backLeft.x, backRight.x }), std::max( { frontLeft.y, frontRight.y, backLeft.y, backRight.y }));
+		std::vector< Robot* > robots;
+		RobotWorld::getRobotWorld().getCollisionGrid().findRobots( topLeft, bottomRight, robots);
+		for(Robot* otherRobot :  robots)
 		{
 			if(otherRobot != _Robot)			{
-			if (Utils::Shape2DUtils::intersect( frontLeft, backRight, otherRobot->getFrontLeft(), otherRobot->getFrontRight()) ||
-				Utils::Shape2DUtils::intersect( backLeft, frontRight, otherRobot->getBackLeft(), otherRobot->getBackRight()) ||
-				Utils::Shape2DUtils::intersect( frontLeft, frontRight, otherRobot->getFrontLeft(), otherRobot->getFrontRight()) ||
-				Utils::Shape2DUtils::intersect( backLeft, backRight, otherRobot->getBackLeft(), otherRobot->getBackRight()) ||
-				Utils::Shape2DUtils::intersect( frontLeft, backLeft, otherRobot->getFrontLeft(), otherRobot->getBackRight()) ||
-				Utils::Shape2DUtils::intersect( frontRight, backRight, otherRobot->getFrontRight(), otherRobot->getBackRight()))
+			const Robot::Pose otherPose = otherRobot->getPose();
+			if (Utils::Shape2DUtils::intersect( frontLeft, backRight, otherPose.frontLeft, otherPose.frontRight) ||
+				Utils::Shape2DUtils::intersect( backLeft, frontRight, otherPose.backLeft, otherPose.backRight) ||
+				Utils::Shape2DUtils::intersect( frontLeft, frontRight, otherPose.frontLeft, otherPose.frontRight) ||
+				Utils::Shape2DUtils::intersect( backLeft, backRight, otherPose.backLeft, otherPose.backRight) ||
+				Utils::Shape2DUtils::intersect( frontLeft, backLeft, otherPose.frontLeft, otherPose.backRight) ||
+				Utils::Shape2DUtils::intersect( frontRight, backRight, otherPose.frontRight, otherPose.backRight))
 			{
 				return true;
 			}
@@ -10,10 +10,12 @@
 
 #include "Config.hpp"
 
+#include <vector>
+
 #include "AbstractSensor.hpp"
 #include "MathUtils.hpp"
 #include "Shape2DUtils.hpp"
-#include "Region.hpp"
+#include "Robot.hpp"
 #include "RobotWorld.hpp"
 
 
@@ -58,24 +60,70 @@ namespace Model
 	};
 	//	class DistancePercept
 
+	/**
+	 * A full scan of a LaserDistanceSensor, one DistanceStimulus per beam
+	 */
+	class DistanceScanStimulus : public AbstractStimulus
+	{
+		public:
+			DistanceScanStimulus( const std::vector< DistanceStimulus >& someDistances) :
+				distances( someDistances)
+		{
+		}
+		std::vector< DistanceStimulus > distances;
+	};
+	// class DistanceScanStimulus
+
+	/**
+	 *
+	 */
+	class DistanceScanPercept : public AbstractPercept
+	{
+		public:
+			DistanceScanPercept( const DistanceScanStimulus& aDistanceScanStimulus) :
+				distances( aDistanceScanStimulus.distances.begin(), aDistanceScanStimulus.distances.end())
+		{
+		}
+		std::vector< DistancePercept > distances;
+	};
+	// class DistanceScanPercept
 
 	class Robot;
 	typedef std::shared_ptr<Robot> RobotPtr;
 
 	/**
+	 * A lidar on top of a Robot: a number of beams from the position of the Robot, spread evenly
+	 * over a field of view that is centred on the front of the Robot. Every stimulus is a full
+	 * DistanceScanStimulus.
 	 *
+	 * A beam stops at the first Wall, found through the WallTree of the RobotWorld, or at the first
+	 * oriented bounding box of another Robot within the range, found through the CollisionGrid. The
+	 * angle of a beam is relative to the front of the Robot, in radians, and a beam that hits nothing
+	 * has the range as its distance.
 	 */
 	class LaserDistanceSensor : public AbstractSensor
 	{
 		public:
+			/**
+			 * One beam per degree
+			 */
+			static const unsigned short DefaultNumberOfBeams = 360;
+			/**
+			 * About the size of the RobotWorld
+			 */
+			static const int DefaultRange = 1024;
 			/**
 			 *
 			 */
 			LaserDistanceSensor();
 			/**
-			 *
+			 * A field of view of a full turn or more has no beam at its end, that beam would be the
+			 * same as the first one
 			 */
-			LaserDistanceSensor( Robot* aRobot);
+			LaserDistanceSensor(	Robot* aRobot,
+									unsigned short aNumberOfBeams = DefaultNumberOfBeams,
+									double aFieldOfView = 2 * Utils::PI,
+									double aRange = DefaultRange);
 			/**
 			 *
 			 */
@@ -88,6 +136,20 @@ namespace Model
 			 *
 			 */
 			virtual std::shared_ptr< AbstractPercept > getPerceptFor( std::shared_ptr< AbstractStimulus > anAbstractStimulus) const;
+			/**
+			 *
+			 */
+			unsigned short getNumberOfBeams() const
+			{
+				return static_cast< unsigned short >( beamAngles.size());
+			}
+			/**
+			 *
+			 */
+			double getRange() const
+			{
+				return range;
+			}
 			/**
 			 * @name Debug functions
 			 */
@@ -103,6 +165,15 @@ namespace Model
 			//@}
 		protected:
 		private:
+			Robot* robot;
+			double range;
+			/**
+			 * The angles of the beams and their cosines and sines, computed once so that a scan only
+			 * has to turn them by the heading of the Robot
+			 */
+			std::vector< double > beamAngles;
+			std::vector< double > beamCosines;
+			std::vector< double > beamSines;
 	};
 
 
@@ -173,11 +244,24 @@ namespace Model
 			//@}
 		protected:
 		private:
-			RobotPtr _Robot;
-
-			Region getRegion() const;
+			/**
+			 * The Robot owns the sensor, the sensor does not own the Robot
+			 */
+			Robot* _Robot;
 
-			bool intersects( const Region& aRegion) const;
+			/**
+			 *
+			 * @param aBox The 4 corners of a box, in clockwise or counter-clockwise order
+			 * @return True if the box overlaps the area of the sensor
+			 */
+			bool intersects( const Point* aBox) const;
+			/**
+			 *
+			 * @return aCorner rotated around aPosition like the corners of aPose
+			 */
+			static Point rotate(	const Robot::Pose& aPose,
+									const Point& aPosition,
+									const Point& aCorner);
 			/**
 			 *
 			 */
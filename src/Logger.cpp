@@ -1,20 +1,18 @@
 #include "Logger.hpp"
-#include "MainApplication.hpp"
-#include "MainFrameWindow.hpp"
 #include "DebugTraceFunction.hpp"
 
 namespace Application
 {
 	/* static */bool Logger::disable = false;
+	/* static */Base::DebugTraceFunction* Logger::traceFunction = nullptr;
 	/**
 	 *
 	 */
 	/*static*/void Logger::log( const std::string& aMessage)
 	{
-		Application::MainFrameWindow* frame = dynamic_cast< Application::MainFrameWindow* >( Application::TheApp().GetTopWindow());
-		if (frame && !disable)
+		if (traceFunction && !disable)
 		{
-			frame->getTraceFunction().trace( aMessage);
+			traceFunction->trace( aMessage);
 		}
 	}
 	/**
@@ -24,4 +22,11 @@ namespace Application
 	{
 		disable = aDisable;
 	}
+	/**
+	 *
+	 */
+	/* static */void Logger::setTraceFunction( Base::DebugTraceFunction* aTraceFunction)
+	{
+		traceFunction = aTraceFunction;
+	}
 } //namespace Application
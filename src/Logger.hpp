@@ -5,6 +5,11 @@
 
 #include <string>
 
+namespace Base
+{
+	class DebugTraceFunction;
+} // namespace Base
+
 namespace Application
 {
 	/**
@@ -26,6 +31,13 @@ namespace Application
 			 * @param aDisable, by default true
 			 */
 			static void setDisable( bool aDisable = true);
+			/**
+			 * Sets the DebugTraceFunction the messages are traced to, nothing is traced without one.
+			 * The caller keeps ownership and must reset it before aTraceFunction is deleted.
+			 *
+			 * @param aTraceFunction The DebugTraceFunction or nullptr
+			 */
+			static void setTraceFunction( Base::DebugTraceFunction* aTraceFunction);
 			/**
 			 *
 			 * @return true if enabled, false otherwise
@@ -39,6 +51,7 @@ namespace Application
 			 */
 		private:
 			static bool disable;
+			static Base::DebugTraceFunction* traceFunction;
 	};
 } // namespace Application
 #endif /* LOGGER_HPP_ */
@@ -53,6 +53,7 @@ namespace Application
 	 */
 	MainFrameWindow::~MainFrameWindow()
 	{
+		Logger::setTraceFunction( nullptr);
 		if (debugTraceFunction)
 		{
 			delete debugTraceFunction;
@@ -105,6 +106,7 @@ namespace Application
 		// By default we initialise the WidgetDebugTraceFunction
 		// as we expect that this is what the user wants....
 		debugTraceFunction = new Application::WidgetDebugTraceFunction( logTextCtrl);
+		Logger::setTraceFunction( debugTraceFunction);
 	}
 	/**
 	 *
@@ -355,18 +357,22 @@ namespace Application
 	 */
 	void MainFrameWindow::OnWidgetDebugTraceFunction( CommandEvent& UNUSEDPARAM(anEvent))
 	{
+		Logger::setTraceFunction( nullptr);
 		if (debugTraceFunction)
 			delete debugTraceFunction;
 		debugTraceFunction = new WidgetDebugTraceFunction( logTextCtrl);
+		Logger::setTraceFunction( debugTraceFunction);
 	}
 	/**
 	 *
 	 */
 	void MainFrameWindow::OnStdOutDebugTraceFunction( CommandEvent& UNUSEDPARAM(anEvent))
 	{
+		Logger::setTraceFunction( nullptr);
 		if (debugTraceFunction)
 			delete debugTraceFunction;
 		debugTraceFunction = new Base::StdOutDebugTraceFunction();
+		Logger::setTraceFunction( debugTraceFunction);
 
 	}
 
@@ -399,13 +405,13 @@ namespace Application
 			std::string remoteIpAdres = "localhost";
 			std::string remotePort = "12345";
 
-			if (MainApplication::isArgGiven( "-remote_ip"))
+			if (Commandline::isArgGiven( "-remote_ip"))
 			{
-				remoteIpAdres = MainApplication::getArg( "-remote_ip").value;
+				remoteIpAdres = Commandline::getArg( "-remote_ip").value;
 			}
-			if (MainApplication::isArgGiven( "-remote_port"))
+			if (Commandline::isArgGiven( "-remote_port"))
 			{
-				remotePort = MainApplication::getArg( "-remote_port").value;
+				remotePort = Commandline::getArg( "-remote_port").value;
 			}
 
 			// We will request an echo message. The response will be "Hello World", if all goes OK,
@@ -512,13 +518,13 @@ namespace Application
 			std::string remoteIpAdres = "localhost";
 			std::string remotePort = "12345";
 
-			if (MainApplication::isArgGiven( "-remote_ip"))
+			if (Commandline::isArgGiven( "-remote_ip"))
 			{
-				remoteIpAdres = MainApplication::getArg( "-remote_ip").value;
+				remoteIpAdres = Commandline::getArg( "-remote_ip").value;
 			}
-			if (MainApplication::isArgGiven( "-remote_port"))
+			if (Commandline::isArgGiven( "-remote_port"))
 			{
-				remotePort = MainApplication::getArg( "-remote_port").value;
+				remotePort = Commandline::getArg( "-remote_port").value;
 			}
 
 			// We will request an echo message. The response will be "Hello World", if all goes OK,
@@ -541,13 +547,13 @@ namespace Application
 			std::string remoteIpAdres = "localhost";
 			std::string remotePort = "12345";
 
-			if (MainApplication::isArgGiven( "-remote_ip"))
+			if (Commandline::isArgGiven( "-remote_ip"))
 			{
-				remoteIpAdres = MainApplication::getArg( "-remote_ip").value;
+				remoteIpAdres = Commandline::getArg( "-remote_ip").value;
 			}
-			if (MainApplication::isArgGiven( "-remote_port"))
+			if (Commandline::isArgGiven( "-remote_port"))
 			{
-				remotePort = MainApplication::getArg( "-remote_port").value;
+				remotePort = Commandline::getArg( "-remote_port").value;
 			}
 
 			// We will request an echo message. The response will be "Hello World", if all goes OK,
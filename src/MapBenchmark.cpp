@@ -0,0 +1,225 @@
+#include "MapBenchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+
+#include "AStar.hpp"
+#include "JumpPointSearch.hpp"
+
+namespace Application
+{
+	/* static */std::atomic< unsigned long > MapBenchmark::numberOfAllocations( 0);
+	/**
+	 * A planner as it is measured: a search on a filled grid and the counter of its expansions
+	 */
+	struct MeasuredPlanner
+	{
+			std::string name;
+			std::function< void(	const PathAlgorithm::Map&,
+									const PathAlgorithm::OccupancyGrid&,
+									PathAlgorithm::Path&) > search;
+			const PathAlgorithm::SearchProgress& progress;
+	};
+	/**
+	 * Escapes aString for a JSON string or a CSV field, the names of the maps never need more
+	 */
+	static std::string Quote( const std::string& aString)
+	{
+		std::string quoted( "\"");
+		for (char c : aString)
+		{
+			if (c == '"' || c == '\\')
+			{
+				quoted += '\\';
+			}
+			quoted += c;
+		}
+		return quoted + "\"";
+	}
+	/**
+	 *
+	 */
+	/* static */std::vector< PathAlgorithm::Map > MapBenchmark::getMaps(	unsigned long aSeed,
+																			const Size& aWorldSize)
+	{
+		std::vector< PathAlgorithm::Map > maps;
+		for (unsigned long situation = 1; situation <= 6; ++situation)
+		{
+			maps.push_back( PathAlgorithm::MapGenerator::situation( situation));
+		}
+		maps.push_back( PathAlgorithm::MapGenerator::randomWalls( aSeed, aWorldSize, 10));
+		maps.push_back( PathAlgorithm::MapGenerator::randomWalls( aSeed + 1, aWorldSize, 20));
+		maps.push_back( PathAlgorithm::MapGenerator::randomWalls( aSeed + 2, aWorldSize, 30));
+		maps.push_back( PathAlgorithm::MapGenerator::maze( aSeed, aWorldSize));
+		maps.push_back( PathAlgorithm::MapGenerator::corridors( aSeed, aWorldSize));
+		return maps;
+	}
+	/**
+	 *
+	 */
+	/* static */std::vector< MapBenchmark::Result > MapBenchmark::run(	const std::vector< PathAlgorithm::Map >& someMaps,
+																			const Size& aRobotSize,
+																			unsigned long aNumberOfRuns /*= 10*/)
+	{
+		PathAlgorithm::AStar astar;
+		PathAlgorithm::AStar bidirectional;
+		PathAlgorithm::JumpPointSearch jumpPointSearch;
+
+		std::vector< MeasuredPlanner > planners = {	MeasuredPlanner{	"astar",
+														[&astar]( const PathAlgorithm::Map& aMap, const PathAlgorithm::OccupancyGrid& aGrid, PathAlgorithm::Path& aPath)
+														{
+															astar.search( PathAlgorithm::Vertex( aMap.start), PathAlgorithm::Vertex( aMap.goal), aGrid, aPath);
+														},
+														astar.getProgress()},
+											MeasuredPlanner{	"bidirectional",
+														[&bidirectional]( const PathAlgorithm::Map& aMap, const PathAlgorithm::OccupancyGrid& aGrid, PathAlgorithm::Path& aPath)
+														{
+															bidirectional.searchBidirectional( PathAlgorithm::Vertex( aMap.start), PathAlgorithm::Vertex( aMap.goal), aGrid, aPath);
+														},
+														bidirectional.getProgress()},
+											MeasuredPlanner{	"jps",
+														[&jumpPointSearch]( const PathAlgorithm::Map& aMap, const PathAlgorithm::OccupancyGrid& aGrid, PathAlgorithm::Path& aPath)
+														{
+															aPath = jumpPointSearch.search( PathAlgorithm::Vertex( aMap.start), PathAlgorithm::Vertex( aMap.goal), aGrid);
+														},
+														jumpPointSearch.getProgress()}};
+
+		const unsigned long numberOfRuns = std::max( 1UL, aNumberOfRuns);
+
+		std::vector< Result > results;
+		PathAlgorithm::OccupancyGrid grid;
+		PathAlgorithm::Path path;
+		for (const PathAlgorithm::Map& map : someMaps)
+		{
+			PathAlgorithm::MapGenerator::fillOccupancyGrid( map, PathAlgorithm::AStar::freeRadius( aRobotSize), grid);
+
+			for (MeasuredPlanner& planner : planners)
+			{
+				planner.search( map, grid, path);
+				// Measuring a search that fails tells nothing about the planner
+				if (path.empty())
+				{
+					throw std::runtime_error( "MapBenchmark::run: " + planner.name + " found no route on " + map.name);
+				}
+
+				double totalMicroseconds = 0.0;
+				double minimumMicroseconds = std::numeric_limits< double >::max();
+				const unsigned long allocationsBefore = numberOfAllocations.load( std::memory_order_relaxed);
+				for (unsigned long run = 0; run < numberOfRuns; ++run)
+				{
+					std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+					planner.search( map, grid, path);
+					std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+					double microseconds = std::chrono::duration< double, std::micro >( end - begin).count();
+					totalMicroseconds += microseconds;
+					minimumMicroseconds = std::min( minimumMicroseconds, microseconds);
+				}
+				const unsigned long allocations = numberOfAllocations.load( std::memory_order_relaxed) - allocationsBefore;
+
+				results.push_back( Result{	map.name,
+											planner.name,
+											planner.progress.getNumberOfExpansions(),
+											totalMicroseconds / static_cast< double >( numberOfRuns),
+											minimumMicroseconds,
+											static_cast< double >( allocations) / static_cast< double >( numberOfRuns),
+											path.size(),
+											path.empty() ? 0.0 : path.back().actualCost});
+			}
+		}
+		return results;
+	}
+	/**
+	 *
+	 */
+	/* static */void MapBenchmark::write(	std::ostream& os,
+											const std::vector< Result >& someResults,
+											Format aFormat)
+	{
+		switch (aFormat)
+		{
+			case Format::Text:
+			{
+				std::string map;
+				for (const Result& result : someResults)
+				{
+					if (result.map != map)
+					{
+						map = result.map;
+						os << map << std::endl;
+					}
+					os << "  " << result.planner
+					   << ": path length " << result.pathLength
+					   << ", cost " << std::fixed << std::setprecision( 3) << result.pathCost
+					   << ", expansions " << result.expansions
+					   << ", " << std::setprecision( 1) << result.meanMicroseconds << " us/search"
+					   << " (minimum " << result.minimumMicroseconds << ")"
+					   << ", " << result.allocations << " allocations/search"
+					   << std::defaultfloat << std::endl;
+				}
+				break;
+			}
+			case Format::Csv:
+			{
+				os << "map,planner,expansions,mean_us,minimum_us,allocations,path_length,path_cost" << std::endl;
+				for (const Result& result : someResults)
+				{
+					os << Quote( result.map) << ","
+					   << Quote( result.planner) << ","
+					   << result.expansions << ","
+					   << std::fixed << std::setprecision( 3) << result.meanMicroseconds << ","
+					   << result.minimumMicroseconds << ","
+					   << result.allocations << ","
+					   << result.pathLength << ","
+					   << result.pathCost
+					   << std::defaultfloat << std::endl;
+				}
+				break;
+			}
+			case Format::Json:
+			{
+				os << "[" << std::endl;
+				for (std::size_t i = 0; i < someResults.size(); ++i)
+				{
+					const Result& result = someResults[i];
+					os << "  {\"map\": " << Quote( result.map)
+					   << ", \"planner\": " << Quote( result.planner)
+					   << ", \"expansions\": " << result.expansions
+					   << std::fixed << std::setprecision( 3)
+					   << ", \"mean_us\": " << result.meanMicroseconds
+					   << ", \"minimum_us\": " << result.minimumMicroseconds
+					   << ", \"allocations\": " << result.allocations
+					   << ", \"path_length\": " << result.pathLength
+					   << ", \"path_cost\": " << result.pathCost
+					   << std::defaultfloat
+					   << "}" << (i + 1 < someResults.size() ? "," : "") << std::endl;
+				}
+				os << "]" << std::endl;
+				break;
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	/* static */MapBenchmark::Format MapBenchmark::asFormat( const std::string& aName)
+	{
+		if (aName == "text")
+		{
+			return Format::Text;
+		}
+		if (aName == "csv")
+		{
+			return Format::Csv;
+		}
+		if (aName == "json")
+		{
+			return Format::Json;
+		}
+		throw std::invalid_argument( "MapBenchmark::asFormat: unknown format " + aName);
+	}
+} // namespace Application
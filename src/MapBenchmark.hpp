@@ -0,0 +1,96 @@
+#ifndef MAPBENCHMARK_HPP_
+#define MAPBENCHMARK_HPP_
+
+#include "Config.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "MapGenerator.hpp"
+#include "Size.hpp"
+
+namespace Application
+{
+	/**
+	 * Measures the planners on generated maps, see the robotworld_benchmark program.
+	 *
+	 * Every planner searches every map a number of times with the same grid. The first search is
+	 * not measured so that the planner has allocated its buffers, the results are those of a
+	 * planner that is replanning.
+	 */
+	class MapBenchmark
+	{
+		public:
+			/**
+			 *
+			 */
+			enum class Format
+			{
+				Text,
+				Csv,
+				Json
+			};
+			/**
+			 * The measurement of one planner on one map
+			 */
+			struct Result
+			{
+					std::string map;
+					std::string planner;
+					/**
+					 * The Vertices that were taken from the openSet in one search
+					 */
+					std::size_t expansions;
+					double meanMicroseconds;
+					double minimumMicroseconds;
+					/**
+					 * The calls of operator new per search, only counted if the program counts them
+					 */
+					double allocations;
+					/**
+					 * The number of Vertices of the route, 0 if there is no route
+					 */
+					std::size_t pathLength;
+					double pathCost;
+			};
+			/**
+			 * The six built-in situations of the RobotWorld and a number of random maps, mazes and
+			 * corridors in a world of aWorldSize that are generated with aSeed
+			 */
+			static std::vector< PathAlgorithm::Map > getMaps(	unsigned long aSeed,
+																const Size& aWorldSize);
+			/**
+			 * Runs every planner aNumberOfRuns times on each of someMaps for a robot of aRobotSize
+			 *
+			 * @throw std::runtime_error If a planner finds no route on one of the maps
+			 */
+			static std::vector< Result > run(	const std::vector< PathAlgorithm::Map >& someMaps,
+												const Size& aRobotSize,
+												unsigned long aNumberOfRuns = 10);
+			/**
+			 * Writes someResults as a table (Text) or in a machine-readable form (Csv, Json)
+			 */
+			static void write(	std::ostream& os,
+								const std::vector< Result >& someResults,
+								Format aFormat);
+			/**
+			 *
+			 * @return The Format with aName ("text", "csv" or "json")
+			 */
+			static Format asFormat( const std::string& aName);
+			/**
+			 * Counts an allocation, a program that wants the allocations in the results calls this from its operator new
+			 */
+			static void countAllocation()
+			{
+				numberOfAllocations.fetch_add( 1, std::memory_order_relaxed);
+			}
+
+		private:
+			static std::atomic< unsigned long > numberOfAllocations;
+	}; // class MapBenchmark
+} // namespace Application
+#endif // MAPBENCHMARK_HPP_
@@ -0,0 +1,290 @@
+#include "MapGenerator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+#include "AStar.hpp"
+#include "Goal.hpp"
+#include "Robot.hpp"
+#include "RobotWorld.hpp"
+#include "Shape2DUtils.hpp"
+#include "Wall.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 * The distance a wall keeps from the start and the goal
+	 */
+	static const int Clearance = MapGenerator::MaximumFreeRadius + 3;
+	/**
+	 * The number of times randomWalls generates the walls before it gives up on a route
+	 */
+	static const unsigned long MaximumAttempts = 100;
+	/**
+	 *
+	 */
+	/* static */Map MapGenerator::randomWalls(	unsigned long aSeed,
+												const Size& aWorldSize,
+												unsigned long aNumberOfWalls)
+	{
+		Map map;
+		map.name = "random-" + std::to_string( aNumberOfWalls) + "-" + std::to_string( aSeed);
+		map.worldSize = aWorldSize;
+		map.start = Point( 40, 40);
+		map.goal = Point( aWorldSize.x - 40, aWorldSize.y - 40);
+
+		// std::mt19937 gives the same sequence on every platform, the distributions are done by hand for the same reason
+		std::mt19937 generator( static_cast< std::mt19937::result_type >( aSeed));
+		auto random = [&generator]( int aMinimum, int aMaximum)
+		{
+			return aMinimum + static_cast< int >( generator() % static_cast< unsigned long >( aMaximum - aMinimum + 1));
+		};
+
+		// The walls can close off the start or the goal, then the next walls of the generator are tried
+		const double pi = std::acos( -1.0);
+		OccupancyGrid grid;
+		AStar astar;
+		Path path;
+		for (unsigned long attempt = 0; attempt < MaximumAttempts; ++attempt)
+		{
+			map.walls.clear();
+			while (map.walls.size() < aNumberOfWalls)
+			{
+				Point point1( random( 0, aWorldSize.x), random( 0, aWorldSize.y));
+				double angle = random( 0, 359) * pi / 180.0;
+				int length = random( 20, 100);
+				Point point2( std::max( 0, std::min( aWorldSize.x, point1.x + static_cast< int >( std::round( length * std::cos( angle))))),
+							  std::max( 0, std::min( aWorldSize.y, point1.y + static_cast< int >( std::round( length * std::sin( angle))))));
+
+				if (point1 == point2 ||
+					Utils::Shape2DUtils::isOnLine( point1, point2, map.start, Clearance) ||
+					Utils::Shape2DUtils::isOnLine( point1, point2, map.goal, Clearance))
+				{
+					continue;
+				}
+				map.walls.push_back( std::make_pair( point1, point2));
+			}
+
+			fillOccupancyGrid( map, MaximumFreeRadius, grid);
+			if (astar.search( Vertex( map.start), Vertex( map.goal), grid, path))
+			{
+				return map;
+			}
+		}
+		throw std::runtime_error( "MapGenerator::randomWalls: no map of " + map.name + " has a route after " + std::to_string( MaximumAttempts) + " attempts");
+	}
+	/**
+	 * The cells are numbered row by row, a wall is left between two neighbouring cells unless the
+	 * depth-first search went from one to the other
+	 */
+	/* static */Map MapGenerator::maze(	unsigned long aSeed,
+										const Size& aWorldSize,
+										int aCellSize /*= 64*/)
+	{
+		const int columns = aWorldSize.x / aCellSize;
+		const int rows = aWorldSize.y / aCellSize;
+		if (columns < 1 || rows < 1)
+		{
+			throw std::invalid_argument( "MapGenerator::maze: the cells do not fit in the world");
+		}
+
+		Map map;
+		map.name = "maze-" + std::to_string( aCellSize) + "-" + std::to_string( aSeed);
+		map.worldSize = aWorldSize;
+		map.start = Point( aCellSize / 2, aCellSize / 2);
+		map.goal = Point( (columns - 1) * aCellSize + aCellSize / 2, (rows - 1) * aCellSize + aCellSize / 2);
+
+		std::mt19937 generator( static_cast< std::mt19937::result_type >( aSeed));
+
+		// openRight[c] and openDown[c] are the passages from cell c to its right and lower neighbour
+		std::vector< bool > openRight( columns * rows, false);
+		std::vector< bool > openDown( columns * rows, false);
+		std::vector< bool > visited( columns * rows, false);
+
+		std::vector< int > stack( 1, 0);
+		visited[0] = true;
+		while (!stack.empty())
+		{
+			const int cell = stack.back();
+			const int column = cell % columns;
+			const int row = cell / columns;
+
+			int neighbours[4];
+			int numberOfNeighbours = 0;
+			if (column > 0 && !visited[cell - 1])
+			{
+				neighbours[numberOfNeighbours++] = cell - 1;
+			}
+			if (column < columns - 1 && !visited[cell + 1])
+			{
+				neighbours[numberOfNeighbours++] = cell + 1;
+			}
+			if (row > 0 && !visited[cell - columns])
+			{
+				neighbours[numberOfNeighbours++] = cell - columns;
+			}
+			if (row < rows - 1 && !visited[cell + columns])
+			{
+				neighbours[numberOfNeighbours++] = cell + columns;
+			}
+
+			if (numberOfNeighbours == 0)
+			{
+				stack.pop_back();
+				continue;
+			}
+
+			const int next = neighbours[generator() % static_cast< unsigned long >( numberOfNeighbours)];
+			if (next == cell - 1)
+			{
+				openRight[next] = true;
+			} else if (next == cell + 1)
+			{
+				openRight[cell] = true;
+			} else if (next == cell - columns)
+			{
+				openDown[next] = true;
+			} else
+			{
+				openDown[cell] = true;
+			}
+			visited[next] = true;
+			stack.push_back( next);
+		}
+
+		for (int row = 0; row < rows; ++row)
+		{
+			for (int column = 0; column < columns; ++column)
+			{
+				const int cell = row * columns + column;
+				const int left = column * aCellSize;
+				const int top = row * aCellSize;
+				// The right and lower side of the last column and row are walls too if they are not the border of the world
+				if (!openRight[cell] && (column < columns - 1 || left + aCellSize < aWorldSize.x))
+				{
+					map.walls.push_back( std::make_pair( Point( left + aCellSize, top), Point( left + aCellSize, top + aCellSize)));
+				}
+				if (!openDown[cell] && (row < rows - 1 || top + aCellSize < aWorldSize.y))
+				{
+					map.walls.push_back( std::make_pair( Point( left, top + aCellSize), Point( left + aCellSize, top + aCellSize)));
+				}
+			}
+		}
+		return map;
+	}
+	/**
+	 *
+	 */
+	/* static */Map MapGenerator::corridors(	unsigned long aSeed,
+												const Size& aWorldSize,
+												int aCorridorWidth /*= 80*/)
+	{
+		const int numberOfWalls = aWorldSize.y / aCorridorWidth - 1;
+		if (numberOfWalls < 1 || aWorldSize.x < aCorridorWidth)
+		{
+			throw std::invalid_argument( "MapGenerator::corridors: the corridors do not fit in the world");
+		}
+
+		Map map;
+		map.name = "corridors-" + std::to_string( aCorridorWidth) + "-" + std::to_string( aSeed);
+		map.worldSize = aWorldSize;
+		map.start = Point( 40, aCorridorWidth / 2);
+		map.goal = Point( aWorldSize.x - 40, (numberOfWalls * aCorridorWidth + aWorldSize.y) / 2);
+
+		std::mt19937 generator( static_cast< std::mt19937::result_type >( aSeed));
+
+		// The openings are as wide as the corridors
+		for (int i = 1; i <= numberOfWalls; ++i)
+		{
+			const int y = i * aCorridorWidth;
+			const int opening = static_cast< int >( generator() % static_cast< unsigned long >( aWorldSize.x - aCorridorWidth + 1));
+			if (opening > 0)
+			{
+				map.walls.push_back( std::make_pair( Point( 0, y), Point( opening, y)));
+			}
+			if (opening + aCorridorWidth < aWorldSize.x)
+			{
+				map.walls.push_back( std::make_pair( Point( opening + aCorridorWidth, y), Point( aWorldSize.x, y)));
+			}
+		}
+		return map;
+	}
+	/**
+	 *
+	 */
+	/* static */Map MapGenerator::situation(	unsigned long aSituation,
+												bool anOther /*= false*/)
+	{
+		Model::RobotWorld& robotWorld = Model::RobotWorld::getRobotWorld();
+		switch (aSituation)
+		{
+			case 1:
+			{
+				robotWorld.situationOne( anOther);
+				break;
+			}
+			case 2:
+			{
+				robotWorld.situationTwo( anOther);
+				break;
+			}
+			case 3:
+			{
+				robotWorld.situationThree( anOther);
+				break;
+			}
+			case 4:
+			{
+				robotWorld.situationFour( anOther);
+				break;
+			}
+			case 5:
+			{
+				robotWorld.situationFive( anOther);
+				break;
+			}
+			case 6:
+			{
+				robotWorld.situationSix( anOther);
+				break;
+			}
+			default:
+			{
+				throw std::invalid_argument( "MapGenerator::situation: there is no situation " + std::to_string( aSituation));
+			}
+		}
+
+		Map map;
+		map.name = "situation-" + std::to_string( aSituation) + (anOther ? "-other" : "");
+		map.worldSize = robotWorld.getWorldSize();
+		for (Model::WallPtr wall : robotWorld.getWalls())
+		{
+			map.walls.push_back( std::make_pair( wall->getPoint1(), wall->getPoint2()));
+		}
+		map.start = robotWorld.getRobot( "Robot")->getPosition();
+		map.goal = robotWorld.getGoal( "Goal")->getPosition();
+		return map;
+	}
+	/**
+	 *
+	 */
+	/* static */void MapGenerator::fillOccupancyGrid(	const Map& aMap,
+														int aFreeRadius,
+														OccupancyGrid& aGrid)
+	{
+		const Size& worldSize = aMap.worldSize;
+
+		aGrid.reset( worldSize.x + 1, worldSize.y + 1);
+		for (const std::pair< Point, Point >& wall : aMap.walls)
+		{
+			aGrid.addLine( OccupancyGrid::Line{ wall.first, wall.second, aFreeRadius + 2 });
+		}
+
+		aGrid.addLine( OccupancyGrid::Line{ Point( 0, 0), Point( worldSize.x, 0), 2 });
+		aGrid.addLine( OccupancyGrid::Line{ Point( 0, 0), Point( 0, worldSize.y), 2 });
+		aGrid.addLine( OccupancyGrid::Line{ Point( worldSize.x, worldSize.y), Point( worldSize.x, 0), 2 });
+		aGrid.addLine( OccupancyGrid::Line{ Point( worldSize.x, worldSize.y), Point( 0, worldSize.y), 2 });
+	}
+} // namespace PathAlgorithm
@@ -0,0 +1,82 @@
+#ifndef MAPGENERATOR_HPP_
+#define MAPGENERATOR_HPP_
+
+#include "Config.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "OccupancyGrid.hpp"
+#include "Point.hpp"
+#include "Size.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 * The walls of a world and a start and a goal in it, to benchmark the planners without a RobotWorld.
+	 */
+	struct Map
+	{
+			std::string name;
+			Size worldSize;
+			std::vector< std::pair< Point, Point > > walls;
+			Point start;
+			Point goal;
+	};
+	/**
+	 * Generates reproducible maps: the same arguments always give the same walls, start and goal.
+	 *
+	 * The generated maps keep a clearance around the start and the goal and between the walls that is
+	 * wide enough for a robot with a free radius up to MaximumFreeRadius, and they always have a route
+	 * from the start to the goal for such a robot.
+	 */
+	class MapGenerator
+	{
+		public:
+			/**
+			 * The largest free radius the generated maps leave room for, the free radius of a robot with the default title is 24
+			 */
+			static const int MaximumFreeRadius = 28;
+			/**
+			 * Walls of random length and direction at random positions. Walls that close off the goal
+			 * are generated again with the same generator, so the same arguments still give the same map.
+			 *
+			 * @throw std::runtime_error If no walls with a route were generated after a number of attempts
+			 */
+			static Map randomWalls(	unsigned long aSeed,
+									const Size& aWorldSize,
+									unsigned long aNumberOfWalls);
+			/**
+			 * A perfect maze (exactly one route between every two cells) carved with a randomised
+			 * depth-first search. The start is in the upper left cell, the goal in the lower right one.
+			 */
+			static Map maze(	unsigned long aSeed,
+								const Size& aWorldSize,
+								int aCellSize = 64);
+			/**
+			 * Horizontal walls over the full width of the world with one opening at a random position,
+			 * the route has to find the openings from the top to the bottom of the world
+			 */
+			static Map corridors(	unsigned long aSeed,
+									const Size& aWorldSize,
+									int aCorridorWidth = 80);
+			/**
+			 * The walls, the "Robot" and the "Goal" of one of the built-in situations of the RobotWorld.
+			 * The RobotWorld is populated with the situation.
+			 *
+			 * @param aSituation 1 to 6
+			 * @param anOther The other variant of the situation
+			 */
+			static Map situation(	unsigned long aSituation,
+									bool anOther = false);
+			/**
+			 * Rasterises aMap for a robot with aFreeRadius with the clearances AStar::getObstacleLines gives
+			 * the walls and the borders of a RobotWorld
+			 */
+			static void fillOccupancyGrid(	const Map& aMap,
+											int aFreeRadius,
+											OccupancyGrid& aGrid);
+	}; // class MapGenerator
+} // namespace PathAlgorithm
+#endif // MAPGENERATOR_HPP_
@@ -0,0 +1,141 @@
+#include "OccupancyGrid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
+#include <tuple>
+#include "Shape2DUtils.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	bool OccupancyGrid::Line::operator<( const Line& aLine) const
+	{
+		return std::make_tuple( startPoint.x, startPoint.y, endPoint.x, endPoint.y, radius) <
+			   std::make_tuple( aLine.startPoint.x, aLine.startPoint.y, aLine.endPoint.x, aLine.endPoint.y, aLine.radius);
+	}
+	/**
+	 *
+	 */
+	OccupancyGrid::OccupancyGrid() :
+								width( 0),
+								height( 0)
+	{
+	}
+	/**
+	 *
+	 */
+	OccupancyGrid::OccupancyGrid(	int aWidth,
+									int aHeight) :
+								width( 0),
+								height( 0)
+	{
+		reset( aWidth, aHeight);
+	}
+	/**
+	 *
+	 */
+	void OccupancyGrid::reset(	int aWidth,
+								int aHeight)
+	{
+		width = std::max( aWidth, 0);
+		height = std::max( aHeight, 0);
+		cells.assign( static_cast< std::size_t >( width) * height, 0);
+	}
+	/**
+	 *
+	 */
+	bool OccupancyGrid::isLineFree(	const Vertex& aFrom,
+									const Vertex& aTo) const
+	{
+		int dx = aTo.x - aFrom.x;
+		int dy = aTo.y - aFrom.y;
+		int numberOfSteps = std::max( std::abs( dx), std::abs( dy));
+
+		for (int step = 1; step <= numberOfSteps; ++step)
+		{
+			int x = aFrom.x + static_cast< int >( std::lround( static_cast< double >( dx) * step / numberOfSteps));
+			int y = aFrom.y + static_cast< int >( std::lround( static_cast< double >( dy) * step / numberOfSteps));
+			if (!isFree( x, y))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	/**
+	 *
+	 */
+	void OccupancyGrid::addLine(	const Point& aStartPoint,
+									const Point& anEndPoint,
+									int aRadius,
+									std::vector< Vertex >* aChangedCells /*= nullptr*/)
+	{
+		updateLine( aStartPoint, anEndPoint, aRadius, 1, aChangedCells);
+	}
+	/**
+	 *
+	 */
+	void OccupancyGrid::removeLine(	const Point& aStartPoint,
+									const Point& anEndPoint,
+									int aRadius,
+									std::vector< Vertex >* aChangedCells /*= nullptr*/)
+	{
+		updateLine( aStartPoint, anEndPoint, aRadius, -1, aChangedCells);
+	}
+	/**
+	 *
+	 */
+	void OccupancyGrid::replaceLines(	const std::vector< Line >& someOldLines,
+										const std::vector< Line >& someNewLines,
+										std::vector< Vertex >* aChangedCells /*= nullptr*/)
+	{
+		std::vector< Line > removedLines;
+		std::set_difference( someOldLines.begin(), someOldLines.end(), someNewLines.begin(), someNewLines.end(), std::back_inserter( removedLines));
+		std::vector< Line > addedLines;
+		std::set_difference( someNewLines.begin(), someNewLines.end(), someOldLines.begin(), someOldLines.end(), std::back_inserter( addedLines));
+
+		for (const Line& line : removedLines)
+		{
+			removeLine( line, aChangedCells);
+		}
+		for (const Line& line : addedLines)
+		{
+			addLine( line, aChangedCells);
+		}
+	}
+	/**
+	 *
+	 */
+	void OccupancyGrid::updateLine(	const Point& aStartPoint,
+									const Point& anEndPoint,
+									int aRadius,
+									int aDelta,
+									std::vector< Vertex >* aChangedCells)
+	{
+		// Only the cells in the bounding box of the line, extended with aRadius, can be on the line
+		int minX = std::max( std::min( aStartPoint.x, anEndPoint.x) - aRadius, 0);
+		int maxX = std::min( std::max( aStartPoint.x, anEndPoint.x) + aRadius, width - 1);
+		int minY = std::max( std::min( aStartPoint.y, anEndPoint.y) - aRadius, 0);
+		int maxY = std::min( std::max( aStartPoint.y, anEndPoint.y) + aRadius, height - 1);
+
+		for (int y = minY; y <= maxY; ++y)
+		{
+			for (int x = minX; x <= maxX; ++x)
+			{
+				if (Utils::Shape2DUtils::isOnLine( aStartPoint, anEndPoint, Point( x, y), aRadius))
+				{
+					unsigned short& cell = cells[y * width + x];
+					cell = static_cast< unsigned short >( cell + aDelta);
+					// The cell changed state if it went from 0 to 1 or from 1 to 0
+					if (aChangedCells && cell == (aDelta > 0 ? 1 : 0))
+					{
+						aChangedCells->push_back( Vertex( x, y));
+					}
+				}
+			}
+		}
+	}
+} // namespace PathAlgorithm
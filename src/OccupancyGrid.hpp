@@ -0,0 +1,166 @@
+#ifndef OCCUPANCYGRID_HPP_
+#define OCCUPANCYGRID_HPP_
+
+#include "Config.hpp"
+
+#include <vector>
+
+#include "Point.hpp"
+#include "Vertex.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 * A rasterised map of the world with one cell per pixel. A cell is occupied if a robot
+	 * with its centre in that cell would be too close to an obstacle, i.e. the obstacles are
+	 * inflated with the clearance the robot needs.
+	 *
+	 * Cells outside the grid are always occupied.
+	 *
+	 * Every cell counts the obstacles that occupy it so that an obstacle can be removed again
+	 * without rasterising the remaining obstacles. Incremental planners can ask for the
+	 * cells whose state changed when an obstacle was added or removed.
+	 */
+	class OccupancyGrid
+	{
+		public:
+			/**
+			 * An obstacle as it is rasterised: a line inflated with a radius
+			 */
+			struct Line
+			{
+					/**
+					 * An arbitrary but strict order so that two lists of lines can be compared
+					 */
+					bool operator<( const Line& aLine) const;
+
+					Point startPoint;
+					Point endPoint;
+					int radius;
+			};
+			/**
+			 *
+			 */
+			OccupancyGrid();
+			/**
+			 *
+			 */
+			OccupancyGrid(	int aWidth,
+							int aHeight);
+			/**
+			 * Resizes the grid and marks all cells as free
+			 */
+			void reset(	int aWidth,
+						int aHeight);
+			/**
+			 *
+			 */
+			int getWidth() const
+			{
+				return width;
+			}
+			/**
+			 *
+			 */
+			int getHeight() const
+			{
+				return height;
+			}
+			/**
+			 *
+			 */
+			bool isInside(	int anX,
+							int anY) const
+			{
+				return anX >= 0 && anX < width && anY >= 0 && anY < height;
+			}
+			/**
+			 *
+			 * @return True if the cell is inside the grid and not occupied
+			 */
+			bool isFree(	int anX,
+							int anY) const
+			{
+				return isInside( anX, anY) && cells[anY * width + anX] == 0;
+			}
+			/**
+			 *
+			 */
+			bool isFree( const Vertex& aVertex) const
+			{
+				return isFree( aVertex.x, aVertex.y);
+			}
+			/**
+			 * Walks the cells of the straight line from aFrom to aTo, one cell per step along the longest axis.
+			 * This is the same sequence of cells a robot visits when it drives the line pixel by pixel.
+			 *
+			 * @return True if all cells of the line except aFrom are free
+			 */
+			bool isLineFree(	const Vertex& aFrom,
+								const Vertex& aTo) const;
+			/**
+			 * Marks every cell that is within aRadius of the line from aStartPoint to anEndPoint as occupied.
+			 * A cell is within aRadius if Utils::Shape2DUtils::isOnLine would say so.
+			 *
+			 * @param aChangedCells If given, the cells that were free before are appended to it
+			 */
+			void addLine(	const Point& aStartPoint,
+							const Point& anEndPoint,
+							int aRadius,
+							std::vector< Vertex >* aChangedCells = nullptr);
+			/**
+			 *
+			 */
+			void addLine(	const Line& aLine,
+							std::vector< Vertex >* aChangedCells = nullptr)
+			{
+				addLine( aLine.startPoint, aLine.endPoint, aLine.radius, aChangedCells);
+			}
+			/**
+			 * Removes a line that was added before with the same arguments.
+			 *
+			 * @param aChangedCells If given, the cells that became free are appended to it
+			 */
+			void removeLine(	const Point& aStartPoint,
+								const Point& anEndPoint,
+								int aRadius,
+								std::vector< Vertex >* aChangedCells = nullptr);
+			/**
+			 *
+			 */
+			void removeLine(	const Line& aLine,
+								std::vector< Vertex >* aChangedCells = nullptr)
+			{
+				removeLine( aLine.startPoint, aLine.endPoint, aLine.radius, aChangedCells);
+			}
+
+			/**
+			 * Replaces the lines someOldLines, which must have been added before, by someNewLines.
+			 * Only the lines that are not in both are rasterised. Both vectors must be sorted.
+			 *
+			 * @param aChangedCells If given, the cells that became free or occupied are appended to it
+			 */
+			void replaceLines(	const std::vector< Line >& someOldLines,
+								const std::vector< Line >& someNewLines,
+								std::vector< Vertex >* aChangedCells = nullptr);
+
+		private:
+			/**
+			 * Adds aDelta to the count of every cell on the line
+			 */
+			void updateLine(	const Point& aStartPoint,
+								const Point& anEndPoint,
+								int aRadius,
+								int aDelta,
+								std::vector< Vertex >* aChangedCells);
+
+			int width;
+			int height;
+			/**
+			 * The number of obstacles that occupy a cell
+			 */
+			std::vector< unsigned short > cells;
+	};
+	// class OccupancyGrid
+} // namespace PathAlgorithm
+#endif // OCCUPANCYGRID_HPP_
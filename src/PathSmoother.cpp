@@ -0,0 +1,43 @@
+#include "PathSmoother.hpp"
+
+#include <cmath>
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	/* static */Path PathSmoother::smooth(	const Path& aPath,
+											const OccupancyGrid& aGrid)
+	{
+		if (aPath.size() <= 2)
+		{
+			return aPath;
+		}
+
+		Path waypoints;
+		waypoints.push_back( aPath.front());
+		waypoints.back().actualCost = 0.0;
+
+		std::size_t anchor = 0;
+		for (std::size_t i = 2; i < aPath.size(); ++i)
+		{
+			// Two neighbouring cells of the route can always see each other, so i - 1 > anchor
+			if (!aGrid.isLineFree( aPath[anchor], aPath[i]))
+			{
+				anchor = i - 1;
+				waypoints.push_back( aPath[anchor]);
+			}
+		}
+		waypoints.push_back( aPath.back());
+
+		for (std::size_t i = 1; i < waypoints.size(); ++i)
+		{
+			const Vertex& previous = waypoints[i - 1];
+			Vertex& waypoint = waypoints[i];
+			waypoint.actualCost = previous.actualCost + std::sqrt( (waypoint.x - previous.x) * (waypoint.x - previous.x) + (waypoint.y - previous.y) * (waypoint.y - previous.y));
+			waypoint.heuristicCost = waypoint.actualCost;
+		}
+		return waypoints;
+	}
+} // namespace PathAlgorithm
@@ -0,0 +1,32 @@
+#ifndef PATHSMOOTHER_HPP_
+#define PATHSMOOTHER_HPP_
+
+#include "Config.hpp"
+
+#include "AStar.hpp"
+#include "OccupancyGrid.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 * Turns a route of neighbouring cells into an any-angle route: a short list of waypoints
+	 * that are connected by straight lines.
+	 *
+	 * The line-of-sight test is done on the occupancy grid the route was planned on, so the
+	 * straight lines keep the same clearance to walls and robots as the cells of the route.
+	 */
+	class PathSmoother
+	{
+		public:
+			/**
+			 * Keeps the first and the last Vertex of aPath and from every waypoint skips to the
+			 * last Vertex of aPath that can still be reached in a straight line.
+			 *
+			 * @return The waypoints, the actualCost of a waypoint is the length of the route up to it
+			 */
+			static Path smooth(	const Path& aPath,
+								const OccupancyGrid& aGrid);
+	};
+	// class PathSmoother
+} // namespace PathAlgorithm
+#endif // PATHSMOOTHER_HPP_
@@ -0,0 +1,138 @@
+#include "PlanningService.hpp"
+
+#include <algorithm>
+#include <exception>
+
+#include "PathSmoother.hpp"
+#include "RobotWorld.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	PlanningService::PlanningService( unsigned int aNumberOfWorkers) :
+								stopping( false)
+	{
+		if (aNumberOfWorkers == 0)
+		{
+			aNumberOfWorkers = std::max( std::thread::hardware_concurrency(), 1U);
+		}
+		for (unsigned int i = 0; i < aNumberOfWorkers; ++i)
+		{
+			workers.emplace_back( new Worker());
+		}
+		// The workers are complete before the first thread can take a task
+		for (std::unique_ptr< Worker >& worker : workers)
+		{
+			Worker* w = worker.get();
+			threads.emplace_back( [this, w]{ work( *w);});
+		}
+	}
+	/**
+	 *
+	 */
+	PlanningService::~PlanningService()
+	{
+		{
+			std::lock_guard< std::mutex > lock( tasksMutex);
+			stopping = true;
+		}
+		tasksAvailable.notify_all();
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	}
+	/**
+	 *
+	 */
+	/* static */PlanningService& PlanningService::getPlanningService()
+	{
+		static PlanningService planningService;
+		return planningService;
+	}
+	/**
+	 *
+	 */
+	std::future< Path > PlanningService::plan(	const Point& aStartPoint,
+												const Point& aGoalPoint,
+												const Size& aRobotSize,
+												const std::string& aRobotName,
+												bool aSmoothed /*= false*/)
+	{
+		std::vector< std::future< Path > > futures = plan( std::vector< Request >{ Request{ aStartPoint, aGoalPoint, aRobotSize, aRobotName, aSmoothed } });
+		return std::move( futures.front());
+	}
+	/**
+	 *
+	 */
+	std::vector< std::future< Path > > PlanningService::plan( const std::vector< Request >& someRequests)
+	{
+		std::vector< std::future< Path > > futures;
+		futures.reserve( someRequests.size());
+		{
+			std::lock_guard< std::mutex > lock( tasksMutex);
+			for (const Request& request : someRequests)
+			{
+				tasks.push_back( Task{ request, std::promise< Path >() });
+				futures.push_back( tasks.back().promise.get_future());
+			}
+		}
+		tasksAvailable.notify_all();
+		return futures;
+	}
+	/**
+	 *
+	 */
+	void PlanningService::work( Worker& aWorker)
+	{
+		for (;;)
+		{
+			Task task;
+			{
+				std::unique_lock< std::mutex > lock( tasksMutex);
+				tasksAvailable.wait( lock, [this]{ return stopping || !tasks.empty();});
+				if (tasks.empty())
+				{
+					return;
+				}
+				task = std::move( tasks.front());
+				tasks.pop_front();
+			}
+
+			try
+			{
+				task.promise.set_value( plan( aWorker, task.request));
+			}
+			catch (...)
+			{
+				task.promise.set_exception( std::current_exception());
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	Path PlanningService::plan(	Worker& aWorker,
+								const Request& aRequest)
+	{
+		int radius = AStar::freeRadius( aRequest.robotSize);
+		unsigned long version = Model::RobotWorld::getRobotWorld().getGeometryVersion();
+
+		if (!aWorker.filled || aWorker.radius != radius || aWorker.version != version || aWorker.robotName != aRequest.robotName)
+		{
+			AStar::fillOccupancyGrid( aWorker.occupancyGrid, radius, aRequest.robotName);
+			aWorker.radius = radius;
+			aWorker.version = version;
+			aWorker.robotName = aRequest.robotName;
+			aWorker.filled = true;
+		}
+		Path path = aWorker.astar.search( Vertex( aRequest.start), Vertex( aRequest.goal), aWorker.occupancyGrid);
+		if (aRequest.smoothed)
+		{
+			return PathSmoother::smooth( path, aWorker.occupancyGrid);
+		}
+		return path;
+	}
+} // namespace PathAlgorithm
@@ -0,0 +1,130 @@
+#ifndef PLANNINGSERVICE_HPP_
+#define PLANNINGSERVICE_HPP_
+
+#include "Config.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AStar.hpp"
+#include "OccupancyGrid.hpp"
+#include "Point.hpp"
+#include "Size.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 * Plans routes for many robots on a fixed pool of worker threads.
+	 *
+	 * Every worker owns an AStar and an occupancy grid, so the searches of different workers
+	 * share no state and no locks. A worker only rasterises the obstacles again if the geometry
+	 * version of the RobotWorld, the clearance or the name of the robot differs from its previous
+	 * request, a batch of requests in the same world therefore rasterises at most once per worker
+	 * and robot.
+	 */
+	class PlanningService
+	{
+		public:
+			/**
+			 * The robot named robotName is not an obstacle for its own route, with an empty name
+			 * all robots are obstacles
+			 */
+			struct Request
+			{
+					Point start;
+					Point goal;
+					Size robotSize;
+					std::string robotName;
+					/**
+					 * If true the route is reduced to its waypoints by the PathSmoother
+					 */
+					bool smoothed;
+			};
+			/**
+			 *
+			 * @param aNumberOfWorkers The number of worker threads, one per hardware thread if 0
+			 */
+			explicit PlanningService( unsigned int aNumberOfWorkers = 0);
+			/**
+			 * Finishes the requests that are already queued and stops the workers
+			 */
+			~PlanningService();
+			/**
+			 *
+			 * @return The service that is shared by all robots
+			 */
+			static PlanningService& getPlanningService();
+			/**
+			 * Queues the request, the future becomes ready when a worker has planned the route
+			 */
+			std::future< Path > plan(	const Point& aStartPoint,
+										const Point& aGoalPoint,
+										const Size& aRobotSize,
+										const std::string& aRobotName,
+										bool aSmoothed = false);
+			/**
+			 * Queues all requests at once, the futures are in the order of someRequests
+			 */
+			std::vector< std::future< Path > > plan( const std::vector< Request >& someRequests);
+			/**
+			 *
+			 */
+			unsigned int getNumberOfWorkers() const
+			{
+				return static_cast< unsigned int >( workers.size());
+			}
+
+		private:
+			/**
+			 *
+			 */
+			struct Task
+			{
+					Request request;
+					std::promise< Path > promise;
+			};
+			/**
+			 * The scratch buffers of one worker thread
+			 */
+			struct Worker
+			{
+					Worker() :
+								radius( 0),
+								version( 0),
+								filled( false)
+					{
+					}
+
+					AStar astar;
+					OccupancyGrid occupancyGrid;
+					int radius;
+					unsigned long version;
+					std::string robotName;
+					bool filled;
+			};
+			/**
+			 * The loop of a worker thread: takes the oldest task until the service stops
+			 */
+			void work( Worker& aWorker);
+			/**
+			 *
+			 */
+			Path plan(	Worker& aWorker,
+						const Request& aRequest);
+
+			std::vector< std::unique_ptr< Worker > > workers;
+			std::vector< std::thread > threads;
+
+			std::deque< Task > tasks;
+			bool stopping;
+			std::mutex tasksMutex;
+			std::condition_variable tasksAvailable;
+	}; // class PlanningService
+} // namespace PathAlgorithm
+#endif // PLANNINGSERVICE_HPP_
@@ -8,6 +8,70 @@
  * Author: jkr
  */
 
+#if defined( ROBOTWORLD_HEADLESS)
+
+namespace Widgets
+{
+	/**
+	 * The part of wxPoint the model uses, for the builds without wxWidgets
+	 */
+	struct Point
+	{
+			Point() :
+				x( 0),
+				y( 0)
+			{
+			}
+			Point(	int anX,
+					int anY) :
+						x( anX),
+						y( anY)
+			{
+			}
+			bool operator==( const Point& aPoint) const
+			{
+				return x == aPoint.x && y == aPoint.y;
+			}
+			bool operator!=( const Point& aPoint) const
+			{
+				return !(*this == aPoint);
+			}
+			Point operator+( const Point& aPoint) const
+			{
+				return Point( x + aPoint.x, y + aPoint.y);
+			}
+			Point operator-( const Point& aPoint) const
+			{
+				return Point( x - aPoint.x, y - aPoint.y);
+			}
+			Point& operator+=( const Point& aPoint)
+			{
+				x += aPoint.x;
+				y += aPoint.y;
+				return *this;
+			}
+			Point& operator-=( const Point& aPoint)
+			{
+				x -= aPoint.x;
+				y -= aPoint.y;
+				return *this;
+			}
+			Point operator-() const
+			{
+				return Point( -x, -y);
+			}
+
+			int x;
+			int y;
+	};
+	/**
+	 * The value of wxDefaultPosition
+	 */
+	const Point DefaultPosition( -1, -1);
+} // namespace Widgets
+
+#else
+
 #include <wx/gdicmn.h>
 
 namespace Widgets
@@ -16,7 +80,14 @@ namespace Widgets
 	 * @see http://docs.wxwidgets.org/stable/classwx_point
 	 */
 	typedef wxPoint Point;
+	/**
+	 * @see http://docs.wxwidgets.org/stable/classwx_default_position
+	 */
+#define DefaultPosition wxDefaultPosition
 } // namespace Widgets
+
+#endif // ROBOTWORLD_HEADLESS
+
 using namespace Widgets;
 
 
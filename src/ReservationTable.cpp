@@ -0,0 +1,151 @@
+#include "ReservationTable.hpp"
+
+#include <algorithm>
+
+#include "Scheduler.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	/* static */long ReservationTable::getCurrentTick()
+	{
+		return static_cast< long >( Model::Scheduler::getScheduler().getTick());
+	}
+	/**
+	 *
+	 */
+	/* static */ReservationTable& ReservationTable::getReservationTable()
+	{
+		static ReservationTable reservationTable;
+		return reservationTable;
+	}
+	/**
+	 *
+	 */
+	void ReservationTable::reserve(	const std::string& anOwner,
+									const Path& aPath,
+									int aRadius,
+									long aStartTick)
+	{
+		release( anOwner);
+		if (aPath.empty())
+		{
+			return;
+		}
+
+		std::lock_guard< std::mutex > lock( reservationsMutex);
+		reservations.push_back( Reservation{ anOwner, aPath, aRadius, aStartTick });
+	}
+	/**
+	 *
+	 */
+	void ReservationTable::release( const std::string& anOwner)
+	{
+		std::lock_guard< std::mutex > lock( reservationsMutex);
+		reservations.erase( std::remove_if( reservations.begin(), reservations.end(), [&anOwner]( const Reservation& aReservation)
+											{
+												return aReservation.owner == anOwner;
+											}),
+							reservations.end());
+	}
+	/**
+	 *
+	 */
+	void ReservationTable::clear()
+	{
+		std::lock_guard< std::mutex > lock( reservationsMutex);
+		reservations.clear();
+	}
+	/**
+	 *
+	 */
+	bool ReservationTable::hasReservation( const std::string& anOwner) const
+	{
+		std::lock_guard< std::mutex > lock( reservationsMutex);
+		return std::any_of( reservations.begin(), reservations.end(), [&anOwner]( const Reservation& aReservation)
+							{
+								return aReservation.owner == anOwner;
+							});
+	}
+	/**
+	 *
+	 */
+	std::vector< std::string > ReservationTable::getOwners() const
+	{
+		std::lock_guard< std::mutex > lock( reservationsMutex);
+		std::vector< std::string > owners;
+		for (const Reservation& reservation : reservations)
+		{
+			owners.push_back( reservation.owner);
+		}
+		return owners;
+	}
+	/**
+	 *
+	 */
+	bool ReservationTable::isFree(	const std::string& anOwner,
+									const Vertex& aVertex,
+									int aRadius,
+									long aTick) const
+	{
+		std::lock_guard< std::mutex > lock( reservationsMutex);
+		for (const Reservation& reservation : reservations)
+		{
+			if (reservation.owner != anOwner && isConflict( aVertex, aRadius, getVertexAt( reservation, aTick), reservation.radius))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	/**
+	 * Only the remaining moves of the other routes are checked, once they are all parked nothing changes anymore
+	 */
+	bool ReservationTable::isFreeFrom(	const std::string& anOwner,
+										const Vertex& aVertex,
+										int aRadius,
+										long aTick) const
+	{
+		std::lock_guard< std::mutex > lock( reservationsMutex);
+		for (const Reservation& reservation : reservations)
+		{
+			if (reservation.owner == anOwner)
+			{
+				continue;
+			}
+			long lastTick = std::max( aTick, reservation.startTick + static_cast< long >( reservation.path.size()) - 1);
+			for (long tick = aTick; tick <= lastTick; ++tick)
+			{
+				if (isConflict( aVertex, aRadius, getVertexAt( reservation, tick), reservation.radius))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+	/**
+	 *
+	 */
+	/* static */const Vertex& ReservationTable::getVertexAt(	const Reservation& aReservation,
+															long aTick)
+	{
+		long index = std::min( std::max( aTick - aReservation.startTick, 0L), static_cast< long >( aReservation.path.size()) - 1);
+		return aReservation.path[static_cast< std::size_t >( index)];
+	}
+	/**
+	 *
+	 */
+	/* static */bool ReservationTable::isConflict(	const Vertex& aVertex,
+													int aRadius,
+													const Vertex& anOtherVertex,
+													int anOtherRadius)
+	{
+		long dx = aVertex.x - anOtherVertex.x;
+		long dy = aVertex.y - anOtherVertex.y;
+		long distance = aRadius + anOtherRadius;
+		return dx * dx + dy * dy < distance * distance;
+	}
+} // namespace PathAlgorithm
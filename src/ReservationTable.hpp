@@ -0,0 +1,106 @@
+#ifndef RESERVATIONTABLE_HPP_
+#define RESERVATIONTABLE_HPP_
+
+#include "Config.hpp"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "AStar.hpp"
+#include "Vertex.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 * The space-time reservations of the robots that planned cooperatively.
+	 *
+	 * A reservation is a route that starts at a given tick and advances one Vertex per tick,
+	 * after its last Vertex the robot is parked there forever. A robot is a circle with its
+	 * clearance radius around its centre, two robots conflict at a tick if their circles overlap.
+	 */
+	class ReservationTable
+	{
+		public:
+			/**
+			 *
+			 * @return The current tick of the Scheduler, the clock of all reservations. A driving Robot
+			 * 			moves one Vertex per tick.
+			 */
+			static long getCurrentTick();
+			/**
+			 *
+			 * @return The table that is shared by all robots
+			 */
+			static ReservationTable& getReservationTable();
+			/**
+			 * Reserves aPath from aStartTick on for anOwner, replacing the reservation anOwner already had
+			 */
+			void reserve(	const std::string& anOwner,
+							const Path& aPath,
+							int aRadius,
+							long aStartTick);
+			/**
+			 * Removes the reservation of anOwner, if any
+			 */
+			void release( const std::string& anOwner);
+			/**
+			 * Removes all reservations
+			 */
+			void clear();
+			/**
+			 *
+			 * @return True if anOwner has a reservation
+			 */
+			bool hasReservation( const std::string& anOwner) const;
+			/**
+			 *
+			 * @return The owners of all reservations
+			 */
+			std::vector< std::string > getOwners() const;
+			/**
+			 *
+			 * @return True if a robot with aRadius at aVertex at aTick conflicts with no reservation of another owner than anOwner
+			 */
+			bool isFree(	const std::string& anOwner,
+							const Vertex& aVertex,
+							int aRadius,
+							long aTick) const;
+			/**
+			 *
+			 * @return True if a robot with aRadius may park at aVertex from aTick on
+			 */
+			bool isFreeFrom(	const std::string& anOwner,
+								const Vertex& aVertex,
+								int aRadius,
+								long aTick) const;
+
+		private:
+			/**
+			 *
+			 */
+			struct Reservation
+			{
+					std::string owner;
+					Path path;
+					int radius;
+					long startTick;
+			};
+			/**
+			 *
+			 */
+			static const Vertex& getVertexAt(	const Reservation& aReservation,
+												long aTick);
+			/**
+			 *
+			 */
+			static bool isConflict(	const Vertex& aVertex,
+									int aRadius,
+									const Vertex& anOtherVertex,
+									int anOtherRadius);
+
+			std::vector< Reservation > reservations;
+			mutable std::mutex reservationsMutex;
+	}; // class ReservationTable
+} // namespace PathAlgorithm
+#endif // RESERVATIONTABLE_HPP_
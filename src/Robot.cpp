@@ -1,4 +1,9 @@
 #include "Robot.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <limits>
 #include <sstream>
 #include <ctime>
 #include <chrono>
@@ -11,10 +16,18 @@
 #include "Wall.hpp"
 #include "RobotWorld.hpp"
 #include "CommunicationService.hpp"
+#include "EventLog.hpp"
 #include "Client.hpp"
 #include "Message.hpp"
-#include "MainApplication.hpp"
+#include "Commandline.hpp"
+#include "FlowField.hpp"
 #include "LaserDistanceSensor.hpp"
+#include "PathSmoother.hpp"
+#include "PlanningService.hpp"
+#include "RouteCache.hpp"
+#include "Scheduler.hpp"
+#include "TourPlanner.hpp"
+#include "WallTree.hpp"
 #include <stdlib.h>
 
 namespace Model
@@ -24,33 +37,15 @@ namespace Model
 	 *
 	 */
 	Robot::Robot() :
-								name( ""),
-								size( DefaultSize),
-								position( DefaultPosition),
-								front( 0, 0),
-								speed( 0.0),
-								acting(false),
-								driving(false),
-								communicating(false)
+								Robot( "", DefaultPosition)
 	{
-		std::shared_ptr< AbstractSensor > proximitySensor( new ProximitySensor( this));
-		attachSensor( proximitySensor);
 	}
 	/**
 	 *
 	 */
 	Robot::Robot( const std::string& aName) :
-								name( aName),
-								size( DefaultSize),
-								position( DefaultPosition),
-								front( 0, 0),
-								speed( 0.0),
-								acting(false),
-								driving(false),
-								communicating(false)
+								Robot( aName, DefaultPosition)
 	{
-		std::shared_ptr< AbstractSensor > proximitySensor( new ProximitySensor( this));
-		attachSensor( proximitySensor);
 	}
 	/**
 	 *
@@ -62,12 +57,26 @@ namespace Model
 								position( aPosition),
 								front( 0, 0),
 								speed( 0.0),
+								pathPlanner( getDefaultPathPlanner()),
+								anyAngle( Application::Commandline::isArgGiven( "-any_angle")),
+								anytimeBudget( getDefaultAnytimeBudget()),
+								improvingRoute( false),
+								wayPointTour( Application::Commandline::isArgGiven( "-tour")),
+								flowField( nullptr),
+								cooperativeRouteTick( 0),
+								pathPoint( 0),
+								segmentStep( 0),
 								acting(false),
 								driving(false),
-								communicating(false)
+								communicating(false),
+								drivingTask( Scheduler::NoTask),
+								routeNeeded( false),
+								poseVersion( 0)
 	{
-		std::shared_ptr< AbstractSensor > proximitySensor( new ProximitySensor( this));
-		attachSensor( proximitySensor);
+		seedRandomGenerator();
+		namePlanners();
+		updatePose();
+		attachSensors();
 	}
 	/**
 	 *
@@ -88,10 +97,79 @@ namespace Model
 			stopCommunicating();
 		}
 	}
+	/**
+	 *
+	 */
+	/* static */Robot::PathPlanner Robot::getDefaultPathPlanner()
+	{
+		if (Application::Commandline::isArgGiven( "-planner"))
+		{
+			const std::string& planner = Application::Commandline::getArg( "-planner").value;
+			if (planner == "jps")
+			{
+				return JumpPointSearchPlanner;
+			}
+			if (planner == "dstarlite")
+			{
+				return DStarLitePlanner;
+			}
+			if (planner == "hpa")
+			{
+				return HPAStarPlanner;
+			}
+			if (planner == "cooperative")
+			{
+				return CooperativePlanner;
+			}
+			if (planner == "anytime")
+			{
+				return AnytimePlanner;
+			}
+			if (planner == "bidirectional")
+			{
+				return BidirectionalPlanner;
+			}
+			if (planner == "flowfield")
+			{
+				return FlowFieldPlanner;
+			}
+		}
+		return AStarPlanner;
+	}
+	/**
+	 *
+	 */
+	/* static */std::chrono::milliseconds Robot::getDefaultAnytimeBudget()
+	{
+		if (Application::Commandline::isArgGiven( "-anytime_budget"))
+		{
+			return std::chrono::milliseconds( std::stoi( Application::Commandline::getArg( "-anytime_budget").value));
+		}
+		return std::chrono::milliseconds( DefaultAnytimeBudget);
+	}
+	/**
+	 *
+	 */
+	/* static */unsigned long Robot::getDefaultSeed()
+	{
+		if (Application::Commandline::isArgGiven( "-seed"))
+		{
+			return std::stoul( Application::Commandline::getArg( "-seed").value);
+		}
+		return 0;
+	}
+	/**
+	 *
+	 */
 	int Robot::randomNumberBetweenUpToN(int N /*=100 */)
 	{
-		std::srand(position.x + position.y);
-		return std::rand() % N + 1;
+		int number;
+		{
+			std::lock_guard< std::recursive_mutex > lock( robotMutex);
+			number = static_cast< int >( randomGenerator() % static_cast< unsigned >( N)) + 1;
+		}
+		recordEvent( "random " + std::to_string( number));
+		return number;
 	}
 	/**
 	 *
@@ -100,12 +178,170 @@ namespace Model
 						 bool aNotifyObservers /*= true*/)
 	{
 		name = aName;
+		seedRandomGenerator();
+		namePlanners();
 		if (aNotifyObservers == true)
 		{
 			notifyObservers();
 		}
 
 	}
+	/**
+	 *
+	 */
+	void Robot::recordEvent( const std::string& anEvent) const
+	{
+		EventLog& eventLog = EventLog::getEventLog();
+		if (eventLog.isEnabled())
+		{
+			eventLog.record( name, anEvent);
+		}
+	}
+	/**
+	 * FNV-1a of the name, Robots with the same seed but another name draw other numbers
+	 */
+	void Robot::seedRandomGenerator()
+	{
+		unsigned long hash = 2166136261UL;
+		for (unsigned char character : name)
+		{
+			hash = ((hash ^ character) * 16777619UL) & 0xFFFFFFFFUL;
+		}
+		std::lock_guard< std::recursive_mutex > lock( robotMutex);
+		randomGenerator.seed( static_cast< std::mt19937::result_type >( getDefaultSeed() ^ hash));
+	}
+	/**
+	 *
+	 */
+	void Robot::namePlanners()
+	{
+		astar.setRobotName( name);
+		jumpPointSearch.setRobotName( name);
+		dStarLite.setRobotName( name);
+		hpaStar.setRobotName( name);
+		anytimeAStar.setRobotName( name);
+	}
+	/**
+	 *
+	 */
+	void Robot::attachSensors()
+	{
+		std::shared_ptr< AbstractSensor > proximitySensor( new ProximitySensor( this));
+		attachSensor( proximitySensor);
+		if (Application::Commandline::isArgGiven( "-laser"))
+		{
+			std::shared_ptr< AbstractSensor > laserDistanceSensor( new LaserDistanceSensor( this));
+			attachSensor( laserDistanceSensor);
+		}
+	}
+	/**
+	 * The sensors are stepped by the Scheduler every tick, so there is usually one percept of every sensor
+	 */
+	bool Robot::handlePercepts()
+	{
+		bool collisionPerceived = false;
+		while (perceptQueue.size() > 0)
+		{
+			std::shared_ptr< AbstractPercept > percept = perceptQueue.dequeue();
+			if (std::shared_ptr< CollisionPercept > collisionPercept = std::dynamic_pointer_cast< CollisionPercept >( percept))
+			{
+				collisionPerceived = collisionPerceived || collisionPercept->collision;
+			} else if (std::shared_ptr< DistanceScanPercept > distanceScanPercept = std::dynamic_pointer_cast< DistanceScanPercept >( percept))
+			{
+				std::lock_guard< std::recursive_mutex > lock( robotMutex);
+				laserScan = distanceScanPercept;
+			}
+		}
+		return collisionPerceived;
+	}
+	/**
+	 *
+	 */
+	void Robot::setCooperativeRoute(	const PathAlgorithm::Path& aPath,
+										long aStartTick)
+	{
+		cooperativeRoute = aPath;
+		cooperativeRouteTick = aStartTick;
+	}
+	/**
+	 *
+	 */
+	std::shared_ptr< const DistanceScanPercept > Robot::getLaserScan() const
+	{
+		std::lock_guard< std::recursive_mutex > lock( robotMutex);
+		return laserScan;
+	}
+	/**
+	 * HPAStar keeps the entrances it expanded anyway, it has no snapshots to enable
+	 */
+	void Robot::enableSearchProgress( bool anEnable /*= true*/)
+	{
+		astar.getProgress().setEnabled( anEnable);
+		jumpPointSearch.getProgress().setEnabled( anEnable);
+		dStarLite.getProgress().setEnabled( anEnable);
+		anytimeAStar.getProgress().setEnabled( anEnable);
+	}
+	/**
+	 * A seqlock: the only writer makes poseVersion odd while it writes pose, a reader that saw an
+	 * odd or changed version copies it again
+	 */
+	Robot::Pose Robot::getPose() const
+	{
+		for (;;)
+		{
+			const unsigned version = poseVersion.load( std::memory_order_acquire);
+			if ((version & 1) == 0)
+			{
+				Pose currentPose = pose;
+				std::atomic_thread_fence( std::memory_order_acquire);
+				if (poseVersion.load( std::memory_order_relaxed) == version)
+				{
+					return currentPose;
+				}
+			}
+			std::this_thread::yield();
+		}
+	}
+	/**
+	 *
+	 */
+	void Robot::updatePose()
+	{
+		// x and y are pointing to top left now
+		const int x = position.x - (size.x / 2);
+		const int y = position.y - (size.y / 2);
+		const double angle = Utils::Shape2DUtils::getAngle( front) + 0.5 * Utils::PI;
+
+		Pose newPose;
+		newPose.cosine = std::cos( angle);
+		newPose.sine = std::sin( angle);
+		newPose.headingX = newPose.sine;
+		newPose.headingY = -newPose.cosine;
+
+		auto rotate = [this, &newPose]( const Point& aCorner)
+		{
+			return Point( (aCorner.x - position.x) * newPose.cosine - (aCorner.y - position.y) * newPose.sine + position.x, (aCorner.y - position.y) * newPose.cosine
+			+ (aCorner.x - position.x) * newPose.sine + position.y);
+		};
+		newPose.frontLeft = rotate( Point( x, y));
+		newPose.frontRight = rotate( Point( x + size.x, y));
+		newPose.backLeft = rotate( Point( x, y + size.y));
+		newPose.backRight = rotate( Point( x + size.x, y + size.y));
+
+		newPose.topLeft = Point( std::min( { newPose.frontLeft.x, newPose.frontRight.x, newPose.backLeft.x, newPose.backRight.x }), std::min( { newPose.frontLeft.y, newPose.frontRight.y, newPose.backLeft.y, newPose.backRight.y }));
+		newPose.bottomRight = Point( std::max( { newPose.frontLeft.x, newPose.frontRight.x, newPose.backLeft.x, newPose.backRight.x }), std::max( { newPose.frontLeft.y, newPose.frontRight.y, newPose.backLeft.y, newPose.backRight.y }));
+
+		{
+			std::lock_guard< std::recursive_mutex > lock( robotMutex);
+			const unsigned version = poseVersion.load( std::memory_order_relaxed);
+			poseVersion.store( version + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence( std::memory_order_release);
+			pose = newPose;
+			poseVersion.store( version + 2, std::memory_order_release);
+		}
+		RobotWorld::getRobotWorld().getCollisionGrid().moveRobot( this, newPose.topLeft, newPose.bottomRight);
+		RobotWorld::getRobotWorld().incrementGeometryVersion();
+	}
 	/**
 	 *
 	 */
@@ -120,6 +356,7 @@ namespace Model
 							bool aNotifyObservers /*= true*/)
 	{
 		size = aSize;
+		updatePose();
 		if (aNotifyObservers == true)
 		{
 			notifyObservers();
@@ -132,6 +369,7 @@ namespace Model
 								bool aNotifyObservers /*= true*/)
 	{
 		position = aPosition;
+		updatePose();
 		if (aNotifyObservers == true)
 		{
 			notifyObservers();
@@ -151,6 +389,7 @@ namespace Model
 							bool aNotifyObservers /*= true*/)
 	{
 		front = aVector;
+		updatePose();
 		if (aNotifyObservers == true)
 		{
 			notifyObservers();
@@ -183,8 +422,8 @@ namespace Model
 		RobotWorld::getRobotWorld().newGoal("startPos", position);
 		startPosition =  RobotWorld::getRobotWorld().getGoal("startPos");
 		acting = true;
-		std::thread newRobotThread( [this]{	startDriving();});
-		robotThread.swap( newRobotThread);
+		recordEvent( "start");
+		startDriving();
 	}
 	/**
 	 *
@@ -193,31 +432,145 @@ namespace Model
 	{
 		acting = false;
 		driving = false;
-		robotThread.join();
+		Scheduler::TaskId task = Scheduler::NoTask;
+		{
+			std::lock_guard< std::recursive_mutex > lock( robotMutex);
+			std::swap( task, drivingTask);
+			routeNeeded = false;
+		}
+		// Waits until the step is done, the Robot may be destroyed after this
+		Scheduler::getScheduler().unschedule( task);
+		for (std::shared_ptr< AbstractSensor > sensor : sensors)
+		{
+			sensor->setOff();
+		}
 		RobotWorld::getRobotWorld().deleteGoal(startPosition);
 		perceptQueue.clear();
+		recordEvent( "stop");
 	}
 	/**
-	 *
+	 * The route is planned by the next step of the Robot, on a worker of the Scheduler
 	 */
 	void Robot::startDriving()
 	{
+		std::lock_guard< std::recursive_mutex > lock( robotMutex);
 		driving = true;
-		if(!droveBack)
+		routeNeeded = true;
+		if (drivingTask == Scheduler::NoTask)
 		{
+			drivingTask = Scheduler::getScheduler().schedule( [this]{ return step();});
+		}
+	}
+	/**
+	 *
+	 */
+	void Robot::planRoute()
+	{
 		goal = RobotWorld::getRobotWorld().getGoal( "Goal");
-		calculateRoute(goal);
+		if (droveBack)
+		{
+			calculateRouteBack();
+		} else if (wayPointTour && !RobotWorld::getRobotWorld().getWayPoints().empty())
+		{
+			calculateTour(goal);
+		} else
+		{
+			calculateRoute(goal);
 		}
-		if(droveBack)
+		if (!plannedRoute.valid())
 		{
-			calculateRoute(startPosition);
+			routePlanned();
 		}
+	}
+	/**
+	 *
+	 */
+	void Robot::takePlannedRoute()
+	{
+		try
+		{
+			path = plannedRoute.get();
+		}
+		catch (std::exception& e)
+		{
+			std::cerr << __PRETTY_FUNCTION__ << ": " << e.what() << std::endl;
+			path.clear();
+		}
+		if (!path.empty())
+		{
+			PathAlgorithm::RouteCache::getRouteCache().insert( *plannedRouteKey, path);
+		}
+		plannedRouteKey.reset();
+		routePlanned();
+	}
+	/**
+	 *
+	 */
+	void Robot::routePlanned()
+	{
+		recordEvent( "route " + std::to_string( path.size()));
 		if(path.empty() && win)
 			{
 				sendBack();
 				// send other back.
 			}
-		drive();
+	}
+	/**
+	 *
+	 */
+	bool Robot::step()
+	{
+		bool planning = false;
+		{
+			std::lock_guard< std::recursive_mutex > lock( robotMutex);
+			std::swap( planning, routeNeeded);
+		}
+		if (planning)
+		{
+			planRoute();
+
+			for (std::shared_ptr< AbstractSensor > sensor : sensors)
+			{
+				sensor->setOn(10);
+			}
+
+			if (speed == 0.0)
+			{
+				speed = 1.0;
+			}
+			pathPoint = 0;
+			segmentStep = 0;
+		}
+		if (plannedRoute.valid())
+		{
+			// In real time the other robots keep driving while the PlanningService plans the route. A deterministic
+			// run waits for it so that the Robot starts in the same tick every time, a fast run so that no simulated
+			// time passes while the Robot waits.
+			const Scheduler& scheduler = Scheduler::getScheduler();
+			if (scheduler.isRealTime() && !scheduler.isDeterministic() && plannedRoute.wait_for( std::chrono::seconds( 0)) != std::future_status::ready)
+			{
+				return true;
+			}
+			takePlannedRoute();
+		}
+
+		if (driving && drive())
+		{
+			if (EventLog::getEventLog().isEnabled())
+			{
+				recordEvent( "pose " + std::to_string( position.x) + " " + std::to_string( position.y) + " " + std::to_string( front.x) + " " + std::to_string( front.y));
+			}
+			return true;
+		}
+
+		// A restart while this step was driving is planned in the next step
+		std::lock_guard< std::recursive_mutex > lock( robotMutex);
+		if (routeNeeded)
+		{
+			return true;
+		}
+		drivingTask = Scheduler::NoTask;
+		return false;
 	}
 	void Robot::haltDriving()
 	{
@@ -230,103 +583,61 @@ namespace Model
 	void Robot::stopDriving()
 	{
 		driving = false;
+		PathAlgorithm::ReservationTable::getReservationTable().release( name);
 	}
 
 	void Robot::restartDriving()
 	{
-		driving = false;
-		robotThread.join();
-		driving = true;
-		std::thread newRobotThread( [this]{	startDriving();});
-		robotThread.swap( newRobotThread);
+		startDriving();
 	}
 	/**
-	 **/
-	Region Robot::getRegion() const
+	 *
+	 */
+	bool Robot::intersects( const WayPoint& aWayPoint) const
 	{
-		Point translatedPoints[] = { getFrontRight(), getFrontLeft(), getBackLeft(), getBackRight() };
-		return Region( 4, translatedPoints);
+		const Pose currentPose = getPose();
+		const Point corners[] = { currentPose.frontRight, currentPose.frontLeft, currentPose.backLeft, currentPose.backRight };
+		return aWayPoint.intersects( corners);
 	}
 	/**
 	 *
 	 */
-	#pragma region movement
-	bool Robot::intersects( const Region& aRegion) const
+	bool Robot::intersects( const Robot& aRobot) const
 	{
-		Region region = getRegion();
-		region.Intersect( aRegion);
-		return !region.IsEmpty();
+		const Pose currentPose = getPose();
+		const Pose otherPose = aRobot.getPose();
+		const Point corners[] = { currentPose.frontRight, currentPose.frontLeft, currentPose.backLeft, currentPose.backRight };
+		const Point otherCorners[] = { otherPose.frontRight, otherPose.frontLeft, otherPose.backLeft, otherPose.backRight };
+		return Utils::Shape2DUtils::intersectBoxes( corners, otherCorners);
 	}
+	#pragma region movement
 	/**
 	 *
 	 */
 	Point Robot::getFrontLeft() const
 	{
-		// x and y are pointing to top left now
-		int x = position.x - (size.x / 2);
-		int y = position.y - (size.y / 2);
-
-		Point originalFrontLeft( x, y);
-		double angle = Utils::Shape2DUtils::getAngle( front) + 0.5 * Utils::PI;
-
-		Point frontLeft( (originalFrontLeft.x - position.x) * std::cos( angle) - (originalFrontLeft.y - position.y) * std::sin( angle) + position.x, (originalFrontLeft.y - position.y) * std::cos( angle)
-		+ (originalFrontLeft.x - position.x) * std::sin( angle) + position.y);
-
-		return frontLeft;
+		return getPose().frontLeft;
 	}
 	/**
 	 *
 	 */
 	Point Robot::getFrontRight() const
 	{
-		// x and y are pointing to top left now
-		int x = position.x - (size.x / 2);
-		int y = position.y - (size.y / 2);
-
-		Point originalFrontRight( x + size.x, y);
-		double angle = Utils::Shape2DUtils::getAngle( front) + 0.5 * Utils::PI;
-
-		Point frontRight( (originalFrontRight.x - position.x) * std::cos( angle) - (originalFrontRight.y - position.y) * std::sin( angle) + position.x, (originalFrontRight.y - position.y)
-						  * std::cos( angle) + (originalFrontRight.x - position.x) * std::sin( angle) + position.y);
-
-		return frontRight;
+		return getPose().frontRight;
 	}
 	/**
 	 *
 	 */
 	Point Robot::getBackLeft() const
 	{
-		// x and y are pointing to top left now
-		int x = position.x - (size.x / 2);
-		int y = position.y - (size.y / 2);
-
-		Point originalBackLeft( x, y + size.y);
-
-		double angle = Utils::Shape2DUtils::getAngle( front) + 0.5 * Utils::PI;
-
-		Point backLeft( (originalBackLeft.x - position.x) * std::cos( angle) - (originalBackLeft.y - position.y) * std::sin( angle) + position.x, (originalBackLeft.y - position.y) * std::cos( angle)
-		+ (originalBackLeft.x - position.x) * std::sin( angle) + position.y);
-
-		return backLeft;
-
+		return getPose().backLeft;
 	}
 	/**
 	 *
 	 */
 	Point Robot::getBackRight() const
 	{
-		// x and y are pointing to top left now
-		int x = position.x - (size.x / 2);
-		int y = position.y - (size.y / 2);
-
-		Point originalBackRight( x + size.x, y + size.y);
-
-		double angle = Utils::Shape2DUtils::getAngle( front) + 0.5 * Utils::PI;
-
-		Point backRight( (originalBackRight.x - position.x) * std::cos( angle) - (originalBackRight.y - position.y) * std::sin( angle) + position.x, (originalBackRight.y - position.y) * std::cos( angle)
-		+ (originalBackRight.x - position.x) * std::sin( angle) + position.y);
-
-		return backRight;
+		return getPose().backRight;
 	}
 	/**
 	 *
@@ -345,9 +656,9 @@ namespace Model
 
 
 			std::string localPort = "12345";
-			if (Application::MainApplication::isArgGiven( "-local_port"))
+			if (Application::Commandline::isArgGiven( "-local_port"))
 			{
-				localPort = Application::MainApplication::getArg( "-local_port").value;
+				localPort = Application::Commandline::getArg( "-local_port").value;
 			}
 
 			Messaging::CommunicationService::getCommunicationService().runRequestHandler( toPtr<Robot>(),
@@ -364,9 +675,9 @@ namespace Model
 			communicating = false;
 
 			std::string localPort = "12345";
-			if (Application::MainApplication::isArgGiven( "-local_port"))
+			if (Application::Commandline::isArgGiven( "-local_port"))
 			{
-				localPort = Application::MainApplication::getArg( "-local_port").value;
+				localPort = Application::Commandline::getArg( "-local_port").value;
 			}
 
 			Messaging::Client c1ient( 	"localhost",
@@ -387,13 +698,13 @@ namespace Model
 			Model::RobotPtr robot = Model::RobotWorld::getRobotWorld().getRobot( "Robot");
 			if(robot)
 				{
-				if (Application::MainApplication::isArgGiven( "-remote_ip"))
+				if (Application::Commandline::isArgGiven( "-remote_ip"))
 				{
-					remoteIpAdres = Application::MainApplication::getArg( "-remote_ip").value;
+					remoteIpAdres = Application::Commandline::getArg( "-remote_ip").value;
 				}
-				if (Application::MainApplication::isArgGiven( "-remote_port"))
+				if (Application::Commandline::isArgGiven( "-remote_port"))
 				{
-					remotePort = Application::MainApplication::getArg( "-remote_port").value;
+					remotePort = Application::Commandline::getArg( "-remote_port").value;
 				}
 
 				// We will request an echo message. The response will be "Hello World", if all goes OK,
@@ -420,13 +731,13 @@ namespace Model
 			Model::RobotPtr robot = Model::RobotWorld::getRobotWorld().getRobot( "Robot");
 			if(robot)
 				{
-				if (Application::MainApplication::isArgGiven( "-remote_ip"))
+				if (Application::Commandline::isArgGiven( "-remote_ip"))
 				{
-					remoteIpAdres = Application::MainApplication::getArg( "-remote_ip").value;
+					remoteIpAdres = Application::Commandline::getArg( "-remote_ip").value;
 				}
-				if (Application::MainApplication::isArgGiven( "-remote_port"))
+				if (Application::Commandline::isArgGiven( "-remote_port"))
 				{
-					remotePort = Application::MainApplication::getArg( "-remote_port").value;
+					remotePort = Application::Commandline::getArg( "-remote_port").value;
 				}
 
 				// We will request an echo message. The response will be "Hello World", if all goes OK,
@@ -450,13 +761,13 @@ namespace Model
 			Model::RobotPtr robot = Model::RobotWorld::getRobotWorld().getRobot( "Robot");
 			if(robot)
 				{
-				if (Application::MainApplication::isArgGiven( "-remote_ip"))
+				if (Application::Commandline::isArgGiven( "-remote_ip"))
 				{
-					remoteIpAdres = Application::MainApplication::getArg( "-remote_ip").value;
+					remoteIpAdres = Application::Commandline::getArg( "-remote_ip").value;
 				}
-				if (Application::MainApplication::isArgGiven( "-remote_port"))
+				if (Application::Commandline::isArgGiven( "-remote_port"))
 				{
-					remotePort = Application::MainApplication::getArg( "-remote_port").value;
+					remotePort = Application::Commandline::getArg( "-remote_port").value;
 				}
 
 				// We will request an echo message. The response will be "Hello World", if all goes OK,
@@ -480,13 +791,13 @@ namespace Model
 			Model::RobotPtr robot = Model::RobotWorld::getRobotWorld().getRobot( "Robot");
 			if(robot)
 				{
-				if (Application::MainApplication::isArgGiven( "-remote_ip"))
+				if (Application::Commandline::isArgGiven( "-remote_ip"))
 				{
-					remoteIpAdres = Application::MainApplication::getArg( "-remote_ip").value;
+					remoteIpAdres = Application::Commandline::getArg( "-remote_ip").value;
 				}
-				if (Application::MainApplication::isArgGiven( "-remote_port"))
+				if (Application::Commandline::isArgGiven( "-remote_port"))
 				{
-					remotePort = Application::MainApplication::getArg( "-remote_port").value;
+					remotePort = Application::Commandline::getArg( "-remote_port").value;
 				}
 
 				// We will request an echo message. The response will be "Hello World", if all goes OK,
@@ -509,13 +820,13 @@ namespace Model
 			Model::RobotPtr robot = Model::RobotWorld::getRobotWorld().getRobot( "Robot");
 			if(robot)
 				{
-				if (Application::MainApplication::isArgGiven( "-remote_ip"))
+				if (Application::Commandline::isArgGiven( "-remote_ip"))
 				{
-					remoteIpAdres = Application::MainApplication::getArg( "-remote_ip").value;
+					remoteIpAdres = Application::Commandline::getArg( "-remote_ip").value;
 				}
-				if (Application::MainApplication::isArgGiven( "-remote_port"))
+				if (Application::Commandline::isArgGiven( "-remote_port"))
 				{
-					remotePort = Application::MainApplication::getArg( "-remote_port").value;
+					remotePort = Application::Commandline::getArg( "-remote_port").value;
 				}
 
 				// We will request an echo message. The response will be "Hello World", if all goes OK,
@@ -533,19 +844,15 @@ namespace Model
 	}
 	void Robot::handleNotification()
 	{
-		//	std::unique_lock<std::recursive_mutex> lock(robotMutex);
-
-		static int update = 0;
-		if ((++update % 200) == 0)
-		{
-			notifyObservers();
-		}
+		// The planners only notify when they published a new snapshot of their search
+		notifyObservers();
 	}
 	/**
 	 *
 	 */
 	void Robot::handleRequest( Messaging::Message& aMessage)
 	{
+		recordEvent( "request " + std::to_string( aMessage.getMessageType()));
 		switch(aMessage.getMessageType())
 		{
 			case SyncRequest:
@@ -695,6 +1002,7 @@ namespace Model
 	 */
 	void Robot::handleResponse( const Messaging::Message& aMessage)
 	{
+		recordEvent( "response " + std::to_string( aMessage.getMessageType()));
 		switch(aMessage.getMessageType())
 		{
 			case SyncResponse:
@@ -788,29 +1096,43 @@ namespace Model
 	 */
 	#pragma endregion
 	
-	void Robot::drive()
+	bool Robot::drive()
 	{
 		try
 		{
-			for (std::shared_ptr< AbstractSensor > sensor : sensors)
-			{
-				sensor->setOn(10);
-			}
+			const Size worldSize = RobotWorld::getRobotWorld().getWorldSize();
 
-			if (speed == 0.0)
+			// The Robot drives from path[pathPoint] to path[pathPoint + 1] and has done segmentStep
+			// of the pixel steps of that segment. A route of cells has segments of one step, an
+			// any-angle route has long straight segments between its waypoints.
+			if (position.x > 0 && position.x < worldSize.x && position.y > 0 && position.y < worldSize.y && pathPoint + 1 < path.size())
 			{
-				speed = 1.0;
-			}
+				bool reachedWaypoint = false;
+				for (int stepsLeft = static_cast< int >( speed); stepsLeft > 0 && pathPoint + 1 < path.size(); --stepsLeft)
+				{
+					const PathAlgorithm::Vertex& from = path[pathPoint];
+					const PathAlgorithm::Vertex& to = path[pathPoint + 1];
+					int numberOfSteps = std::max( std::abs( to.x - from.x), std::abs( to.y - from.y));
 
-			unsigned pathPoint = 0;
-				
-			while (position.x > 0 && position.x < 500 && position.y > 0 && position.y < 500 && pathPoint < path.size())
-			{
-				const PathAlgorithm::Vertex& vertex = path[pathPoint+=speed];
-				front = BoundedVector( vertex.asPoint(), position);
-				position.x = vertex.x;
-				position.y = vertex.y;
-				BroadcastPostion();
+					front = BoundedVector( to.asPoint(), position);
+					if (++segmentStep >= numberOfSteps)
+					{
+						position.x = to.x;
+						position.y = to.y;
+						++pathPoint;
+						segmentStep = 0;
+						reachedWaypoint = true;
+					} else
+					{
+						position.x = from.x + static_cast< int >( std::lround( static_cast< double >( to.x - from.x) * segmentStep / numberOfSteps));
+						position.y = from.y + static_cast< int >( std::lround( static_cast< double >( to.y - from.y) * segmentStep / numberOfSteps));
+					}
+				}
+				updatePose();
+				if (reachedWaypoint)
+				{
+					BroadcastPostion();
+				}
 
 				if (arrived(goal) && win){
 					drivingAllowed();
@@ -818,7 +1140,7 @@ namespace Model
 					win = false;
 				} 
 
-				if(arrived(startPosition)&& droveBack)
+				if(droveBack && (arrived(startPosition) || arrived(goal)))
 				{
 					drivingAllowed();
 					notifyObservers();
@@ -826,15 +1148,10 @@ namespace Model
 					driving = false;
 				}
 
-				if(perceptQueue.size() > 0)
-				{	
-					std::shared_ptr<CollisionPercept> CP = std::dynamic_pointer_cast<CollisionPercept>(perceptQueue.dequeue());
-					if(CP->collision && !masterDeterminated)
-					{
-						haltDriving();
-						negotiate();
-					}
-
+				if(handlePercepts() && !masterDeterminated)
+				{
+					haltDriving();
+					negotiate();
 				}
 				if (arrived(goal) || collision())
 				{
@@ -844,22 +1161,22 @@ namespace Model
 					{
 						masterDeterminated = false;
 					}
-					break;
-				}
-
-
-
-
-
-				notifyObservers();
-
-				std::this_thread::sleep_for( std::chrono::milliseconds(10));
-				// this should be the last thing in the loop
-				if(driving == false)
+				} else
 				{
-					return;
+					notifyObservers();
+
+					if (improvingRoute)
+					{
+						// The anytime planner improves the route a little every tick, so the next tick is not delayed
+						if (improveRoute( pathPoint))
+						{
+							pathPoint = 0;
+							segmentStep = 0;
+						}
+					}
+					return driving;
 				}
-			} // while
+			}
 
 			for (std::shared_ptr< AbstractSensor > sensor : sensors)
 			{
@@ -874,6 +1191,7 @@ namespace Model
 		{
 			std::cerr << __PRETTY_FUNCTION__ << ": unknown exception" << std::endl;
 		}
+		return false;
 	}
 
 	void Robot::fillWorld(std::string messageBody)
@@ -929,31 +1247,286 @@ namespace Model
 		}
 	notifyObservers();
 	}
+	/**
+	 *
+	 */
+	const PathAlgorithm::OccupancyGrid& Robot::getOccupancyGrid() const
+	{
+		switch (pathPlanner)
+		{
+			case JumpPointSearchPlanner:
+				return jumpPointSearch.getOccupancyGrid();
+			case DStarLitePlanner:
+				return dStarLite.getOccupancyGrid();
+			case HPAStarPlanner:
+				return hpaStar.getOccupancyGrid();
+			case CooperativePlanner:
+				return cooperativeAStar.getOccupancyGrid();
+			case AnytimePlanner:
+				return anytimeAStar.getOccupancyGrid();
+			default:
+				return astar.getOccupancyGrid();
+		}
+	}
+	/**
+	 * The Robot is somewhere between path[aPathPoint] and path[aPathPoint + 1]. It joins an improved
+	 * route at the waypoint of that route nearest to it, if it can drive there in a straight line
+	 * and the rest of the improved route is shorter than the rest of path.
+	 */
+	bool Robot::improveRoute( unsigned aPathPoint)
+	{
+		// Without the wall clock there is no time left in a tick, a fixed number of expansions then
+		// improves the route as much in every run
+		const Scheduler& scheduler = Scheduler::getScheduler();
+		PathAlgorithm::Path improvedPath;
+		bool improved = scheduler.isRealTime() && !scheduler.isDeterministic() ? anytimeAStar.improve( improvedPath, scheduler.getTimeLeftInTick()) : anytimeAStar.improve( improvedPath, AnytimeExpansionsPerTick);
+		improvingRoute = !anytimeAStar.isFinished();
+		if (!improved || aPathPoint + 1 >= path.size())
+		{
+			return false;
+		}
+		if (anyAngle)
+		{
+			improvedPath = PathAlgorithm::PathSmoother::smooth( improvedPath, anytimeAStar.getOccupancyGrid());
+		}
+
+		// The actualCost of a Vertex of a route is the length of the route up to that Vertex
+		const PathAlgorithm::Vertex here( position);
+		std::size_t nearest = 0;
+		long nearestDistance = std::numeric_limits< long >::max();
+		for (std::size_t i = 0; i < improvedPath.size(); ++i)
+		{
+			long dx = improvedPath[i].x - here.x;
+			long dy = improvedPath[i].y - here.y;
+			if (dx * dx + dy * dy < nearestDistance)
+			{
+				nearestDistance = dx * dx + dy * dy;
+				nearest = i;
+			}
+		}
+		const PathAlgorithm::Vertex& next = path[aPathPoint + 1];
+		double remaining = std::hypot( next.x - here.x, next.y - here.y) + path.back().actualCost - next.actualCost;
+		double improvedRemaining = std::sqrt( static_cast< double >( nearestDistance)) + improvedPath.back().actualCost - improvedPath[nearest].actualCost;
+		if (improvedRemaining >= remaining || !anytimeAStar.getOccupancyGrid().isLineFree( here, improvedPath[nearest]))
+		{
+			return false;
+		}
+
+		PathAlgorithm::Path newPath;
+		newPath.reserve( improvedPath.size() - nearest + 1);
+		newPath.push_back( here);
+		newPath.insert( newPath.end(), improvedPath.begin() + nearest, improvedPath.end());
+		path.swap( newPath);
+		return true;
+	}
 	/**
 	 *
 	 */
 	void Robot::calculateRoute(GoalPtr aGoal)
 	{
 		path.clear();
+		improvingRoute = false;
 		if (aGoal)
 		{
 			// Turn off logging if not debugging AStar
 			Application::Logger::setDisable();
 
 			front = BoundedVector( aGoal->getPosition(), position);
-			handleNotificationsFor( astar);
-			path = astar.search( position, aGoal->getPosition(), size);
-			stopHandlingNotificationsFor( astar);
+			updatePose();
+
+			// A cooperative route is only valid at the time it was planned, it is never cached
+			const bool cooperative = pathPlanner == CooperativePlanner;
+
+			// The version is taken before the search, a route planned while the walls changed is never found
+			PathAlgorithm::RouteCache::Key key{	PathAlgorithm::Vertex( position),
+												PathAlgorithm::Vertex( aGoal->getPosition()),
+												PathAlgorithm::AStar::freeRadius( size),
+												RobotWorld::getRobotWorld().getWallVersion(),
+												pathPlanner,
+												anyAngle,
+												name};
+			// The flow field only knows the walls, the other planners avoided the robots where they were then
+			std::function< bool( const PathAlgorithm::Path&) > isFreeOfRobots;
+			if (pathPlanner != FlowFieldPlanner)
+			{
+				isFreeOfRobots = [this]( const PathAlgorithm::Path& aPath)
+				{
+					return PathAlgorithm::AStar::isFreeOfRobots( aPath, PathAlgorithm::AStar::freeRadius( size), name);
+				};
+			}
+			if (!cooperative && PathAlgorithm::RouteCache::getRouteCache().find( key, path, isFreeOfRobots))
+			{
+				Application::Logger::setDisable( false);
+				return;
+			}
+
+			switch (pathPlanner)
+			{
+				case JumpPointSearchPlanner:
+				{
+					handleNotificationsFor( jumpPointSearch);
+					path = jumpPointSearch.search( position, aGoal->getPosition(), size);
+					stopHandlingNotificationsFor( jumpPointSearch);
+					break;
+				}
+				case DStarLitePlanner:
+				{
+					// Replanning to the same goal, e.g. after a negotiation, only repairs the previous search
+					handleNotificationsFor( dStarLite);
+					path = dStarLite.search( position, aGoal->getPosition(), size);
+					stopHandlingNotificationsFor( dStarLite);
+					break;
+				}
+				case HPAStarPlanner:
+				{
+					handleNotificationsFor( hpaStar);
+					path = hpaStar.search( position, aGoal->getPosition(), size);
+					stopHandlingNotificationsFor( hpaStar);
+					break;
+				}
+				case CooperativePlanner:
+				{
+					// The route that was planned with the other Robots is reserved from the tick it starts in
+					if (!cooperativeRoute.empty() && cooperativeRouteTick == PathAlgorithm::ReservationTable::getCurrentTick())
+					{
+						path.swap( cooperativeRoute);
+					} else
+					{
+						path = cooperativeAStar.search( name, position, aGoal->getPosition(), size, PathAlgorithm::ReservationTable::getReservationTable());
+					}
+					cooperativeRoute.clear();
+					if (path.empty())
+					{
+						// Without a cooperative route the Robot drives the route of AStar and negotiates on a collision
+						handleNotificationsFor( astar);
+						astar.search( position, aGoal->getPosition(), size, path);
+						stopHandlingNotificationsFor( astar);
+					}
+					break;
+				}
+				case AnytimePlanner:
+				{
+					// The Robot starts driving the best route found within the budget, drive keeps improving it.
+					// A deterministic run can not depend on how fast the computer is, it starts with the first route.
+					handleNotificationsFor( anytimeAStar);
+					path = anytimeAStar.search( position, aGoal->getPosition(), size, Scheduler::getScheduler().isDeterministic() ? std::chrono::milliseconds( 0) : anytimeBudget);
+					stopHandlingNotificationsFor( anytimeAStar);
+					improvingRoute = !anytimeAStar.isFinished();
+					break;
+				}
+				case BidirectionalPlanner:
+				{
+					handleNotificationsFor( astar);
+					astar.searchBidirectional( position, aGoal->getPosition(), size, path);
+					stopHandlingNotificationsFor( astar);
+					break;
+				}
+				case FlowFieldPlanner:
+				{
+					// All robots that drive to aGoal share the field, only the first one searches
+					flowField = &PathAlgorithm::FlowField::getFlowField( aGoal->getPosition(), size);
+					path = anyAngle ? flowField->getSmoothPath( position) : flowField->getPath( position);
+					break;
+				}
+				default:
+				{
+					// All robots share the workers of the PlanningService, the worker also smooths the route
+					plannedRoute = PathAlgorithm::PlanningService::getPlanningService().plan( position, aGoal->getPosition(), size, name, anyAngle);
+					plannedRouteKey.reset( new PathAlgorithm::RouteCache::Key( key));
+					Application::Logger::setDisable( false);
+					return;
+				}
+			}
+			// Smoothing would remove the waits of a cooperative route, the FlowField smooths its own route
+			if (anyAngle && !cooperative && pathPlanner != FlowFieldPlanner)
+			{
+				path = PathAlgorithm::PathSmoother::smooth( path, getOccupancyGrid());
+			}
+			// A route that is still being improved is not cached, the next search may find a shorter one
+			if (!cooperative && !improvingRoute && !path.empty())
+			{
+				PathAlgorithm::RouteCache::getRouteCache().insert( key, path);
+			}
 
 			Application::Logger::setDisable( false);
 		}
 	}
+	/**
+	 * The tour is not smoothed, smoothing would cut the corners at the WayPoints
+	 */
+	void Robot::calculateTour(GoalPtr aGoal)
+	{
+		path.clear();
+		improvingRoute = false;
+		if (aGoal)
+		{
+			front = BoundedVector( aGoal->getPosition(), position);
+			updatePose();
+
+			std::vector< Point > wayPoints;
+			for (WayPointPtr wayPoint : RobotWorld::getRobotWorld().getWayPoints())
+			{
+				wayPoints.push_back( wayPoint->getPosition());
+			}
+
+			// The legs between all pairs of stops grow with the square of the number of WayPoints
+			PathAlgorithm::TourPlanner tourPlanner;
+			if (wayPoints.size() <= PathAlgorithm::TourPlanner::MaximumPairedWayPoints)
+			{
+				path = tourPlanner.plan( position, wayPoints, aGoal->getPosition(), size, name);
+			} else
+			{
+				path = tourPlanner.planNearest( position, wayPoints, aGoal->getPosition(), size, name);
+			}
+		}
+	}
+	/**
+	 * The Robot that is sent back makes way for the other Robot, it does not matter whether it
+	 * drives back to its start position or on to its goal. One search of the AStar finds the
+	 * nearest of the two that can be reached, whatever the planner of the Robot is.
+	 */
+	void Robot::calculateRouteBack()
+	{
+		path.clear();
+		improvingRoute = false;
+
+		std::vector< PathAlgorithm::Vertex > goals;
+		for (GoalPtr aGoal : { startPosition, goal})
+		{
+			if (aGoal)
+			{
+				goals.push_back( PathAlgorithm::Vertex( aGoal->getPosition()));
+			}
+		}
+		if (goals.empty())
+		{
+			return;
+		}
+
+		// Turn off logging if not debugging AStar
+		Application::Logger::setDisable();
+
+		handleNotificationsFor( astar);
+		astar.search( position, goals, size, path);
+		stopHandlingNotificationsFor( astar);
+		if (!path.empty())
+		{
+			front = BoundedVector( path.back().asPoint(), position);
+			updatePose();
+		}
+		if (anyAngle)
+		{
+			path = PathAlgorithm::PathSmoother::smooth( path, astar.getOccupancyGrid());
+		}
+
+		Application::Logger::setDisable( false);
+	}
 	/**
 	 *
 	 */
 	bool Robot::arrived(GoalPtr aGoal)
 	{
-		if (aGoal && intersects( aGoal->getRegion()))
+		if (aGoal && intersects( *aGoal))
 		{
 			return true;
 		}
@@ -964,13 +1537,17 @@ namespace Model
 	 */
 	bool Robot::collision()
 	{
-		Point frontLeft = getFrontLeft();
-		Point frontRight = getFrontRight();
-		Point backLeft = getBackLeft();
-		Point backRight = getBackRight();
-
-		const std::vector< WallPtr >& walls = RobotWorld::getRobotWorld().getWalls();
-		for (WallPtr wall : walls)
+		const Pose currentPose = getPose();
+		const Point& frontLeft = currentPose.frontLeft;
+		const Point& frontRight = currentPose.frontRight;
+		const Point& backLeft = currentPose.backLeft;
+		const Point& backRight = currentPose.backRight;
+
+		// The tree owns the walls it returns, it has to live as long as they are used
+		std::shared_ptr< const WallTree > wallTree = RobotWorld::getRobotWorld().getWallTree();
+		std::vector< const Wall* > walls;
+		wallTree->findWalls( currentPose.topLeft, currentPose.bottomRight, walls);
+		for (const Wall* wall : walls)
 		{
 			if (Utils::Shape2DUtils::intersect( frontLeft, frontRight, wall->getPoint1(), wall->getPoint2()) ||
 							Utils::Shape2DUtils::intersect( frontLeft, backLeft, wall->getPoint1(), wall->getPoint2())	||
@@ -3,21 +3,32 @@
 
 #include "Config.hpp"
 
+#include <chrono>
+#include <atomic>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <mutex>
+#include <random>
 #include <string>
 #include <thread>
 
 #include "AbstractAgent.hpp"
+#include "AnytimeAStar.hpp"
 #include "AStar.hpp"
 #include "BoundedVector.hpp"
+#include "CooperativeAStar.hpp"
+#include "DStarLite.hpp"
+#include "FlowField.hpp"
+#include "HPAStar.hpp"
+#include "JumpPointSearch.hpp"
 #include "Message.hpp"
 #include "MessageHandler.hpp"
 #include "Observer.hpp"
 #include "Point.hpp"
+#include "RouteCache.hpp"
 #include "Size.hpp"
-#include "Region.hpp"
+#include "Scheduler.hpp"
 #include <boost/algorithm/string.hpp>
 
 namespace Messaging
@@ -33,6 +44,10 @@ namespace Model
 	class Goal;
 	typedef std::shared_ptr<Goal> GoalPtr;
 
+	class WayPoint;
+
+	class DistanceScanPercept;
+
 	class Robot :	public AbstractAgent,
 					public Messaging::MessageHandler,
 					public Base::Observer
@@ -114,9 +129,20 @@ namespace Model
 			{
 				return acting;
 			}
+			/**
+			 * The numbers of a Robot only depend on the seed and its name, not on where it is or on
+			 * the other Robots
+			 *
+			 * @return A number from 1 up to and including N
+			 */
 			int randomNumberBetweenUpToN(int N =100 );
 			/**
 			 *
+			 * @return The seed given with the "-seed" command line argument, 0 if not given
+			 */
+			static unsigned long getDefaultSeed();
+			/**
+			 * Lets the Scheduler step the Robot until it stopped driving
 			 */
 			virtual void startActing();
 			/**
@@ -161,14 +187,47 @@ namespace Model
 			 *
 			 */
 			void stopCommunicating();
+			/**
+			 * The oriented bounding box of the Robot, computed when its position, front or size changes
+			 */
+			struct Pose
+			{
+					Point frontLeft;
+					Point frontRight;
+					Point backLeft;
+					Point backRight;
+					/**
+					 * The cosine and sine of the angle the corners are rotated by, the angle of front plus a quarter turn
+					 */
+					double cosine;
+					double sine;
+					/**
+					 * The unit vector in the direction of front
+					 */
+					double headingX;
+					double headingY;
+					/**
+					 * The axis aligned bounding box of the corners
+					 */
+					Point topLeft;
+					Point bottomRight;
+			};
+			/**
+			 * Never waits for the Robot, the pose is copied again if the Robot changed it while it was copied
+			 *
+			 * @return The pose of the current position, front and size
+			 */
+			Pose getPose() const;
 			/**
 			 *
+			 * @return True if the oriented bounding box of the Robot overlaps the rectangle of aWayPoint
 			 */
-			Region getRegion() const;
+			bool intersects( const WayPoint& aWayPoint) const;
 			/**
 			 *
+			 * @return True if the oriented bounding boxes of the Robots overlap
 			 */
-			bool intersects( const Region& aRegion) const;
+			bool intersects( const Robot& aRobot) const;
 			/**
 			 *
 			 */
@@ -205,12 +264,142 @@ namespace Model
 			 */
 			virtual void handleNotification();
 			//@}
+			/**
+			 * The algorithms a Robot can use to calculate its route
+			 */
+			enum PathPlanner
+			{
+				AStarPlanner,
+				JumpPointSearchPlanner,
+				/**
+				 * Keeps its search between routes to the same goal and only repairs it for the changes in the world
+				 */
+				DStarLitePlanner,
+				/**
+				 * Searches a graph of the entrances between clusters of the world, for very large worlds
+				 */
+				HPAStarPlanner,
+				/**
+				 * Plans in space and time around the routes the other robots reserved, see PathAlgorithm::CooperativeAStar
+				 */
+				CooperativePlanner,
+				/**
+				 * Starts driving a route that may be longer than the shortest route within a time budget
+				 * and improves it while driving, see PathAlgorithm::AnytimeAStar
+				 */
+				AnytimePlanner,
+				/**
+				 * AStar searching from both ends, see PathAlgorithm::AStar::searchBidirectional
+				 */
+				BidirectionalPlanner,
+				/**
+				 * Follows a field of the costs to the goal that all robots with the same goal share, see PathAlgorithm::FlowField
+				 */
+				FlowFieldPlanner
+			};
+			/**
+			 *
+			 */
+			PathPlanner getPathPlanner() const
+			{
+				return pathPlanner;
+			}
+			/**
+			 *
+			 */
+			void setPathPlanner( PathPlanner aPathPlanner)
+			{
+				pathPlanner = aPathPlanner;
+			}
+			/**
+			 *
+			 * @return The planner given with the "-planner" command line argument ("astar", "jps", "dstarlite", "hpa", "cooperative", "anytime", "bidirectional" or "flowfield"), AStarPlanner if not given
+			 */
+			static PathPlanner getDefaultPathPlanner();
+			/**
+			 * The default time in milliseconds the anytime planner may take before the Robot starts driving
+			 */
+			static const int DefaultAnytimeBudget = 20;
+			/**
+			 * The number of cells the anytime planner expands every tick to improve the route if the
+			 * Scheduler does not wait for the wall clock, a tick then has no time left to measure
+			 */
+			static const std::size_t AnytimeExpansionsPerTick = 1000;
+			/**
+			 *
+			 * @return The budget given with the "-anytime_budget" command line argument in milliseconds, DefaultAnytimeBudget if not given
+			 */
+			static std::chrono::milliseconds getDefaultAnytimeBudget();
+			/**
+			 *
+			 */
+			std::chrono::milliseconds getAnytimeBudget() const
+			{
+				return anytimeBudget;
+			}
+			/**
+			 *
+			 */
+			void setAnytimeBudget( std::chrono::milliseconds anAnytimeBudget)
+			{
+				anytimeBudget = anAnytimeBudget;
+			}
+			/**
+			 *
+			 */
+			bool isAnyAngle() const
+			{
+				return anyAngle;
+			}
+			/**
+			 * If true the route of the planner is reduced to the waypoints where the Robot has to turn
+			 * and the Robot drives in straight lines between them
+			 */
+			void setAnyAngle( bool anAnyAngle)
+			{
+				anyAngle = anAnyAngle;
+			}
+			/**
+			 *
+			 */
+			bool isWayPointTour() const
+			{
+				return wayPointTour;
+			}
+			/**
+			 * If true the Robot visits all WayPoints of the RobotWorld in the shortest order it can find
+			 * before it drives to its goal
+			 */
+			void setWayPointTour( bool aWayPointTour)
+			{
+				wayPointTour = aWayPointTour;
+			}
+			/**
+			 *
+			 */
+			/**
+			 * Lets the planners publish snapshots of their searches for getOpenSet
+			 */
+			void enableSearchProgress( bool anEnable = true);
 			/**
 			 *
 			 */
 			PathAlgorithm::OpenSet getOpenSet() const
 			{
-				return astar.getOpenSet();
+				switch (pathPlanner)
+				{
+					case JumpPointSearchPlanner:
+						return jumpPointSearch.getOpenSet();
+					case DStarLitePlanner:
+						return dStarLite.getOpenSet();
+					case AnytimePlanner:
+						return anytimeAStar.getOpenSet();
+					case HPAStarPlanner:
+						// The abstract search has no openSet to show, show the entrances it expanded
+						return hpaStar.getClosedSet();
+					default:
+						return astar.getOpenSet();
+				}
 			}
 			/**
 			 *
@@ -219,6 +408,19 @@ namespace Model
 			{
 				return path;
 			}
+			/**
+			 * Gives the Robot the route that was planned for it together with the other Robots, see
+			 * RobotWorld::startRobots. The CooperativePlanner drives it if the Robot plans its route in
+			 * aStartTick, otherwise the Robot plans its own route around the reservations of the others.
+			 */
+			void setCooperativeRoute(	const PathAlgorithm::Path& aPath,
+										long aStartTick);
+			/**
+			 * A Robot gets a LaserDistanceSensor with the "-laser" command line argument, it scans once every tick while the Robot drives
+			 *
+			 * @return The last full scan of the LaserDistanceSensor, nullptr if the Robot has none or did not scan yet
+			 */
+			std::shared_ptr< const DistanceScanPercept > getLaserScan() const;
 			virtual void BroadcastPostion();
 			/**
 			 * @name Messaging::MessageHandler functions
@@ -294,13 +496,23 @@ namespace Model
 
 		protected:
 			/**
+			 * Drives speed pixel steps along path, one tick of the Robot
 			 *
+			 * @return False if the Robot arrived, collided or stopped driving
 			 */
-			void drive();
+			bool drive();
 			/**
 			 *
 			 */
 			void calculateRoute(GoalPtr aGoal);
+			/**
+			 * Plans the route along all WayPoints to aGoal, see PathAlgorithm::TourPlanner
+			 */
+			void calculateTour(GoalPtr aGoal);
+			/**
+			 * Plans the route of a Robot that is sent back to the nearest of its start position and its goal
+			 */
+			void calculateRouteBack();
 			/**
 			 *
 			 */
@@ -310,15 +522,106 @@ namespace Model
 			 */
 			bool collision();
 		private:
+			/**
+			 *
+			 * @return The occupancy grid of the last search of the selected planner, never the grid of a FlowField that other robots share
+			 */
+			const PathAlgorithm::OccupancyGrid& getOccupancyGrid() const;
+			/**
+			 * Lets the anytime planner improve the route in the time that is left of this tick, or
+			 * with AnytimeExpansionsPerTick expansions if the Scheduler does not wait for the wall clock
+			 *
+			 * @return True if path was replaced by a shorter route that starts at the position of the Robot
+			 */
+			bool improveRoute( unsigned aPathPoint);
 			void restartDriving();
+			/**
+			 * Plans the route to the goal, or back to the start position. A route of the AStarPlanner
+			 * is planned by the PlanningService, the Robot has no route until takePlannedRoute.
+			 */
+			void planRoute();
+			/**
+			 * Takes the route of the PlanningService, caches it and calls routePlanned
+			 */
+			void takePlannedRoute();
+			/**
+			 * Records the route and sends the other Robot back if the goal can not be reached
+			 */
+			void routePlanned();
+			/**
+			 * The task of the Robot in the Scheduler: plans the route if startDriving asked for it and drives one tick
+			 *
+			 * @return False if the Robot stopped driving
+			 */
+			bool step();
 			void fillWorld(std::string messageBody);
+			/**
+			 * Records anEvent of this Robot in the EventLog if it is recording or replaying
+			 */
+			void recordEvent( const std::string& anEvent) const;
+			/**
+			 * Seeds randomGenerator with the default seed and the name of the Robot
+			 */
+			void seedRandomGenerator();
+			/**
+			 * Gives the planners the name of the Robot, a Robot is not an obstacle for its own routes
+			 */
+			void namePlanners();
+			/**
+			 * Attaches the ProximitySensor and, with the "-laser" command line argument, the LaserDistanceSensor
+			 */
+			void attachSensors();
+			/**
+			 * Handles all percepts the sensors sent since the last tick
+			 *
+			 * @return True if the ProximitySensor perceived a collision
+			 */
+			bool handlePercepts();
+			/**
+			 * Computes the pose of position, front and size, must be called after they changed.
+			 * The Robot is an obstacle for the other Robots, so the RobotWorld gets a new geometry version.
+			 */
+			void updatePose();
 			std::string name;
 
 			float speed;
 
 			GoalPtr goal;
+			PathPlanner pathPlanner;
+			bool anyAngle;
+			std::chrono::milliseconds anytimeBudget;
+			/**
+			 * True while the anytime planner has not found the shortest route to the goal of path
+			 */
+			bool improvingRoute;
+			bool wayPointTour;
 			PathAlgorithm::AStar astar;
+			PathAlgorithm::JumpPointSearch jumpPointSearch;
+			PathAlgorithm::DStarLite dStarLite;
+			PathAlgorithm::HPAStar hpaStar;
+			PathAlgorithm::CooperativeAStar cooperativeAStar;
+			PathAlgorithm::AnytimeAStar anytimeAStar;
+			/**
+			 * The shared field of the last route of the FlowFieldPlanner, nullptr before that route
+			 */
+			PathAlgorithm::FlowField* flowField;
 			PathAlgorithm::Path path;
+			/**
+			 * The route a worker of the PlanningService is planning and the key it is cached under,
+			 * plannedRoute is not valid if no route is being planned
+			 */
+			std::future< PathAlgorithm::Path > plannedRoute;
+			std::unique_ptr< PathAlgorithm::RouteCache::Key > plannedRouteKey;
+			/**
+			 * The route of setCooperativeRoute and the tick it starts in, empty once the Robot planned
+			 */
+			PathAlgorithm::Path cooperativeRoute;
+			long cooperativeRouteTick;
+			/**
+			 * Where the Robot is on path, see drive
+			 */
+			unsigned pathPoint;
+			int segmentStep;
 			GoalPtr startPosition;
 
 			bool acting;
@@ -328,7 +631,25 @@ namespace Model
 			bool win =  false;
 			bool droveBack = false;
 
-			std::thread robotThread;
+			/**
+			 * The task that steps the Robot, routeNeeded is set if the next step must plan the route first.
+			 * Both are guarded by robotMutex.
+			 */
+			Scheduler::TaskId drivingTask;
+			bool routeNeeded;
+			/**
+			 * Guarded by robotMutex, see randomNumberBetweenUpToN
+			 */
+			std::mt19937 randomGenerator;
+			/**
+			 * Written by updatePose under robotMutex, poseVersion is odd while it is written
+			 */
+			Pose pose;
+			std::atomic< unsigned > poseVersion;
+			/**
+			 * Guarded by robotMutex
+			 */
+			std::shared_ptr< const DistanceScanPercept > laserScan;
 			mutable std::recursive_mutex robotMutex;
 	};
 } // namespace Model
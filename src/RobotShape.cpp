@@ -104,10 +104,12 @@ namespace View
 		PathAlgorithm::Path path = getRobot()->getPath();
 		if (path.size() != 0)
 		{
+			// Lines instead of points, an any-angle route only consists of its waypoints
 			dc.SetPen( wxPen( WXSTRING( "BLACK"), borderWidth, wxSOLID));
-			for (const PathAlgorithm::Vertex& vertex : path)
+			dc.DrawPoint( path.front().asPoint());
+			for (std::size_t i = 1; i < path.size(); ++i)
 			{
-				dc.DrawPoint( vertex.asPoint());
+				dc.DrawLine( path[i - 1].asPoint(), path[i].asPoint());
 			}
 		}
 
@@ -121,7 +123,8 @@ namespace View
 			dc.SetPen( wxPen( WXSTRING( getNormalColour()), borderWidth, wxSOLID));
 		}
 
-		Point cornerPoints[] = { getRobot()->getFrontRight(), getRobot()->getFrontLeft(), getRobot()->getBackLeft(), getRobot()->getBackRight() };
+		const Model::Robot::Pose pose = getRobot()->getPose();
+		Point cornerPoints[] = { pose.frontRight, pose.frontLeft, pose.backLeft, pose.backRight };
 		dc.DrawPolygon( 4, cornerPoints);
 
 		dc.SetPen( wxPen( WXSTRING( "RED"), borderWidth, wxSOLID));
@@ -136,7 +139,7 @@ namespace View
 		double angle = Utils::Shape2DUtils::getAngle( getRobot()->getFront()) + 0.5 * Utils::PI;
 
 		dc.SetPen( wxPen( WXSTRING( "BLACK"), 1, wxSOLID));
-		dc.DrawLine( centre.x, centre.y, centre.x + std::cos( angle - 0.5 * Utils::PI) * 25, centre.y + std::sin( angle - 0.5 * Utils::PI) * 25);
+		dc.DrawLine( centre.x, centre.y, centre.x + pose.headingX * 25, centre.y + pose.headingY * 25);
 
 		// Bounty of 0.25 points for anyone who makes the name turn
 		// with the front of the robot, while text centre being displayed in the
@@ -148,7 +151,8 @@ namespace View
 	 */
 	bool RobotShape::occupies( const Point& aPoint) const
 	{
-		Point cornerPoints[] = { getRobot()->getFrontRight(), getRobot()->getFrontLeft(), getRobot()->getBackLeft(), getRobot()->getBackRight() };
+		const Model::Robot::Pose pose = getRobot()->getPose();
+		Point cornerPoints[] = { pose.frontRight, pose.frontLeft, pose.backLeft, pose.backRight };
 		return Utils::Shape2DUtils::isInsidePolygon( cornerPoints, 4, aPoint);
 	}
 	/**
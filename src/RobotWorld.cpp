@@ -1,10 +1,15 @@
 #include "RobotWorld.hpp"
+#include "CooperativeAStar.hpp"
 #include "Logger.hpp"
+#include "ReservationTable.hpp"
 #include "Robot.hpp"
+#include "Scheduler.hpp"
 #include "WayPoint.hpp"
 #include "Goal.hpp"
 #include "Wall.hpp"
+#include "WallTree.hpp"
 #include <algorithm>
+#include <iterator>
 
 namespace Model
 {
@@ -13,9 +18,24 @@ namespace Model
 	 */
 	/* static */RobotWorld& RobotWorld::RobotWorld::getRobotWorld()
 	{
+		// The Scheduler steps the Robots, it is created first so that it is destroyed after them
+		Scheduler::getScheduler();
 		static RobotWorld robotWorld;
 		return robotWorld;
 	}
+	/**
+	 *
+	 */
+	void RobotWorld::setWorldSize(	const Size& aWorldSize,
+									bool aNotifyObservers /*= true*/)
+	{
+		worldSize = aWorldSize;
+		incrementWallVersion();
+		if (aNotifyObservers == true)
+		{
+			notifyObservers();
+		}
+	}
 	/**
 	 *
 	 */
@@ -25,6 +45,9 @@ namespace Model
 	{
 		RobotPtr robot( new Robot( aName, aPosition));
 		robots.push_back( robot);
+		const Robot::Pose pose = robot->getPose();
+		collisionGrid.addRobot( robot.get(), pose.topLeft, pose.bottomRight);
+		incrementGeometryVersion();
 		if (aNotifyObservers == true)
 		{
 			notifyObservers();
@@ -70,6 +93,7 @@ namespace Model
 	{
 		WallPtr wall( new Wall( aPoint1, aPoint2));
 		walls.push_back( wall);
+		wallChanged();
 		if (aNotifyObservers == true)
 		{
 			notifyObservers();
@@ -88,7 +112,9 @@ namespace Model
 							   });
 		if (i != robots.end())
 		{
+			collisionGrid.removeRobot( i->get());
 			robots.erase( i);
+			incrementGeometryVersion();
 			if (aNotifyObservers == true)
 			{
 				notifyObservers();
@@ -149,6 +175,7 @@ namespace Model
 		if (i != walls.end())
 		{
 			walls.erase( i);
+			wallChanged();
 
 			if (aNotifyObservers == true)
 			{
@@ -156,6 +183,44 @@ namespace Model
 			}
 		}
 	}
+	/**
+	 * The routes are planned from the current tick, the tick of the first step of the Robots if no
+	 * tick is running, e.g. while the Scheduler is paused
+	 */
+	void RobotWorld::startRobots()
+	{
+		// The Robots are copied because starting them adds Goals to the RobotWorld
+		std::vector< RobotPtr > startingRobots;
+		std::copy_if( robots.begin(), robots.end(), std::back_inserter( startingRobots), []( RobotPtr aRobot){ return !aRobot->isActing();});
+
+		GoalPtr goal = getGoal( "Goal");
+		std::vector< PathAlgorithm::CooperativeAStar::Agent > agents;
+		std::vector< RobotPtr > cooperativeRobots;
+		for (RobotPtr robot : startingRobots)
+		{
+			// A Robot on a tour plans its own route along the WayPoints
+			if (goal && robot->getPathPlanner() == Robot::CooperativePlanner && !(robot->isWayPointTour() && !wayPoints.empty()))
+			{
+				agents.push_back( PathAlgorithm::CooperativeAStar::Agent{ robot->getName(), robot->getPosition(), goal->getPosition(), robot->getSize() });
+				cooperativeRobots.push_back( robot);
+			}
+		}
+		if (!agents.empty())
+		{
+			const long startTick = PathAlgorithm::ReservationTable::getCurrentTick();
+			PathAlgorithm::CooperativeAStar cooperativeAStar;
+			std::vector< PathAlgorithm::Path > paths = cooperativeAStar.search( agents, PathAlgorithm::ReservationTable::getReservationTable(), startTick);
+			for (std::size_t i = 0; i < cooperativeRobots.size(); ++i)
+			{
+				cooperativeRobots[i]->setCooperativeRoute( paths[i], startTick);
+			}
+		}
+
+		for (RobotPtr robot : startingRobots)
+		{
+			robot->startActing();
+		}
+	}
 	/**
 	 *
 	 */
@@ -283,6 +348,29 @@ namespace Model
 	{
 		return walls;
 	}
+	/**
+	 *
+	 */
+	std::shared_ptr< const WallTree > RobotWorld::getWallTree() const
+	{
+		std::lock_guard< std::mutex > lock( wallTreeMutex);
+		if (!wallTree)
+		{
+			wallTree = std::make_shared< const WallTree >( walls);
+		}
+		return wallTree;
+	}
+	/**
+	 *
+	 */
+	void RobotWorld::wallChanged()
+	{
+		{
+			std::lock_guard< std::mutex > lock( wallTreeMutex);
+			wallTree.reset();
+		}
+		incrementWallVersion();
+	}
 	/**
 	 *
 	 */
@@ -552,6 +640,8 @@ namespace Model
 		wayPoints.clear();
 		goals.clear();
 		walls.clear();
+		fillCollisionGrid();
+		incrementWallVersion();
 
 		if (aNotifyObservers)
 		{
@@ -612,12 +702,28 @@ namespace Model
 											}),
 							walls.end());
 		}
+		fillCollisionGrid();
+		incrementWallVersion();
 
 		if (aNotifyObservers)
 		{
 			notifyObservers();
 		}
 	}
+	/**
+	 *
+	 */
+	void RobotWorld::fillCollisionGrid()
+	{
+		collisionGrid.clear();
+		for (RobotPtr robot : robots)
+		{
+			const Robot::Pose pose = robot->getPose();
+			collisionGrid.addRobot( robot.get(), pose.topLeft, pose.bottomRight);
+		}
+		std::lock_guard< std::mutex > lock( wallTreeMutex);
+		wallTree.reset();
+	}
 	/**
 	 *
 	 */
@@ -672,7 +778,10 @@ namespace Model
 	/**
 	 *
 	 */
-	RobotWorld::RobotWorld()
+	RobotWorld::RobotWorld() :
+								worldSize( DefaultWorldSize, DefaultWorldSize),
+								geometryVersion( 0),
+								wallVersion( 0)
 	{
 	}
 	/**
@@ -2,9 +2,13 @@
 #define ROBOTWORLD_HPP_
 
 #include "Config.hpp"
+#include <atomic>
+#include <mutex>
 #include <vector>
+#include "CollisionGrid.hpp"
 #include "ModelObject.hpp"
 #include "Point.hpp"
+#include "Size.hpp"
 
 namespace Model
 {
@@ -20,6 +24,8 @@ namespace Model
 	class Wall;
 	typedef std::shared_ptr<Wall> WallPtr;
 
+	class WallTree;
+
 	class RobotWorld;
 	typedef std::shared_ptr<RobotWorld> RobotWorldPtr;
 
@@ -33,6 +39,53 @@ namespace Model
 			 *
 			 */
 			static RobotWorld& getRobotWorld();
+			/**
+			 * The width and height of the world if no other size is set
+			 */
+			static const int DefaultWorldSize = 500;
+			/**
+			 *
+			 */
+			Size getWorldSize() const
+			{
+				return worldSize;
+			}
+			/**
+			 *
+			 */
+			void setWorldSize(	const Size& aWorldSize,
+								bool aNotifyObservers = true);
+			/**
+			 * The version of the obstacles in the world, it changes every time a wall or a robot
+			 * is added, deleted, moved or resized. Planned routes are only valid for the version they were planned in.
+			 */
+			unsigned long getGeometryVersion() const
+			{
+				return geometryVersion;
+			}
+			/**
+			 * Gives the obstacles a new version, called by everything that changes the robots
+			 */
+			void incrementGeometryVersion()
+			{
+				++geometryVersion;
+			}
+			/**
+			 * The version of the walls and the size of the world, it does not change when a robot moves.
+			 * The routes in the RouteCache are kept per wall version.
+			 */
+			unsigned long getWallVersion() const
+			{
+				return wallVersion;
+			}
+			/**
+			 * Gives the walls and the obstacles a new version, called by everything that changes the walls
+			 */
+			void incrementWallVersion()
+			{
+				++wallVersion;
+				++geometryVersion;
+			}
 			/**
 			 *
 			 */
@@ -77,6 +130,13 @@ namespace Model
 			 */
 			void deleteWall( 	WallPtr aWall,
 								bool aNotifyObservers = true);
+			/**
+			 * Starts all Robots that are not acting. The Robots with the CooperativePlanner are planned
+			 * together first, in the order of the Robots, so that their routes do not conflict, see
+			 * Robot::setCooperativeRoute. A Robot that plans again later, e.g. after a negotiation,
+			 * plans its own route around the reservations of the others.
+			 */
+			void startRobots();
 			/**
 			 *
 			 */
@@ -121,6 +181,32 @@ namespace Model
 			 *
 			 */
 			const std::vector< WallPtr >& getWalls() const;
+			/**
+			 *
+			 * @return The Robots of the world by cell, the Robots keep it up to date when they move
+			 */
+			CollisionGrid& getCollisionGrid()
+			{
+				return collisionGrid;
+			}
+			/**
+			 *
+			 */
+			const CollisionGrid& getCollisionGrid() const
+			{
+				return collisionGrid;
+			}
+			/**
+			 * The tree is built on the first call after a Wall was added, deleted or moved, the
+			 * returned tree stays valid after that but does not see the later changes
+			 *
+			 * @return The Walls of the world in a bounding volume hierarchy
+			 */
+			std::shared_ptr< const WallTree > getWallTree() const;
+			/**
+			 * Called when a Wall is added, deleted or moved, the next getWallTree builds a new tree
+			 */
+			void wallChanged();
 			/**
 			 *
 			 */
@@ -174,6 +260,14 @@ namespace Model
 			virtual ~RobotWorld();
 
 		private:
+			/**
+			 * Adds all Robots to an empty collisionGrid and drops the wallTree
+			 */
+			void fillCollisionGrid();
+
+			Size worldSize;
+			std::atomic< unsigned long > geometryVersion;
+			std::atomic< unsigned long > wallVersion;
 			/**
 			 * The vectors are mutable to allow for lazy instantiation
 			 */
@@ -181,6 +275,12 @@ namespace Model
 			mutable std::vector< WayPointPtr > wayPoints;
 			mutable std::vector< GoalPtr > goals;
 			mutable std::vector< WallPtr > walls;
+			CollisionGrid collisionGrid;
+			/**
+			 * Built lazily by getWallTree, nullptr if the Walls changed since the last build
+			 */
+			mutable std::shared_ptr< const WallTree > wallTree;
+			mutable std::mutex wallTreeMutex;
 	};
 } // namespace Model
 #endif // ROBOTWORLD_HPP_
@@ -454,7 +454,7 @@ namespace View
 	 */
 	void RobotWorldCanvas::initialise()
 	{
-		SetMinSize( Size( RobotWorldCanvas::WorldSize, RobotWorldCanvas::WorldSize));
+		SetMinSize( Model::RobotWorld::getRobotWorld().getWorldSize());
 
 		notificationHandler = new Base::NotificationHandler< std::function< void( NotifyEvent&) > >( [this](NotifyEvent& anEvent){this->OnNotificationEvent(anEvent);});
 		PushEventHandler( notificationHandler);
@@ -1137,6 +1137,7 @@ namespace View
 	{
 		aRobotShape->setRobotWorldCanvas(this);
 		aRobotShape->handleNotificationsFor(*aRobotShape->getRobot());
+		aRobotShape->getRobot()->enableSearchProgress();
 		shapes.push_back( std::dynamic_pointer_cast< Shape >( aRobotShape));
 	}
 	/**
@@ -170,7 +170,6 @@ namespace View
 			 */
 			void unpopulate();
 
-			static const int WorldSize = 500;
 		protected:
 			/**
 			 * Common initialise function
@@ -0,0 +1,164 @@
+#include "RouteCache.hpp"
+
+#include <functional>
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	bool RouteCache::Key::operator==( const Key& aKey) const
+	{
+		return start.equalPoint( aKey.start) && goal.equalPoint( aKey.goal) && radius == aKey.radius && version == aKey.version && planner == aKey.planner && smoothed == aKey.smoothed && robotName == aKey.robotName;
+	}
+	/**
+	 *
+	 */
+	std::size_t RouteCache::KeyHash::operator()( const Key& aKey) const
+	{
+		std::size_t hash = std::hash< unsigned long >()( aKey.version);
+		for (int value : { aKey.start.x, aKey.start.y, aKey.goal.x, aKey.goal.y, aKey.radius, aKey.planner, static_cast< int >( aKey.smoothed) })
+		{
+			hash = hash * 31 + std::hash< int >()( value);
+		}
+		return hash * 31 + std::hash< std::string >()( aKey.robotName);
+	}
+	/**
+	 *
+	 */
+	RouteCache::RouteCache( std::size_t aCapacity) :
+								capacity( aCapacity),
+								hits( 0),
+								misses( 0)
+	{
+	}
+	/**
+	 *
+	 */
+	/* static */RouteCache& RouteCache::getRouteCache()
+	{
+		static RouteCache routeCache;
+		return routeCache;
+	}
+	/**
+	 *
+	 */
+	bool RouteCache::find(	const Key& aKey,
+							Path& aPath,
+							const std::function< bool( const Path&) >& aValidator /*= nullptr*/)
+	{
+		Path path;
+		{
+			std::lock_guard< std::mutex > lock( cacheMutex);
+
+			auto i = index.find( aKey);
+			if (i == index.end())
+			{
+				++misses;
+				return false;
+			}
+			routes.splice( routes.begin(), routes, i->second);
+			path = i->second->second;
+		}
+
+		// The validator looks at the world, the other threads can use the cache meanwhile
+		const bool accepted = !aValidator || aValidator( path);
+		{
+			std::lock_guard< std::mutex > lock( cacheMutex);
+			if (accepted)
+			{
+				++hits;
+			} else
+			{
+				++misses;
+			}
+		}
+		if (accepted)
+		{
+			aPath.swap( path);
+		}
+		return accepted;
+	}
+	/**
+	 *
+	 */
+	void RouteCache::insert(const Key& aKey,
+							const Path& aPath)
+	{
+		std::lock_guard< std::mutex > lock( cacheMutex);
+
+		auto i = index.find( aKey);
+		if (i != index.end())
+		{
+			i->second->second = aPath;
+			routes.splice( routes.begin(), routes, i->second);
+			return;
+		}
+		routes.emplace_front( aKey, aPath);
+		index[aKey] = routes.begin();
+		shrink();
+	}
+	/**
+	 *
+	 */
+	void RouteCache::clear()
+	{
+		std::lock_guard< std::mutex > lock( cacheMutex);
+		routes.clear();
+		index.clear();
+		hits = 0;
+		misses = 0;
+	}
+	/**
+	 *
+	 */
+	std::size_t RouteCache::getCapacity() const
+	{
+		std::lock_guard< std::mutex > lock( cacheMutex);
+		return capacity;
+	}
+	/**
+	 *
+	 */
+	void RouteCache::setCapacity( std::size_t aCapacity)
+	{
+		std::lock_guard< std::mutex > lock( cacheMutex);
+		capacity = aCapacity;
+		shrink();
+	}
+	/**
+	 *
+	 */
+	std::size_t RouteCache::getSize() const
+	{
+		std::lock_guard< std::mutex > lock( cacheMutex);
+		return routes.size();
+	}
+	/**
+	 *
+	 */
+	unsigned long RouteCache::getHits() const
+	{
+		std::lock_guard< std::mutex > lock( cacheMutex);
+		return hits;
+	}
+	/**
+	 *
+	 */
+	unsigned long RouteCache::getMisses() const
+	{
+		std::lock_guard< std::mutex > lock( cacheMutex);
+		return misses;
+	}
+	/**
+	 *
+	 */
+	void RouteCache::shrink()
+	{
+		while (routes.size() > capacity)
+		{
+			index.erase( routes.back().first);
+			routes.pop_back();
+		}
+	}
+} // namespace PathAlgorithm
@@ -0,0 +1,142 @@
+#ifndef ROUTECACHE_HPP_
+#define ROUTECACHE_HPP_
+
+#include "Config.hpp"
+
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "AStar.hpp"
+#include "Vertex.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 * A least-recently-used cache of the routes the planners found, shared by all robots.
+	 *
+	 * A route is only valid for the walls it was planned around, so the key contains the wall
+	 * version of the RobotWorld next to the start and goal cell, the clearance of the robot and
+	 * the name of the robot, which is not an obstacle for its own routes.
+	 * Any change of the walls gives a new version and the old entries are never found again,
+	 * they are pushed out of the cache by the new ones.
+	 *
+	 * The robots move every step, a version for them would make every entry useless after one step.
+	 * Instead find checks a route against the robots where they are now, see AStar::isFreeOfRobots.
+	 */
+	class RouteCache
+	{
+		public:
+			/**
+			 *
+			 */
+			struct Key
+			{
+					/**
+					 *
+					 */
+					bool operator==( const Key& aKey) const;
+
+					Vertex start;
+					Vertex goal;
+					int radius;
+					/**
+					 * The wall version of the RobotWorld
+					 */
+					unsigned long version;
+					/**
+					 * Planners find different routes of the same cost, the planner that found the route
+					 */
+					int planner;
+					/**
+					 * True if the route was reduced to its waypoints by the PathSmoother
+					 */
+					bool smoothed;
+					std::string robotName;
+			};
+			/**
+			 * The number of routes the shared cache keeps if no other capacity is set
+			 */
+			static const std::size_t DefaultCapacity = 64;
+			/**
+			 *
+			 */
+			explicit RouteCache( std::size_t aCapacity = DefaultCapacity);
+			/**
+			 *
+			 * @return The cache that is shared by all robots
+			 */
+			static RouteCache& getRouteCache();
+			/**
+			 * Copies the route of aKey into aPath and makes it the most recently used route.
+			 * A route that aValidator, if given, rejects stays in the cache but counts as a miss.
+			 *
+			 * @return True if the route was found and accepted, false if aPath is left untouched
+			 */
+			bool find(	const Key& aKey,
+						Path& aPath,
+						const std::function< bool( const Path&) >& aValidator = nullptr);
+			/**
+			 * Adds or replaces the route of aKey, the least recently used route is removed if the cache is full
+			 */
+			void insert(const Key& aKey,
+						const Path& aPath);
+			/**
+			 * Removes all routes and resets the counters
+			 */
+			void clear();
+			/**
+			 *
+			 */
+			std::size_t getCapacity() const;
+			/**
+			 * Sets the capacity, the least recently used routes are removed if there are more than aCapacity
+			 */
+			void setCapacity( std::size_t aCapacity);
+			/**
+			 *
+			 * @return The number of routes in the cache
+			 */
+			std::size_t getSize() const;
+			/**
+			 *
+			 * @return The number of calls to find that found a route that was accepted
+			 */
+			unsigned long getHits() const;
+			/**
+			 *
+			 * @return The number of calls to find that did not find a route or rejected it
+			 */
+			unsigned long getMisses() const;
+
+		private:
+			/**
+			 *
+			 */
+			struct KeyHash
+			{
+					std::size_t operator()( const Key& aKey) const;
+			};
+			/**
+			 * Removes the least recently used routes until there are at most capacity routes
+			 */
+			void shrink();
+
+			typedef std::list< std::pair< Key, Path > > Routes;
+
+			std::size_t capacity;
+			/**
+			 * The most recently used route is at the front
+			 */
+			Routes routes;
+			std::unordered_map< Key, Routes::iterator, KeyHash > index;
+			unsigned long hits;
+			unsigned long misses;
+
+			mutable std::mutex cacheMutex;
+	}; // class RouteCache
+} // namespace PathAlgorithm
+#endif // ROUTECACHE_HPP_
@@ -0,0 +1,360 @@
+#include "Scheduler.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#include "Commandline.hpp"
+
+namespace Model
+{
+	/**
+	 * The number of tasks a worker takes at once
+	 */
+	static const std::size_t BatchSize = 8;
+	/**
+	 * True while the thread runs a step, a step that unschedules a task must not wait for its own tick
+	 */
+	static thread_local bool insideStep = false;
+	/**
+	 *
+	 */
+	Scheduler::Scheduler( unsigned int aNumberOfWorkers) :
+								nextDueTask( 0),
+								lastTaskId( NoTask),
+								tick( 0),
+								tickRate( DefaultTickRate),
+								realTime( true),
+								deterministic( false),
+								pauseTick( std::numeric_limits< unsigned long long >::max()),
+								tickEnd( std::chrono::steady_clock::now()),
+								tickRunning( false),
+								generation( 0),
+								busyWorkers( 0),
+								stopping( false)
+	{
+		if (Application::Commandline::isArgGiven( "-tick_rate"))
+		{
+			setTickRate( std::stoul( Application::Commandline::getArg( "-tick_rate").value));
+		}
+		if (Application::Commandline::isArgGiven( "-fast"))
+		{
+			realTime = false;
+		}
+		if (Application::Commandline::isArgGiven( "-deterministic"))
+		{
+			deterministic = true;
+		}
+		if (aNumberOfWorkers == 0)
+		{
+			aNumberOfWorkers = std::max( std::thread::hardware_concurrency(), 1U);
+		}
+		// The thread that runs the ticks is a worker too
+		for (unsigned int i = 1; i < aNumberOfWorkers; ++i)
+		{
+			threads.emplace_back( [this]{ work();});
+		}
+		tickThread = std::thread( [this]{ run();});
+	}
+	/**
+	 *
+	 */
+	Scheduler::~Scheduler()
+	{
+		{
+			std::lock_guard< std::mutex > lock( schedulerMutex);
+			stopping = true;
+		}
+		tasksAvailable.notify_all();
+		batchesAvailable.notify_all();
+		tickDone.notify_all();
+		tickThread.join();
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	}
+	/**
+	 *
+	 */
+	/* static */Scheduler& Scheduler::getScheduler()
+	{
+		static Scheduler scheduler( Application::Commandline::isArgGiven( "-workers") ? std::stoul( Application::Commandline::getArg( "-workers").value) : 0);
+		return scheduler;
+	}
+	/**
+	 *
+	 */
+	Scheduler::TaskId Scheduler::schedule(	const Step& aStep,
+											unsigned long aPeriod /*= 1*/)
+	{
+		std::shared_ptr< Task > task = std::make_shared< Task >();
+		task->step = aStep;
+		task->period = std::max( aPeriod, 1UL);
+		task->stopped = false;
+		{
+			std::lock_guard< std::mutex > lock( schedulerMutex);
+			task->id = ++lastTaskId;
+			// A tick that is running already has its due tasks, the task starts at the next one
+			task->nextTick = tick.load();
+			tasks.push_back( task);
+		}
+		tasksAvailable.notify_all();
+		return task->id;
+	}
+	/**
+	 *
+	 */
+	void Scheduler::unschedule( TaskId aTaskId)
+	{
+		std::unique_lock< std::mutex > lock( schedulerMutex);
+		for (std::shared_ptr< Task >& task : tasks)
+		{
+			if (task->id == aTaskId)
+			{
+				task->stopped = true;
+			}
+		}
+		if (!insideStep)
+		{
+			tickDone.wait( lock, [this, aTaskId]
+			{
+				return !tickRunning || std::none_of( dueTasks.begin(), dueTasks.end(), [aTaskId]( const std::shared_ptr< Task >& aTask){ return aTask->id == aTaskId;});
+			});
+		}
+	}
+	/**
+	 *
+	 */
+	bool Scheduler::isScheduled( TaskId aTaskId) const
+	{
+		std::lock_guard< std::mutex > lock( schedulerMutex);
+		return std::any_of( tasks.begin(), tasks.end(), [aTaskId]( const std::shared_ptr< Task >& aTask){ return aTask->id == aTaskId && !aTask->stopped;});
+	}
+	/**
+	 *
+	 */
+	bool Scheduler::isIdle() const
+	{
+		std::lock_guard< std::mutex > lock( schedulerMutex);
+		return std::all_of( tasks.begin(), tasks.end(), []( const std::shared_ptr< Task >& aTask){ return aTask->stopped.load();});
+	}
+	/**
+	 *
+	 */
+	bool Scheduler::waitUntilIdle( unsigned long long aTick) const
+	{
+		std::unique_lock< std::mutex > lock( schedulerMutex);
+		auto idle = [this]
+		{
+			return std::all_of( tasks.begin(), tasks.end(), []( const std::shared_ptr< Task >& aTask){ return aTask->stopped.load();});
+		};
+		tickDone.wait( lock, [this, aTick, &idle]{ return stopping || tick.load() >= aTick || idle();});
+		return idle();
+	}
+	/**
+	 *
+	 */
+	void Scheduler::setTickRate( unsigned long aTickRate)
+	{
+		tickRate = std::max( aTickRate, 1UL);
+	}
+	/**
+	 *
+	 */
+	std::chrono::microseconds Scheduler::getTickDuration() const
+	{
+		return std::chrono::microseconds( 1000000 / tickRate.load());
+	}
+	/**
+	 *
+	 */
+	std::chrono::microseconds Scheduler::getTimeLeftInTick() const
+	{
+		if (!realTime)
+		{
+			return std::chrono::microseconds( 0);
+		}
+		return std::max( std::chrono::duration_cast< std::chrono::microseconds >( tickEnd.load() - std::chrono::steady_clock::now()), std::chrono::microseconds( 0));
+	}
+	/**
+	 *
+	 */
+	unsigned long Scheduler::getTicksFor( std::chrono::milliseconds aDuration) const
+	{
+		const unsigned long ticks = static_cast< unsigned long >( (aDuration.count() * tickRate.load() + 500) / 1000);
+		return std::max( ticks, 1UL);
+	}
+	/**
+	 *
+	 */
+	void Scheduler::setRealTime( bool aRealTime)
+	{
+		realTime = aRealTime;
+	}
+	/**
+	 *
+	 */
+	void Scheduler::setDeterministic( bool aDeterministic)
+	{
+		deterministic = aDeterministic;
+	}
+	/**
+	 *
+	 */
+	void Scheduler::pauseAt( unsigned long long aTick)
+	{
+		{
+			std::lock_guard< std::mutex > lock( schedulerMutex);
+			pauseTick = aTick;
+		}
+		// A later pause tick continues a scheduler that was paused
+		tasksAvailable.notify_all();
+	}
+	/**
+	 *
+	 */
+	void Scheduler::resume()
+	{
+		{
+			std::lock_guard< std::mutex > lock( schedulerMutex);
+			pauseTick = std::numeric_limits< unsigned long long >::max();
+		}
+		tasksAvailable.notify_all();
+	}
+	/**
+	 *
+	 */
+	void Scheduler::run()
+	{
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now();
+		for (;;)
+		{
+			{
+				std::unique_lock< std::mutex > lock( schedulerMutex);
+				if (tasks.empty() || tick.load() >= pauseTick)
+				{
+					tasksAvailable.wait( lock, [this]{ return stopping || (!tasks.empty() && tick.load() < pauseTick);});
+					// An idle scheduler does not catch up with the ticks it did not run
+					deadline = std::chrono::steady_clock::now();
+				}
+				if (stopping)
+				{
+					return;
+				}
+
+				const unsigned long long currentTick = tick.load();
+				for (std::shared_ptr< Task >& task : tasks)
+				{
+					if (!task->stopped && task->nextTick <= currentTick)
+					{
+						dueTasks.push_back( task);
+						task->nextTick = currentTick + task->period;
+					}
+				}
+				nextDueTask = 0;
+				tickRunning = true;
+				tickEnd = deadline + getTickDuration();
+				// A deterministic tick runs all tasks on this thread, in the order of tasks
+				if (!deterministic)
+				{
+					busyWorkers = static_cast< unsigned int >( threads.size());
+					++generation;
+				}
+			}
+			batchesAvailable.notify_all();
+
+			runBatches();
+
+			{
+				std::unique_lock< std::mutex > lock( schedulerMutex);
+				tickDone.wait( lock, [this]{ return busyWorkers == 0;});
+				tickRunning = false;
+				dueTasks.clear();
+				tasks.erase( std::remove_if( tasks.begin(), tasks.end(), []( const std::shared_ptr< Task >& aTask){ return aTask->stopped.load();}), tasks.end());
+				++tick;
+			}
+			tickDone.notify_all();
+
+			if (realTime)
+			{
+				// A tick that took too long delays the ticks after it instead of making them shorter
+				deadline = std::max( deadline + getTickDuration(), std::chrono::steady_clock::now() - getTickDuration());
+				std::this_thread::sleep_until( deadline);
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	void Scheduler::work()
+	{
+		unsigned long long lastGeneration = 0;
+		for (;;)
+		{
+			{
+				std::unique_lock< std::mutex > lock( schedulerMutex);
+				batchesAvailable.wait( lock, [this, lastGeneration]{ return stopping || generation != lastGeneration;});
+				if (stopping)
+				{
+					return;
+				}
+				lastGeneration = generation;
+			}
+
+			runBatches();
+
+			{
+				std::lock_guard< std::mutex > lock( schedulerMutex);
+				--busyWorkers;
+			}
+			tickDone.notify_all();
+		}
+	}
+	/**
+	 *
+	 */
+	void Scheduler::runBatches()
+	{
+		for (;;)
+		{
+			const std::size_t first = nextDueTask.fetch_add( BatchSize);
+			if (first >= dueTasks.size())
+			{
+				return;
+			}
+			const std::size_t last = std::min( first + BatchSize, dueTasks.size());
+			for (std::size_t i = first; i < last; ++i)
+			{
+				Task& task = *dueTasks[i];
+				if (task.stopped)
+				{
+					continue;
+				}
+
+				bool again = false;
+				insideStep = true;
+				try
+				{
+					again = task.step();
+				}
+				catch (std::exception& e)
+				{
+					std::cerr << __PRETTY_FUNCTION__ << ": " << e.what() << std::endl;
+				}
+				catch (...)
+				{
+					std::cerr << __PRETTY_FUNCTION__ << ": unknown exception" << std::endl;
+				}
+				insideStep = false;
+
+				if (!again)
+				{
+					task.stopped = true;
+				}
+			}
+		}
+	}
+} // namespace Model
@@ -0,0 +1,226 @@
+#ifndef SCHEDULER_HPP_
+#define SCHEDULER_HPP_
+
+#include "Config.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Model
+{
+	/**
+	 * Steps the Robots and their sensors with a fixed timestep on a pool of worker threads.
+	 *
+	 * A task is a step function that is called every aPeriod ticks until it returns false or is
+	 * unscheduled. At every tick the due tasks are divided in batches over the workers and the
+	 * next tick starts when all of them are done, so a task never runs twice at the same time.
+	 * In real time a tick lasts 1/tickRate second, otherwise the next tick starts immediately and
+	 * the simulation runs as fast as the steps allow.
+	 *
+	 * A deterministic scheduler runs the due tasks one by one in the order they were scheduled, on
+	 * the thread that runs the ticks. A run then only depends on its input and not on the number
+	 * of workers or the speed of the computer, see EventLog.
+	 *
+	 * The tick rate, the real time mode, the deterministic mode and the number of workers are given
+	 * on the command line with -tick_rate=n, -fast, -deterministic and -workers=n.
+	 */
+	class Scheduler
+	{
+		public:
+			/**
+			 *
+			 */
+			typedef unsigned long TaskId;
+			/**
+			 * The id that is never given to a task
+			 */
+			static const TaskId NoTask = 0;
+			/**
+			 * The step of a task, the task stops when it returns false
+			 */
+			typedef std::function< bool() > Step;
+			/**
+			 * The ticks per second, one tick is the 10 ms a Robot used to sleep between two moves
+			 */
+			static const unsigned long DefaultTickRate = 100;
+			/**
+			 * Stops the workers, the tasks that are still scheduled are not called any more
+			 */
+			~Scheduler();
+			/**
+			 *
+			 * @return The scheduler that steps all Robots and sensors
+			 */
+			static Scheduler& getScheduler();
+			/**
+			 * Calls aStep at the next tick and then every aPeriod ticks
+			 *
+			 * @return The id to unschedule the task with
+			 */
+			TaskId schedule(	const Step& aStep,
+								unsigned long aPeriod = 1);
+			/**
+			 * Stops the task. Unless it is called from a step, it waits until the step of the task
+			 * is no longer running, like joining the thread of the task.
+			 */
+			void unschedule( TaskId aTaskId);
+			/**
+			 *
+			 */
+			bool isScheduled( TaskId aTaskId) const;
+			/**
+			 *
+			 * @return True if there are no tasks
+			 */
+			bool isIdle() const;
+			/**
+			 * Waits until there are no tasks or aTick has passed
+			 *
+			 * @return isIdle()
+			 */
+			bool waitUntilIdle( unsigned long long aTick) const;
+			/**
+			 *
+			 * @return The number of ticks since the scheduler was created
+			 */
+			unsigned long long getTick() const
+			{
+				return tick.load();
+			}
+			/**
+			 *
+			 */
+			unsigned long getTickRate() const
+			{
+				return tickRate.load();
+			}
+			/**
+			 *
+			 */
+			void setTickRate( unsigned long aTickRate);
+			/**
+			 *
+			 * @return The simulated time of one tick
+			 */
+			std::chrono::microseconds getTickDuration() const;
+			/**
+			 * A step that has time to spare, e.g. to improve a route, uses at most this time
+			 *
+			 * @return The wall clock time until the running tick should end, zero if the ticks do not wait for the wall clock
+			 */
+			std::chrono::microseconds getTimeLeftInTick() const;
+			/**
+			 *
+			 * @return The number of ticks in aDuration of simulated time, at least 1
+			 */
+			unsigned long getTicksFor( std::chrono::milliseconds aDuration) const;
+			/**
+			 *
+			 * @return False if the ticks do not wait for the wall clock
+			 */
+			bool isRealTime() const
+			{
+				return realTime.load();
+			}
+			/**
+			 *
+			 */
+			void setRealTime( bool aRealTime);
+			/**
+			 *
+			 * @return True if the tasks run one by one in a fixed order
+			 */
+			bool isDeterministic() const
+			{
+				return deterministic.load();
+			}
+			/**
+			 * Only takes effect at the next tick
+			 */
+			void setDeterministic( bool aDeterministic);
+			/**
+			 * Runs no ticks from aTick on until resume or pauseAt with a later tick is called, a run
+			 * of a fixed number of ticks ends at the same tick however fast the ticks are
+			 */
+			void pauseAt( unsigned long long aTick);
+			/**
+			 *
+			 */
+			void resume();
+			/**
+			 *
+			 */
+			unsigned int getNumberOfWorkers() const
+			{
+				return static_cast< unsigned int >( threads.size()) + 1;
+			}
+
+		private:
+			/**
+			 *
+			 * @param aNumberOfWorkers The number of threads that run the steps, including the thread
+			 * 			that runs the ticks. One per hardware thread if 0.
+			 */
+			explicit Scheduler( unsigned int aNumberOfWorkers = 0);
+			/**
+			 *
+			 */
+			struct Task
+			{
+					TaskId id;
+					Step step;
+					unsigned long period;
+					unsigned long long nextTick;
+					std::atomic< bool > stopped;
+			};
+			/**
+			 * The loop of the thread that runs the ticks
+			 */
+			void run();
+			/**
+			 * The loop of a worker thread: runs batches of every tick until the scheduler stops
+			 */
+			void work();
+			/**
+			 * Runs batches of due tasks until all are taken
+			 */
+			void runBatches();
+
+			std::vector< std::shared_ptr< Task > > tasks;
+			/**
+			 * The tasks of the tick that is running, only changed between two ticks
+			 */
+			std::vector< std::shared_ptr< Task > > dueTasks;
+			std::atomic< std::size_t > nextDueTask;
+
+			TaskId lastTaskId;
+			std::atomic< unsigned long long > tick;
+			std::atomic< unsigned long > tickRate;
+			std::atomic< bool > realTime;
+			std::atomic< bool > deterministic;
+			unsigned long long pauseTick;
+			/**
+			 * The wall clock time the running tick should end
+			 */
+			std::atomic< std::chrono::steady_clock::time_point > tickEnd;
+
+			bool tickRunning;
+			unsigned long long generation;
+			unsigned int busyWorkers;
+			bool stopping;
+			mutable std::mutex schedulerMutex;
+			mutable std::condition_variable tasksAvailable;
+			std::condition_variable batchesAvailable;
+			mutable std::condition_variable tickDone;
+
+			std::vector< std::thread > threads;
+			std::thread tickThread;
+	}; // class Scheduler
+} // namespace Model
+#endif // SCHEDULER_HPP_
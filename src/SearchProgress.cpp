@@ -0,0 +1,73 @@
+#include "SearchProgress.hpp"
+
+#include <utility>
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	SearchProgress::SearchProgress() :
+								enabled( false),
+								expansionInterval( DefaultExpansionInterval),
+								millisecondInterval( DefaultMillisecondInterval),
+								numberOfExpansions( 0),
+								lastExpansions( 0),
+								lastTime( std::chrono::steady_clock::now())
+	{
+	}
+	/**
+	 *
+	 */
+	void SearchProgress::setInterval(	std::size_t anExpansionInterval,
+										int aMillisecondInterval)
+	{
+		expansionInterval = anExpansionInterval;
+		millisecondInterval = aMillisecondInterval;
+	}
+	/**
+	 *
+	 */
+	void SearchProgress::setEnabled( bool anEnabled)
+	{
+		enabled.store( anEnabled);
+	}
+	/**
+	 *
+	 */
+	void SearchProgress::start()
+	{
+		numberOfExpansions = 0;
+		lastExpansions = 0;
+		lastTime = std::chrono::steady_clock::now();
+	}
+	/**
+	 *
+	 */
+	void SearchProgress::publish(	std::vector< Vertex > anOpenSet,
+									std::vector< Vertex > aClosedSet)
+	{
+		lastExpansions = numberOfExpansions;
+		lastTime = std::chrono::steady_clock::now();
+
+		std::lock_guard< std::mutex > lock( snapshotMutex);
+		openSet = std::move( anOpenSet);
+		closedSet = std::move( aClosedSet);
+	}
+	/**
+	 *
+	 */
+	std::vector< Vertex > SearchProgress::getOpenSet() const
+	{
+		std::lock_guard< std::mutex > lock( snapshotMutex);
+		return openSet;
+	}
+	/**
+	 *
+	 */
+	std::vector< Vertex > SearchProgress::getClosedSet() const
+	{
+		std::lock_guard< std::mutex > lock( snapshotMutex);
+		return closedSet;
+	}
+} // namespace PathAlgorithm
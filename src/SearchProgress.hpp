@@ -0,0 +1,116 @@
+#ifndef SEARCHPROGRESS_HPP_
+#define SEARCHPROGRESS_HPP_
+
+#include "Config.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "Vertex.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 * Snapshots of the openSet and the closedSet of a running search for a visualiser.
+	 *
+	 * The search itself runs without locks or notifications. After every expansion it asks whether
+	 * a snapshot is due and only then copies its sets into the snapshot. A visualiser enables the
+	 * snapshots and polls the last one. Without a visualiser no snapshot is ever taken, copying the
+	 * closedSet costs as much as the search of a small world.
+	 */
+	class SearchProgress
+	{
+		public:
+			/**
+			 * The default number of expansions between two snapshots, 0 to only take snapshots in time
+			 */
+			static const std::size_t DefaultExpansionInterval = 0;
+			/**
+			 * The default time between two snapshots, 0 to only take snapshots every number of expansions
+			 */
+			static const int DefaultMillisecondInterval = 40;
+			/**
+			 *
+			 */
+			SearchProgress();
+			/**
+			 * Takes a snapshot every anExpansionInterval expansions or every aMillisecondInterval
+			 * milliseconds, whatever comes first. An interval of 0 is not used.
+			 */
+			void setInterval(	std::size_t anExpansionInterval,
+								int aMillisecondInterval);
+			/**
+			 * A visualiser enables the snapshots, they are disabled by default
+			 */
+			void setEnabled( bool anEnabled);
+			/**
+			 *
+			 * @return True if the search publishes snapshots
+			 */
+			bool isEnabled() const
+			{
+				return enabled.load();
+			}
+			/**
+			 * Starts counting for a new search
+			 */
+			void start();
+			/**
+			 * Counts one expansion
+			 *
+			 * @return True if a snapshot is due
+			 */
+			bool expand()
+			{
+				++numberOfExpansions;
+				if (!isEnabled())
+				{
+					return false;
+				}
+				if (expansionInterval != 0 && numberOfExpansions - lastExpansions >= expansionInterval)
+				{
+					return true;
+				}
+				// Reading the clock costs more than an expansion, it is only read every 64 expansions
+				return millisecondInterval != 0 && (numberOfExpansions & 63) == 0 && std::chrono::steady_clock::now() - lastTime >= std::chrono::milliseconds( millisecondInterval);
+			}
+			/**
+			 * Replaces the snapshot
+			 */
+			void publish(	std::vector< Vertex > anOpenSet,
+							std::vector< Vertex > aClosedSet);
+			/**
+			 *
+			 * @return The number of expansions of the current or last search
+			 */
+			std::size_t getNumberOfExpansions() const
+			{
+				return numberOfExpansions;
+			}
+			/**
+			 *
+			 */
+			std::vector< Vertex > getOpenSet() const;
+			/**
+			 *
+			 */
+			std::vector< Vertex > getClosedSet() const;
+
+		private:
+			std::atomic< bool > enabled;
+			std::size_t expansionInterval;
+			int millisecondInterval;
+
+			std::size_t numberOfExpansions;
+			std::size_t lastExpansions;
+			std::chrono::steady_clock::time_point lastTime;
+
+			std::vector< Vertex > openSet;
+			std::vector< Vertex > closedSet;
+			mutable std::mutex snapshotMutex;
+	}; // class SearchProgress
+} // namespace PathAlgorithm
+#endif // SEARCHPROGRESS_HPP_
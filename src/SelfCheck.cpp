@@ -0,0 +1,352 @@
+#include "SelfCheck.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "AStar.hpp"
+#include "CooperativeAStar.hpp"
+#include "Goal.hpp"
+#include "MapBenchmark.hpp"
+#include "MapGenerator.hpp"
+#include "ReservationTable.hpp"
+#include "Robot.hpp"
+#include "RobotWorld.hpp"
+#include "RouteCache.hpp"
+#include "TourPlanner.hpp"
+
+namespace Application
+{
+	/**
+	 *
+	 */
+	static const double Infinity = std::numeric_limits< double >::infinity();
+	/**
+	 * The size a RobotShape gives a Robot with the default title
+	 */
+	static const Size RobotSize( 37, 29);
+	/**
+	 * Writes the result of the check aName, it failed if aFailure is not empty
+	 *
+	 * @return True if the check passed
+	 */
+	static bool Report(	std::ostream& os,
+						const std::string& aName,
+						const std::string& aFailure)
+	{
+		os << "  " << aName << ": " << (aFailure.empty() ? "ok" : "FAILED, " + aFailure) << std::endl;
+		return aFailure.empty();
+	}
+	/**
+	 * The six built-in situations of the RobotWorld
+	 */
+	static std::vector< std::function< void() > > Situations()
+	{
+		Model::RobotWorld& robotWorld = Model::RobotWorld::getRobotWorld();
+		return {	[&robotWorld]{ robotWorld.situationOne();},
+					[&robotWorld]{ robotWorld.situationTwo();},
+					[&robotWorld]{ robotWorld.situationThree();},
+					[&robotWorld]{ robotWorld.situationFour();},
+					[&robotWorld]{ robotWorld.situationFive();},
+					[&robotWorld]{ robotWorld.situationSix();}};
+	}
+	/**
+	 * aNumberOfPoints free cells of aGrid, the same ones for the same aSeed
+	 */
+	static std::vector< PathAlgorithm::Vertex > RandomFreeVertices(	const PathAlgorithm::OccupancyGrid& aGrid,
+																		unsigned long aSeed,
+																		std::size_t aNumberOfPoints)
+	{
+		std::mt19937 generator( static_cast< std::mt19937::result_type >( aSeed));
+		std::uniform_int_distribution< int > xDistribution( 0, aGrid.getWidth() - 1);
+		std::uniform_int_distribution< int > yDistribution( 0, aGrid.getHeight() - 1);
+
+		std::vector< PathAlgorithm::Vertex > vertices;
+		while (vertices.size() < aNumberOfPoints)
+		{
+			PathAlgorithm::Vertex vertex( xDistribution( generator), yDistribution( generator));
+			if (aGrid.isFree( vertex))
+			{
+				vertices.push_back( vertex);
+			}
+		}
+		return vertices;
+	}
+	/**
+	 *
+	 * @return The cost of the route from aStart to aGoal with a search for aGoal alone, infinity if there is none
+	 */
+	static double SearchCost(	PathAlgorithm::AStar& anAStar,
+								const PathAlgorithm::Vertex& aStart,
+								const PathAlgorithm::Vertex& aGoal,
+								const PathAlgorithm::OccupancyGrid& aGrid)
+	{
+		PathAlgorithm::Path path;
+		if (!anAStar.search( aStart, aGoal, aGrid, path))
+		{
+			return Infinity;
+		}
+		return path.back().actualCost;
+	}
+	/**
+	 *
+	 */
+	/* static */bool SelfCheck::run( std::ostream& os)
+	{
+		os << "checks" << std::endl;
+		bool passed = true;
+		passed = checkMultiGoalSearch( os) && passed;
+		passed = checkNearestTour( os) && passed;
+		passed = checkRouteCacheAfterRobotMoved( os) && passed;
+		passed = checkGeneratedMapsHaveRoute( os) && passed;
+		passed = checkCooperativeCrossing( os) && passed;
+		return passed;
+	}
+	/**
+	 * Besides the goal of the situation three random free cells are goals, some of them are nearer
+	 * than the goal of the situation and some can not be reached
+	 */
+	/* static */bool SelfCheck::checkMultiGoalSearch( std::ostream& os)
+	{
+		Model::RobotWorld& robotWorld = Model::RobotWorld::getRobotWorld();
+		std::vector< std::function< void() > > situations = Situations();
+
+		std::ostringstream failure;
+		for (std::size_t i = 0; i < situations.size() && failure.str().empty(); ++i)
+		{
+			situations[i]();
+			const PathAlgorithm::Vertex start( robotWorld.getRobot( "Robot")->getPosition());
+
+			PathAlgorithm::OccupancyGrid grid;
+			PathAlgorithm::AStar::fillOccupancyGrid( grid, PathAlgorithm::AStar::freeRadius( RobotSize), "Robot");
+
+			std::vector< PathAlgorithm::Vertex > goals = RandomFreeVertices( grid, i + 1, 3);
+			goals.push_back( PathAlgorithm::Vertex( robotWorld.getGoal( "Goal")->getPosition()));
+
+			PathAlgorithm::AStar astar;
+			double nearestCost = Infinity;
+			for (const PathAlgorithm::Vertex& goal : goals)
+			{
+				nearestCost = std::min( nearestCost, SearchCost( astar, start, goal, grid));
+			}
+
+			PathAlgorithm::Path path;
+			const bool found = astar.search( start, goals, grid, path);
+			if (found != (nearestCost != Infinity))
+			{
+				failure << "situation " << i + 1 << ": found a route " << found << ", the searches per goal " << (nearestCost != Infinity);
+			} else if (found && std::abs( path.back().actualCost - nearestCost) > 1e-6)
+			{
+				failure << "situation " << i + 1 << ": cost " << path.back().actualCost << ", the nearest goal costs " << nearestCost;
+			} else if (found && std::none_of( goals.begin(), goals.end(), [&path]( const PathAlgorithm::Vertex& aGoal){ return aGoal.equalPoint( path.back());}))
+			{
+				failure << "situation " << i + 1 << ": the route ends at " << path.back() << ", which is not a goal";
+			}
+		}
+		return Report( os, "multi-goal search", failure.str());
+	}
+	/**
+	 * Situation three has the most walls, so some of the random way points are only reached around them
+	 */
+	/* static */bool SelfCheck::checkNearestTour( std::ostream& os)
+	{
+		Model::RobotWorld& robotWorld = Model::RobotWorld::getRobotWorld();
+		robotWorld.situationThree();
+		const PathAlgorithm::Vertex start( robotWorld.getRobot( "Robot")->getPosition());
+		const PathAlgorithm::Vertex end( robotWorld.getGoal( "Goal")->getPosition());
+
+		PathAlgorithm::OccupancyGrid grid;
+		PathAlgorithm::AStar::fillOccupancyGrid( grid, PathAlgorithm::AStar::freeRadius( RobotSize), "Robot");
+
+		const std::vector< PathAlgorithm::Vertex > wayPointVertices = RandomFreeVertices( grid, 3, PathAlgorithm::TourPlanner::MaximumPairedWayPoints + 4);
+		std::vector< Point > wayPoints;
+		for (const PathAlgorithm::Vertex& wayPoint : wayPointVertices)
+		{
+			wayPoints.push_back( wayPoint.asPoint());
+		}
+
+		PathAlgorithm::TourPlanner tourPlanner;
+		const PathAlgorithm::Path route = tourPlanner.planNearest( start.asPoint(), wayPoints, end.asPoint(), RobotSize, "Robot");
+
+		std::ostringstream failure;
+		if (route.empty() || !route.front().equalPoint( start) || !route.back().equalPoint( end))
+		{
+			failure << "the route does not go from the start to the end";
+		}
+		for (std::size_t i = 1; i < route.size() && failure.str().empty(); ++i)
+		{
+			if (std::abs( route[i].x - route[i - 1].x) > 1 || std::abs( route[i].y - route[i - 1].y) > 1 || !grid.isFree( route[i]))
+			{
+				failure << "the route jumps or is blocked at " << route[i];
+			}
+		}
+
+		// Every way point of the order is the nearest of the way points that were left
+		PathAlgorithm::AStar astar;
+		PathAlgorithm::Vertex current = start;
+		std::vector< std::size_t > remaining;
+		for (std::size_t i = 0; i < wayPointVertices.size(); ++i)
+		{
+			remaining.push_back( i);
+		}
+		for (std::size_t wayPoint : tourPlanner.getOrder())
+		{
+			if (!failure.str().empty())
+			{
+				break;
+			}
+			double nearestCost = Infinity;
+			for (std::size_t i : remaining)
+			{
+				nearestCost = std::min( nearestCost, SearchCost( astar, current, wayPointVertices[i], grid));
+			}
+			if (std::abs( SearchCost( astar, current, wayPointVertices[wayPoint], grid) - nearestCost) > 1e-6)
+			{
+				failure << "way point " << wayPoint << " is not the nearest one that was left";
+			}
+			current = wayPointVertices[wayPoint];
+			remaining.erase( std::remove( remaining.begin(), remaining.end(), wayPoint), remaining.end());
+		}
+		for (std::size_t i : remaining)
+		{
+			if (failure.str().empty() && SearchCost( astar, current, wayPointVertices[i], grid) != Infinity)
+			{
+				failure << "way point " << i << " can be reached but is not visited";
+			}
+		}
+		return Report( os, "nearest way point tour", failure.str());
+	}
+	/**
+	 * Situation one has no walls between the robot and the goal, the other robot starts
+	 * and moves far from the route. The route is cached the way Robot::calculateRoute caches it.
+	 */
+	/* static */bool SelfCheck::checkRouteCacheAfterRobotMoved( std::ostream& os)
+	{
+		Model::RobotWorld& robotWorld = Model::RobotWorld::getRobotWorld();
+		robotWorld.situationOne();
+		Model::RobotPtr other = robotWorld.newRobot( "Other", Point( 400, 60), false);
+		const PathAlgorithm::Vertex start( robotWorld.getRobot( "Robot")->getPosition());
+		const PathAlgorithm::Vertex goal( robotWorld.getGoal( "Goal")->getPosition());
+		const int radius = PathAlgorithm::AStar::freeRadius( RobotSize);
+
+		PathAlgorithm::OccupancyGrid grid;
+		PathAlgorithm::AStar::fillOccupancyGrid( grid, radius, "Robot");
+		PathAlgorithm::AStar astar;
+		PathAlgorithm::Path route;
+		astar.search( start, goal, grid, route);
+
+		PathAlgorithm::RouteCache routeCache;
+		auto keyNow = [&]()
+		{
+			return PathAlgorithm::RouteCache::Key{ start, goal, radius, robotWorld.getWallVersion(), Model::Robot::AStarPlanner, false, "Robot" };
+		};
+		auto isFreeOfRobots = [radius]( const PathAlgorithm::Path& aPath)
+		{
+			return PathAlgorithm::AStar::isFreeOfRobots( aPath, radius, "Robot");
+		};
+		routeCache.insert( keyNow(), route);
+
+		const unsigned long geometryVersion = robotWorld.getGeometryVersion();
+		other->setPosition( Point( 60, 400), false);
+
+		std::ostringstream failure;
+		PathAlgorithm::Path cachedRoute;
+		if (route.empty())
+		{
+			failure << "there is no route from " << start << " to " << goal;
+		} else if (robotWorld.getGeometryVersion() == geometryVersion)
+		{
+			failure << "moving the other robot did not change the geometry version";
+		} else if (!routeCache.find( keyNow(), cachedRoute, isFreeOfRobots) || routeCache.getHits() != 1)
+		{
+			failure << "the route was not found after the other robot moved away from it";
+		} else if (cachedRoute.size() != route.size() || !cachedRoute.back().equalPoint( goal))
+		{
+			failure << "the cached route is not the route that was planned";
+		} else
+		{
+			other->setPosition( route[route.size() / 2].asPoint(), false);
+			if (routeCache.find( keyNow(), cachedRoute, isFreeOfRobots) || routeCache.getMisses() != 1)
+			{
+				failure << "the route was found after the other robot moved onto it";
+			}
+		}
+
+		robotWorld.deleteRobot( other, false);
+		return Report( os, "route cache after a robot moved", failure.str());
+	}
+	/**
+	 * The default seed of the benchmark is 1
+	 */
+	/* static */bool SelfCheck::checkGeneratedMapsHaveRoute( std::ostream& os)
+	{
+		const Size worldSize = Model::RobotWorld::getRobotWorld().getWorldSize();
+		const int radius = PathAlgorithm::AStar::freeRadius( RobotSize);
+
+		std::ostringstream failure;
+		PathAlgorithm::OccupancyGrid grid;
+		PathAlgorithm::AStar astar;
+		PathAlgorithm::Path path;
+		for (unsigned long seed = 1; seed <= 20 && failure.str().empty(); ++seed)
+		{
+			try
+			{
+				for (const PathAlgorithm::Map& map : MapBenchmark::getMaps( seed, worldSize))
+				{
+					PathAlgorithm::MapGenerator::fillOccupancyGrid( map, radius, grid);
+					if (!astar.search( PathAlgorithm::Vertex( map.start), PathAlgorithm::Vertex( map.goal), grid, path))
+					{
+						failure << map.name << " has no route from its start to its goal";
+						break;
+					}
+				}
+			}
+			catch (std::exception& e)
+			{
+				failure << "seed " << seed << ": " << e.what();
+			}
+		}
+		return Report( os, "generated maps have a route", failure.str());
+	}
+	/**
+	 * Situation one has no walls in the middle of the world, the routes of the agents cross there.
+	 * The agents are not Robots of the RobotWorld, the reservations are made in a table of their own.
+	 */
+	/* static */bool SelfCheck::checkCooperativeCrossing( std::ostream& os)
+	{
+		Model::RobotWorld& robotWorld = Model::RobotWorld::getRobotWorld();
+		robotWorld.situationOne();
+		const std::vector< PathAlgorithm::CooperativeAStar::Agent > agents{	{ "West", Point( 100, 250), Point( 400, 250), RobotSize },
+																			{ "North", Point( 250, 100), Point( 250, 400), RobotSize }};
+		const int radius = PathAlgorithm::AStar::freeRadius( RobotSize);
+
+		PathAlgorithm::ReservationTable reservationTable;
+		PathAlgorithm::CooperativeAStar cooperativeAStar;
+		const std::vector< PathAlgorithm::Path > routes = cooperativeAStar.search( agents, reservationTable, 0);
+
+		std::ostringstream failure;
+		for (std::size_t i = 0; i < agents.size() && failure.str().empty(); ++i)
+		{
+			if (routes[i].empty() || !routes[i].front().equalPoint( PathAlgorithm::Vertex( agents[i].start)) || !routes[i].back().equalPoint( PathAlgorithm::Vertex( agents[i].goal)))
+			{
+				failure << agents[i].name << " has no route from its start to its goal";
+			}
+		}
+		// After its last cell a route stays where it ended
+		const long lastTick = static_cast< long >( std::max( routes[0].size(), routes[1].size()));
+		for (long tick = 0; tick <= lastTick && failure.str().empty(); ++tick)
+		{
+			const PathAlgorithm::Vertex& west = routes[0][std::min( static_cast< std::size_t >( tick), routes[0].size() - 1)];
+			if (!reservationTable.isFree( agents[0].name, west, radius, tick))
+			{
+				failure << "the routes conflict at tick " << tick << " at " << west;
+			}
+		}
+		return Report( os, "cooperative routes that cross", failure.str());
+	}
+} // namespace Application
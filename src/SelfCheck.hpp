@@ -0,0 +1,51 @@
+#ifndef SELFCHECK_HPP_
+#define SELFCHECK_HPP_
+
+#include "Config.hpp"
+
+#include <iostream>
+
+namespace Application
+{
+	/**
+	 * Checks of the planners on the built-in situations, see the robotworld_benchmark program.
+	 *
+	 * Run the benchmark with "-check" to run them instead of the measurements. Every check writes
+	 * one line with its result, the program fails if one of them fails.
+	 */
+	class SelfCheck
+	{
+		public:
+			/**
+			 * Runs all checks
+			 *
+			 * @return True if all checks passed
+			 */
+			static bool run( std::ostream& os);
+			/**
+			 * The search for several goals reaches the goal that is nearest according to a search per goal
+			 */
+			static bool checkMultiGoalSearch( std::ostream& os);
+			/**
+			 * The nearest way point first tour is one connected route that visits every way point
+			 * that can be reached, each time the nearest one that is left
+			 */
+			static bool checkNearestTour( std::ostream& os);
+			/**
+			 * A cached route is still found after another robot moved somewhere else,
+			 * and it is rejected after that robot moved onto it
+			 */
+			static bool checkRouteCacheAfterRobotMoved( std::ostream& os);
+			/**
+			 * Every map the benchmark measures has a route from its start to its goal, for a number of seeds
+			 */
+			static bool checkGeneratedMapsHaveRoute( std::ostream& os);
+			/**
+			 * Two robots whose routes cross, planned together by the cooperative planner, reach their goals
+			 * and are never in each other's way at the same tick
+			 */
+			static bool checkCooperativeCrossing( std::ostream& os);
+	};
+	// class SelfCheck
+} // namespace Application
+#endif // SELFCHECK_HPP_
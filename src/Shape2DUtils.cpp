@@ -1,7 +1,8 @@
 #include "Shape2DUtils.hpp"
+#include <cmath>
 #include <sstream>
 #include <algorithm>
-#include "Widgets.hpp"
+#include <limits>
 
 namespace Utils
 {
@@ -25,6 +26,45 @@ namespace Utils
 		return angle;
 	}
 
+	/**
+	 * True if the projections of the boxes on the normal of every edge of aBox overlap with more than
+	 * a point. The box coordinates are integers, so the projections are exact.
+	 */
+	static bool OverlapOnEdgeNormals(	const Point* aBox,
+										const Point* anotherBox)
+	{
+		for (int i = 0; i < 4; ++i)
+		{
+			const Point& edgeStart = aBox[i];
+			const Point& edgeEnd = aBox[(i + 1) % 4];
+			const long normalX = static_cast< long >( edgeStart.y) - edgeEnd.y;
+			const long normalY = static_cast< long >( edgeEnd.x) - edgeStart.x;
+			if (normalX == 0 && normalY == 0)
+			{
+				// Rounding the corners of a small box can give two equal corners
+				continue;
+			}
+
+			long min1 = std::numeric_limits< long >::max();
+			long max1 = std::numeric_limits< long >::min();
+			long min2 = std::numeric_limits< long >::max();
+			long max2 = std::numeric_limits< long >::min();
+			for (int j = 0; j < 4; ++j)
+			{
+				const long projection1 = normalX * aBox[j].x + normalY * aBox[j].y;
+				min1 = std::min( min1, projection1);
+				max1 = std::max( max1, projection1);
+				const long projection2 = normalX * anotherBox[j].x + normalY * anotherBox[j].y;
+				min2 = std::min( min2, projection2);
+				max2 = std::max( max2, projection2);
+			}
+			if (max1 <= min2 || max2 <= min1)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
 	/**
 	 *
 	 */
@@ -163,6 +203,33 @@ namespace Utils
 		}
 		return true;
 	}
+	/**
+	 *
+	 */
+	/* static */bool Shape2DUtils::intersectBoxes(	const Point* aBox,
+													const Point* anotherBox)
+	{
+		return OverlapOnEdgeNormals( aBox, anotherBox) && OverlapOnEdgeNormals( anotherBox, aBox);
+	}
+	/**
+	 * The axes of the rectangle are x and y, on those the box is projected to its own bounding box
+	 */
+	/* static */bool Shape2DUtils::intersectBoxAndRectangle(	const Point* aBox,
+																const Point& aTopLeft,
+																const Size& aSize)
+	{
+		const int left = std::min( { aBox[0].x, aBox[1].x, aBox[2].x, aBox[3].x });
+		const int right = std::max( { aBox[0].x, aBox[1].x, aBox[2].x, aBox[3].x });
+		const int top = std::min( { aBox[0].y, aBox[1].y, aBox[2].y, aBox[3].y });
+		const int bottom = std::max( { aBox[0].y, aBox[1].y, aBox[2].y, aBox[3].y });
+		if (right <= aTopLeft.x || aTopLeft.x + aSize.x <= left || bottom <= aTopLeft.y || aTopLeft.y + aSize.y <= top)
+		{
+			return false;
+		}
+
+		const Point rectangle[] = { aTopLeft, Point( aTopLeft.x + aSize.x, aTopLeft.y), Point( aTopLeft.x + aSize.x, aTopLeft.y + aSize.y), Point( aTopLeft.x, aTopLeft.y + aSize.y) };
+		return OverlapOnEdgeNormals( aBox, rectangle);
+	}
 	/**
 	 *
 	 */
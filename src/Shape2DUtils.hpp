@@ -50,6 +50,27 @@ namespace Utils
 			static bool isInsidePolygon( 	Point* aPolygon,
 											int aNumberOfPoints,
 											const Point& aPoint);
+			/**
+			 * Separating axis test of two convex quadrilaterals, like the oriented bounding boxes of
+			 * the Robots. Boxes that only share an edge or a corner do not overlap.
+			 *
+			 * @param aBox The 4 corners of a box, in clockwise or counter-clockwise order
+			 * @param anotherBox The 4 corners of the other box, in the same kind of order
+			 * @return True if the boxes overlap
+			 */
+			static bool intersectBoxes(	const Point* aBox,
+										const Point* anotherBox);
+			/**
+			 * As intersectBoxes with an axis aligned rectangle as the other box
+			 *
+			 * @param aBox The 4 corners of a box, in clockwise or counter-clockwise order
+			 * @param aTopLeft The top left corner of the rectangle
+			 * @param aSize The size of the rectangle
+			 * @return True if the box and the rectangle overlap
+			 */
+			static bool intersectBoxAndRectangle(	const Point* aBox,
+													const Point& aTopLeft,
+													const Size& aSize);
 			/**
 			 *
 			 * @param aStartpoint
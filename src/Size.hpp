@@ -8,6 +8,54 @@
  * Author: jkr
  */
 
+#if defined( ROBOTWORLD_HEADLESS)
+
+namespace Widgets
+{
+	/**
+	 * The part of wxSize the model uses, for the builds without wxWidgets
+	 */
+	struct Size
+	{
+			Size() :
+				x( 0),
+				y( 0)
+			{
+			}
+			Size(	int aWidth,
+					int aHeight) :
+						x( aWidth),
+						y( aHeight)
+			{
+			}
+			bool operator==( const Size& aSize) const
+			{
+				return x == aSize.x && y == aSize.y;
+			}
+			bool operator!=( const Size& aSize) const
+			{
+				return !(*this == aSize);
+			}
+			int GetWidth() const
+			{
+				return x;
+			}
+			int GetHeight() const
+			{
+				return y;
+			}
+
+			int x;
+			int y;
+	};
+	/**
+	 * The value of wxDefaultSize
+	 */
+	const Size DefaultSize( -1, -1);
+} // namespace Widgets
+
+#else
+
 #include <wx/gdicmn.h>
 
 namespace Widgets
@@ -16,7 +64,14 @@ namespace Widgets
 	 * @see http://docs.wxwidgets.org/stable/classwx_size
 	 */
 	typedef wxSize Size;
+	/**
+	 * @see http://docs.wxwidgets.org/stable/classwx_default_size
+	 */
+#define DefaultSize wxDefaultSize
 } // namespace Widgets
+
+#endif // ROBOTWORLD_HEADLESS
+
 using namespace Widgets;
 
 
@@ -0,0 +1,330 @@
+#include "TourPlanner.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <limits>
+
+#include "Robot.hpp"
+#include "RobotWorld.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	static const double Infinity = std::numeric_limits< double >::infinity();
+	/**
+	 *
+	 */
+	static double Distance(	const Vertex& aStart,
+							const Vertex& aGoal)
+	{
+		return std::sqrt( (aStart.x - aGoal.x) * (aStart.x - aGoal.x) + (aStart.y - aGoal.y) * (aStart.y - aGoal.y));
+	}
+	/**
+	 *
+	 */
+	TourPlanner::TourPlanner(	PlanningService& aPlanningService,
+								RouteCache& aRouteCache) :
+									planningService( aPlanningService),
+									routeCache( aRouteCache),
+									hasEnd( false)
+	{
+	}
+	/**
+	 *
+	 */
+	Path TourPlanner::plan(	const Point& aStartPoint,
+							const std::vector< Point >& someWayPoints,
+							const Size& aRobotSize,
+							const std::string& aRobotName)
+	{
+		stops.clear();
+		stops.push_back( aStartPoint);
+		stops.insert( stops.end(), someWayPoints.begin(), someWayPoints.end());
+		hasEnd = false;
+
+		planLegs( aRobotSize, aRobotName);
+		orderStops();
+		improveOrder();
+		return stitch();
+	}
+	/**
+	 *
+	 */
+	Path TourPlanner::plan(	const Point& aStartPoint,
+							const std::vector< Point >& someWayPoints,
+							const Point& anEndPoint,
+							const Size& aRobotSize,
+							const std::string& aRobotName)
+	{
+		stops.clear();
+		stops.push_back( aStartPoint);
+		stops.insert( stops.end(), someWayPoints.begin(), someWayPoints.end());
+		stops.push_back( anEndPoint);
+		hasEnd = true;
+
+		planLegs( aRobotSize, aRobotName);
+		if (!orderStops())
+		{
+			std::cerr << "**** No tour from " << aStartPoint << " to " << anEndPoint << std::endl;
+			return Path();
+		}
+		improveOrder();
+		return stitch();
+	}
+	/**
+	 * The way point a search reaches first is the nearest one, so every stop takes one search
+	 * instead of one search per way point that is left. The legs of the tour are stored as
+	 * planLegs stores them, so that stitch can join them.
+	 */
+	Path TourPlanner::planNearest(	const Point& aStartPoint,
+									const std::vector< Point >& someWayPoints,
+									const Point& anEndPoint,
+									const Size& aRobotSize,
+									const std::string& aRobotName)
+	{
+		stops.clear();
+		stops.push_back( aStartPoint);
+		stops.insert( stops.end(), someWayPoints.begin(), someWayPoints.end());
+		stops.push_back( anEndPoint);
+		hasEnd = true;
+
+		const std::size_t numberOfStops = stops.size();
+		legs.assign( numberOfStops * numberOfStops, Path());
+		tour.assign( 1, 0);
+		order.clear();
+
+		AStar astar;
+		astar.setRobotName( aRobotName);
+		OccupancyGrid grid;
+		AStar::fillOccupancyGrid( grid, AStar::freeRadius( aRobotSize), aRobotName);
+
+		// The stops of the way points that are not visited yet and their positions, in the same order
+		std::vector< std::size_t > remainingStops;
+		std::vector< Vertex > remainingGoals;
+		for (std::size_t i = 1; i < numberOfStops - 1; ++i)
+		{
+			remainingStops.push_back( i);
+			remainingGoals.push_back( Vertex( stops[i]));
+		}
+
+		Path leg;
+		while (!remainingGoals.empty() && astar.search( Vertex( stops[tour.back()]), remainingGoals, grid, leg))
+		{
+			const std::size_t reached = static_cast< std::size_t >( std::find_if( remainingGoals.begin(), remainingGoals.end(), [&leg]( const Vertex& aGoal){ return aGoal.equalPoint( leg.back());}) - remainingGoals.begin());
+			const std::size_t stop = remainingStops[reached];
+			// A leg to an earlier stop is stored the other way around
+			if (stop < tour.back())
+			{
+				std::reverse( leg.begin(), leg.end());
+			}
+			legs[std::min( tour.back(), stop) * numberOfStops + std::max( tour.back(), stop)] = leg;
+			tour.push_back( stop);
+			order.push_back( stop - 1);
+
+			remainingStops.erase( remainingStops.begin() + static_cast< std::ptrdiff_t >( reached));
+			remainingGoals.erase( remainingGoals.begin() + static_cast< std::ptrdiff_t >( reached));
+		}
+		// The way points that are left can not be reached from where the tour is
+		if (!astar.search( Vertex( stops[tour.back()]), Vertex( anEndPoint), grid, leg))
+		{
+			std::cerr << "**** No tour from " << aStartPoint << " to " << anEndPoint << std::endl;
+			return Path();
+		}
+		legs[tour.back() * numberOfStops + numberOfStops - 1] = leg;
+		tour.push_back( numberOfStops - 1);
+		return stitch();
+	}
+	/**
+	 * The legs are AStar routes on the same grid as the routes of a Robot with the AStarPlanner,
+	 * so they share the entries of the RouteCache with those routes. A cached leg is only used
+	 * if the other robots are still out of its way.
+	 */
+	void TourPlanner::planLegs(	const Size& aRobotSize,
+								const std::string& aRobotName)
+	{
+		const std::size_t numberOfStops = stops.size();
+		const int radius = AStar::freeRadius( aRobotSize);
+		const unsigned long version = Model::RobotWorld::getRobotWorld().getWallVersion();
+		auto isFreeOfRobots = [radius, &aRobotName]( const Path& aPath)
+		{
+			return AStar::isFreeOfRobots( aPath, radius, aRobotName);
+		};
+
+		legs.assign( numberOfStops * numberOfStops, Path());
+		distances.assign( numberOfStops * numberOfStops, 0.0);
+
+		std::vector< PlanningService::Request > requests;
+		std::vector< std::size_t > requestedLegs;
+		for (std::size_t i = 0; i < numberOfStops; ++i)
+		{
+			for (std::size_t j = i + 1; j < numberOfStops; ++j)
+			{
+				Path& leg = legs[i * numberOfStops + j];
+				RouteCache::Key key{ Vertex( stops[i]), Vertex( stops[j]), radius, version, Model::Robot::AStarPlanner, false, aRobotName };
+				RouteCache::Key reverseKey{ Vertex( stops[j]), Vertex( stops[i]), radius, version, Model::Robot::AStarPlanner, false, aRobotName };
+				if (routeCache.find( key, leg, isFreeOfRobots))
+				{
+					continue;
+				}
+				if (routeCache.find( reverseKey, leg, isFreeOfRobots))
+				{
+					std::reverse( leg.begin(), leg.end());
+					continue;
+				}
+				requests.push_back( PlanningService::Request{ stops[i], stops[j], aRobotSize, aRobotName, false });
+				requestedLegs.push_back( i * numberOfStops + j);
+			}
+		}
+
+		std::vector< std::future< Path > > futures = planningService.plan( requests);
+		for (std::size_t r = 0; r < futures.size(); ++r)
+		{
+			Path& leg = legs[requestedLegs[r]];
+			leg = futures[r].get();
+			if (!leg.empty())
+			{
+				routeCache.insert( RouteCache::Key{ Vertex( requests[r].start), Vertex( requests[r].goal), radius, version, Model::Robot::AStarPlanner, false, aRobotName }, leg);
+			}
+		}
+
+		// The length of a leg is the sum of its steps, a reversed leg has its costs the other way around
+		for (std::size_t i = 0; i < numberOfStops; ++i)
+		{
+			for (std::size_t j = i + 1; j < numberOfStops; ++j)
+			{
+				const Path& leg = legs[i * numberOfStops + j];
+				double length = leg.empty() ? Infinity : 0.0;
+				for (std::size_t k = 1; k < leg.size(); ++k)
+				{
+					length += Distance( leg[k - 1], leg[k]);
+				}
+				distances[i * numberOfStops + j] = length;
+				distances[j * numberOfStops + i] = length;
+			}
+		}
+	}
+	/**
+	 * The cells of the world that can be reached from each other form separate areas, a way point
+	 * that can not be reached from the stop before it can not be reached from the start at all
+	 */
+	bool TourPlanner::orderStops()
+	{
+		const std::size_t lastWayPoint = hasEnd ? stops.size() - 1 : stops.size();
+
+		std::vector< bool > visited( stops.size(), false);
+		tour.assign( 1, 0);
+		visited[0] = true;
+
+		for (;;)
+		{
+			std::size_t nearest = 0;
+			double nearestDistance = Infinity;
+			for (std::size_t i = 1; i < lastWayPoint; ++i)
+			{
+				if (!visited[i] && distance( tour.back(), i) < nearestDistance)
+				{
+					nearest = i;
+					nearestDistance = distance( tour.back(), i);
+				}
+			}
+			if (nearestDistance == Infinity)
+			{
+				break;
+			}
+			tour.push_back( nearest);
+			visited[nearest] = true;
+		}
+
+		if (hasEnd)
+		{
+			if (distance( 0, stops.size() - 1) == Infinity)
+			{
+				return false;
+			}
+			tour.push_back( stops.size() - 1);
+		}
+		return true;
+	}
+	/**
+	 * A 2-opt move reverses the way points from i to j. Only the two edges at the ends of the
+	 * reversed part change because the legs are as long in both directions.
+	 */
+	void TourPlanner::improveOrder()
+	{
+		// The start and the end of the tour stay where they are
+		const std::size_t last = hasEnd ? tour.size() - 2 : tour.size() - 1;
+
+		bool improved = true;
+		while (improved)
+		{
+			improved = false;
+			for (std::size_t i = 1; i < last; ++i)
+			{
+				for (std::size_t j = i + 1; j <= last; ++j)
+				{
+					double before = distance( tour[i - 1], tour[i]);
+					double after = distance( tour[i - 1], tour[j]);
+					if (j + 1 < tour.size())
+					{
+						before += distance( tour[j], tour[j + 1]);
+						after += distance( tour[i], tour[j + 1]);
+					}
+					// Rounding must not make two equal tours swap forever
+					if (after < before - 1e-9)
+					{
+						std::reverse( tour.begin() + static_cast< std::ptrdiff_t >( i), tour.begin() + static_cast< std::ptrdiff_t >( j) + 1);
+						improved = true;
+					}
+				}
+			}
+		}
+
+		order.clear();
+		for (std::size_t i = 1; i < tour.size(); ++i)
+		{
+			if (!hasEnd || tour[i] != stops.size() - 1)
+			{
+				order.push_back( tour[i] - 1);
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	Path TourPlanner::stitch() const
+	{
+		const std::size_t numberOfStops = stops.size();
+
+		std::size_t length = 1;
+		for (std::size_t i = 1; i < tour.size(); ++i)
+		{
+			length += legs[std::min( tour[i - 1], tour[i]) * numberOfStops + std::max( tour[i - 1], tour[i])].size();
+		}
+
+		Path path;
+		path.reserve( length);
+		path.push_back( Vertex( stops[0]));
+		for (std::size_t i = 1; i < tour.size(); ++i)
+		{
+			const Path& leg = legs[std::min( tour[i - 1], tour[i]) * numberOfStops + std::max( tour[i - 1], tour[i])];
+			// Every leg starts where the previous one ended
+			if (tour[i - 1] < tour[i])
+			{
+				path.insert( path.end(), leg.begin() + 1, leg.end());
+			} else
+			{
+				path.insert( path.end(), leg.rbegin() + 1, leg.rend());
+			}
+		}
+
+		for (std::size_t i = 0; i < path.size(); ++i)
+		{
+			path[i].actualCost = i == 0 ? 0.0 : path[i - 1].actualCost + Distance( path[i - 1], path[i]);
+			path[i].heuristicCost = path[i].actualCost + Distance( path[i], path.back());
+		}
+		return path;
+	}
+} // namespace PathAlgorithm
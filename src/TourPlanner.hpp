@@ -0,0 +1,129 @@
+#ifndef TOURPLANNER_HPP_
+#define TOURPLANNER_HPP_
+
+#include "Config.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "AStar.hpp"
+#include "PlanningService.hpp"
+#include "Point.hpp"
+#include "RouteCache.hpp"
+#include "Size.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 * Plans one route from a start along a number of way points.
+	 *
+	 * The routes between every pair of stops, the legs, are planned in parallel by a PlanningService
+	 * and kept in a RouteCache, a next tour in the same world only plans the legs it has not seen.
+	 * The order of the way points is the nearest-neighbour tour over the lengths of the legs,
+	 * improved with 2-opt moves until no reversal of a part of the tour makes it shorter.
+	 *
+	 * The number of legs grows with the square of the number of way points. planNearest only
+	 * searches the leg from every stop to the nearest way point that is not visited yet, in one
+	 * multi-goal search per stop, and does not improve the order.
+	 */
+	class TourPlanner
+	{
+		public:
+			/**
+			 * The largest number of way points a Robot plans the legs between all pairs of stops for
+			 */
+			static const std::size_t MaximumPairedWayPoints = 12;
+			/**
+			 * aPlanningService plans the legs, the TourPlanner must not be used from one of its workers
+			 */
+			explicit TourPlanner(	PlanningService& aPlanningService = PlanningService::getPlanningService(),
+									RouteCache& aRouteCache = RouteCache::getRouteCache());
+			/**
+			 * Plans a tour from aStartPoint along someWayPoints that may end at any of them for the
+			 * robot named aRobotName, which is not an obstacle for its own tour
+			 *
+			 * @return The route of the whole tour, the way points that can not be reached are left out
+			 */
+			Path plan(	const Point& aStartPoint,
+						const std::vector< Point >& someWayPoints,
+						const Size& aRobotSize,
+						const std::string& aRobotName);
+			/**
+			 * Plans a tour from aStartPoint along someWayPoints that ends at anEndPoint
+			 *
+			 * @return The route of the whole tour, empty if anEndPoint can not be reached
+			 */
+			Path plan(	const Point& aStartPoint,
+						const std::vector< Point >& someWayPoints,
+						const Point& anEndPoint,
+						const Size& aRobotSize,
+						const std::string& aRobotName);
+			/**
+			 * Plans a tour from aStartPoint along someWayPoints that ends at anEndPoint, always driving
+			 * to the nearest way point that is not visited yet
+			 *
+			 * @return The route of the whole tour, empty if anEndPoint can not be reached
+			 */
+			Path planNearest(	const Point& aStartPoint,
+								const std::vector< Point >& someWayPoints,
+								const Point& anEndPoint,
+								const Size& aRobotSize,
+								const std::string& aRobotName);
+			/**
+			 *
+			 * @return The indices in the way points of the last tour in the order they are visited
+			 */
+			const std::vector< std::size_t >& getOrder() const
+			{
+				return order;
+			}
+
+		private:
+			/**
+			 * Fills legs and distances for all pairs of stops, a leg from a later to an earlier stop is
+			 * the reverse of the leg the other way around and is not stored
+			 */
+			void planLegs(	const Size& aRobotSize,
+							const std::string& aRobotName);
+			/**
+			 * The nearest-neighbour tour from the first stop, with the last stop at the end if hasEnd
+			 *
+			 * @return False if the last stop can not be reached
+			 */
+			bool orderStops();
+			/**
+			 * Reverses parts of the tour as long as that makes it shorter
+			 */
+			void improveOrder();
+			/**
+			 * Joins the legs of the tour into one route
+			 */
+			Path stitch() const;
+			/**
+			 *
+			 */
+			double distance(	std::size_t aFrom,
+								std::size_t aTo) const
+			{
+				return distances[aFrom * stops.size() + aTo];
+			}
+
+			PlanningService& planningService;
+			RouteCache& routeCache;
+
+			std::vector< Point > stops;
+			bool hasEnd;
+			/**
+			 * The leg from stop i to stop j > i at i * stops.size() + j
+			 */
+			std::vector< Path > legs;
+			std::vector< double > distances;
+			/**
+			 * The stops in the order they are visited, the first stop is the start
+			 */
+			std::vector< std::size_t > tour;
+			std::vector< std::size_t > order;
+	}; // class TourPlanner
+} // namespace PathAlgorithm
+#endif // TOURPLANNER_HPP_
@@ -0,0 +1,197 @@
+#include "VertexHeap.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	VertexHeap::VertexHeap() :
+								width( 0),
+								height( 0)
+	{
+	}
+	/**
+	 *
+	 */
+	void VertexHeap::reset(	int aWidth,
+							int aHeight)
+	{
+		if (aWidth != width || aHeight != height)
+		{
+			width = aWidth;
+			height = aHeight;
+			heap.clear();
+			positions.assign( static_cast< std::size_t >( width) * height, -1);
+		} else
+		{
+			clear();
+		}
+	}
+	/**
+	 * Only the points that are still in the heap have a position, so there is no need to clear the whole index
+	 */
+	void VertexHeap::clear()
+	{
+		for (const Vertex& vertex : heap)
+		{
+			positions[key( vertex)] = -1;
+		}
+		heap.clear();
+	}
+	/**
+	 *
+	 */
+	void VertexHeap::push( const Vertex& aVertex)
+	{
+		int position = positions[key( aVertex)];
+		if (position >= 0)
+		{
+			std::size_t index = static_cast< std::size_t >( position);
+			bool lower = less( aVertex, heap[index]);
+			heap[index] = aVertex;
+			if (lower)
+			{
+				siftUp( index);
+			} else
+			{
+				siftDown( index);
+			}
+			return;
+		}
+
+		heap.push_back( aVertex);
+		positions[key( aVertex)] = static_cast< int >( heap.size() - 1);
+		siftUp( heap.size() - 1);
+	}
+	/**
+	 *
+	 */
+	void VertexHeap::pop()
+	{
+		positions[key( heap.front())] = -1;
+
+		Vertex last = heap.back();
+		heap.pop_back();
+		if (!heap.empty())
+		{
+			place( last, 0);
+			siftDown( 0);
+		}
+	}
+	/**
+	 *
+	 */
+	const Vertex* VertexHeap::find( const Vertex& aVertex) const
+	{
+		int position = positions[key( aVertex)];
+		if (position >= 0)
+		{
+			return &heap[position];
+		}
+		return nullptr;
+	}
+	/**
+	 *
+	 */
+	void VertexHeap::decreaseKey( const Vertex& aVertex)
+	{
+		std::size_t index = static_cast< std::size_t >( positions[key( aVertex)]);
+		heap[index] = aVertex;
+		siftUp( index);
+	}
+	/**
+	 *
+	 */
+	void VertexHeap::erase( const Vertex& aVertex)
+	{
+		int position = positions[key( aVertex)];
+		if (position < 0)
+		{
+			return;
+		}
+		positions[key( aVertex)] = -1;
+
+		std::size_t index = static_cast< std::size_t >( position);
+		Vertex last = heap.back();
+		heap.pop_back();
+		if (index < heap.size())
+		{
+			bool lower = less( last, heap[index]);
+			place( last, index);
+			if (lower)
+			{
+				siftUp( index);
+			} else
+			{
+				siftDown( index);
+			}
+		}
+	}
+	/**
+	 * VertexLessCostCompare only gives a partial order, the point is used as the
+	 * final tie breaker so that a search always expands the Vertices in the same order.
+	 */
+	/* static */bool VertexHeap::less(	const Vertex& lhs,
+										const Vertex& rhs)
+	{
+		if (lhs.lessCost( rhs))
+			return true;
+		if (rhs.lessCost( lhs))
+			return false;
+		return lhs.lessId( rhs);
+	}
+	/**
+	 *
+	 */
+	void VertexHeap::siftUp( std::size_t anIndex)
+	{
+		Vertex vertex = heap[anIndex];
+		while (anIndex > 0)
+		{
+			std::size_t parent = (anIndex - 1) / 2;
+			if (!less( vertex, heap[parent]))
+			{
+				break;
+			}
+			place( heap[parent], anIndex);
+			anIndex = parent;
+		}
+		place( vertex, anIndex);
+	}
+	/**
+	 *
+	 */
+	void VertexHeap::siftDown( std::size_t anIndex)
+	{
+		Vertex vertex = heap[anIndex];
+		std::size_t size = heap.size();
+		for (;;)
+		{
+			std::size_t child = 2 * anIndex + 1;
+			if (child >= size)
+			{
+				break;
+			}
+			if (child + 1 < size && less( heap[child + 1], heap[child]))
+			{
+				++child;
+			}
+			if (!less( heap[child], vertex))
+			{
+				break;
+			}
+			place( heap[child], anIndex);
+			anIndex = child;
+		}
+		place( vertex, anIndex);
+	}
+	/**
+	 *
+	 */
+	void VertexHeap::place(	const Vertex& aVertex,
+							std::size_t anIndex)
+	{
+		heap[anIndex] = aVertex;
+		positions[key( aVertex)] = static_cast< int >( anIndex);
+	}
+} // namespace PathAlgorithm
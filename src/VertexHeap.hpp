@@ -0,0 +1,128 @@
+#ifndef VERTEXHEAP_HPP_
+#define VERTEXHEAP_HPP_
+
+#include "Config.hpp"
+
+#include <cstddef>
+#include <vector>
+
+#include "Vertex.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 * An indexed binary min-heap of Vertices ordered by VertexLessCostCompare.
+	 *
+	 * Every Vertex in the heap is also registered in a position index keyed by its (x,y)
+	 * so that lookup is O(1) and push, pop-min and decrease-key are O(log n).
+	 * A point can be in the heap only once. The position index is a dense array over a
+	 * grid of a given size, only Vertices inside that grid can be pushed.
+	 */
+	class VertexHeap
+	{
+		public:
+			/**
+			 *
+			 */
+			VertexHeap();
+			/**
+			 * Empties the heap and sizes the position index for a grid of aWidth x aHeight
+			 */
+			void reset(	int aWidth,
+						int aHeight);
+			/**
+			 *
+			 */
+			bool empty() const
+			{
+				return heap.empty();
+			}
+			/**
+			 *
+			 */
+			std::size_t size() const
+			{
+				return heap.size();
+			}
+			/**
+			 *
+			 */
+			void clear();
+			/**
+			 * Adds aVertex to the heap. If there is already a Vertex with the same point in the heap
+			 * its costs are replaced by those of aVertex.
+			 */
+			void push( const Vertex& aVertex);
+			/**
+			 *
+			 * @return The Vertex with the lowest cost, the heap must not be empty
+			 */
+			const Vertex& top() const
+			{
+				return heap.front();
+			}
+			/**
+			 * Removes the Vertex with the lowest cost, the heap must not be empty
+			 */
+			void pop();
+			/**
+			 *
+			 * @return The Vertex with the same point as aVertex or nullptr if there is no such Vertex in the heap
+			 */
+			const Vertex* find( const Vertex& aVertex) const;
+			/**
+			 * Lowers the costs of the Vertex with the same point as aVertex to those of aVertex.
+			 * The Vertex must be in the heap and the new costs must not be higher than the current costs.
+			 */
+			void decreaseKey( const Vertex& aVertex);
+			/**
+			 * Removes the Vertex with the same point as aVertex if there is such a Vertex in the heap
+			 */
+			void erase( const Vertex& aVertex);
+			/**
+			 *
+			 * @return The Vertices in heap order, i.e. not sorted
+			 */
+			const std::vector< Vertex >& getVertices() const
+			{
+				return heap;
+			}
+
+		private:
+			/**
+			 *
+			 */
+			int key( const Vertex& aVertex) const
+			{
+				return aVertex.y * width + aVertex.x;
+			}
+			/**
+			 *
+			 */
+			static bool less(	const Vertex& lhs,
+								const Vertex& rhs);
+			/**
+			 *
+			 */
+			void siftUp( std::size_t anIndex);
+			/**
+			 *
+			 */
+			void siftDown( std::size_t anIndex);
+			/**
+			 *
+			 */
+			void place(	const Vertex& aVertex,
+						std::size_t anIndex);
+
+			int width;
+			int height;
+			std::vector< Vertex > heap;
+			/**
+			 * The index in the heap per point, -1 if the point is not in the heap
+			 */
+			std::vector< int > positions;
+	};
+	// class VertexHeap
+} // namespace PathAlgorithm
+#endif // VERTEXHEAP_HPP_
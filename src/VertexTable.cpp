@@ -0,0 +1,102 @@
+#include "VertexTable.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 *
+	 */
+	VertexTable::VertexTable() :
+								width( 0),
+								height( 0),
+								generation( 0)
+	{
+	}
+	/**
+	 *
+	 */
+	void VertexTable::reset(	int aWidth,
+								int aHeight)
+	{
+		if (aWidth != width || aHeight != height)
+		{
+			width = aWidth;
+			height = aHeight;
+			entries.assign( static_cast< std::size_t >( width) * height, Entry{ 0, false, -1, 0.0, 0.0 });
+			generation = 0;
+		}
+
+		++generation;
+		if (generation == 0)
+		{
+			// Wrapped around, the stamps of 2^32 searches ago would look current
+			entries.assign( entries.size(), Entry{ 0, false, -1, 0.0, 0.0 });
+			generation = 1;
+		}
+	}
+	/**
+	 *
+	 */
+	void VertexTable::visit(	const Vertex& aVertex,
+								const Vertex& aPredecessor)
+	{
+		Entry& entry = entries[indexOf( aVertex)];
+		entry.generation = generation;
+		entry.closed = false;
+		entry.predecessor = indexOf( aPredecessor);
+		entry.actualCost = aVertex.actualCost;
+		entry.heuristicCost = aVertex.heuristicCost;
+	}
+	/**
+	 *
+	 */
+	void VertexTable::visit( const Vertex& aVertex)
+	{
+		Entry& entry = entries[indexOf( aVertex)];
+		entry.generation = generation;
+		entry.closed = false;
+		entry.predecessor = -1;
+		entry.actualCost = aVertex.actualCost;
+		entry.heuristicCost = aVertex.heuristicCost;
+	}
+	/**
+	 *
+	 */
+	Vertex VertexTable::get( const Vertex& aVertex) const
+	{
+		return vertexAt( indexOf( aVertex));
+	}
+	/**
+	 *
+	 */
+	Vertex VertexTable::getPredecessor( const Vertex& aVertex) const
+	{
+		return vertexAt( entries[indexOf( aVertex)].predecessor);
+	}
+	/**
+	 *
+	 */
+	std::vector< Vertex > VertexTable::getClosedVertices() const
+	{
+		std::vector< Vertex > closedVertices;
+		for (std::size_t i = 0; i < entries.size(); ++i)
+		{
+			if (entries[i].generation == generation && entries[i].closed)
+			{
+				closedVertices.push_back( vertexAt( static_cast< int >( i)));
+			}
+		}
+		return closedVertices;
+	}
+	/**
+	 *
+	 */
+	Vertex VertexTable::vertexAt( int anIndex) const
+	{
+		const Entry& entry = entries[anIndex];
+
+		Vertex vertex( anIndex % width, anIndex / width);
+		vertex.actualCost = entry.actualCost;
+		vertex.heuristicCost = entry.heuristicCost;
+		return vertex;
+	}
+} // namespace PathAlgorithm
@@ -0,0 +1,127 @@
+#ifndef VERTEXTABLE_HPP_
+#define VERTEXTABLE_HPP_
+
+#include "Config.hpp"
+
+#include <vector>
+
+#include "Vertex.hpp"
+
+namespace PathAlgorithm
+{
+	/**
+	 * Dense, grid-indexed storage for the search state of every Vertex: the costs,
+	 * whether the Vertex is closed and its predecessor on the best known route.
+	 *
+	 * Every entry is stamped with the generation of the search that wrote it. Starting a
+	 * new search only increments the generation, entries of earlier searches are then
+	 * treated as never visited. The arrays are only cleared when the generation wraps around.
+	 */
+	class VertexTable
+	{
+		public:
+			/**
+			 *
+			 */
+			VertexTable();
+			/**
+			 * Starts a new search on a grid of aWidth x aHeight, (re)allocates only if the size changed
+			 */
+			void reset(	int aWidth,
+						int aHeight);
+			/**
+			 *
+			 */
+			bool isInside( const Vertex& aVertex) const
+			{
+				return aVertex.x >= 0 && aVertex.x < width && aVertex.y >= 0 && aVertex.y < height;
+			}
+			/**
+			 *
+			 * @return True if the Vertex was added to the open or closed set during this search
+			 */
+			bool isVisited( const Vertex& aVertex) const
+			{
+				return entries[indexOf( aVertex)].generation == generation;
+			}
+			/**
+			 *
+			 */
+			bool isClosed( const Vertex& aVertex) const
+			{
+				const Entry& entry = entries[indexOf( aVertex)];
+				return entry.generation == generation && entry.closed;
+			}
+			/**
+			 *
+			 */
+			void setClosed(	const Vertex& aVertex,
+							bool aClosed = true)
+			{
+				entries[indexOf( aVertex)].closed = aClosed;
+			}
+			/**
+			 * Stores the costs of aVertex and aPredecessor as its predecessor. This makes aVertex visited but not closed.
+			 */
+			void visit(	const Vertex& aVertex,
+						const Vertex& aPredecessor);
+			/**
+			 * Visits aVertex without a predecessor, i.e. aVertex is the start of the route
+			 */
+			void visit( const Vertex& aVertex);
+			/**
+			 *
+			 * @return aVertex with the costs that are stored for it, aVertex must be visited
+			 */
+			Vertex get( const Vertex& aVertex) const;
+			/**
+			 *
+			 * @return True if the visited aVertex has a predecessor
+			 */
+			bool hasPredecessor( const Vertex& aVertex) const
+			{
+				return entries[indexOf( aVertex)].predecessor >= 0;
+			}
+			/**
+			 *
+			 * @return The predecessor of the visited aVertex with its stored costs
+			 */
+			Vertex getPredecessor( const Vertex& aVertex) const;
+			/**
+			 *
+			 * @return All Vertices that are closed in this search
+			 */
+			std::vector< Vertex > getClosedVertices() const;
+
+		private:
+			/**
+			 *
+			 */
+			struct Entry
+			{
+					unsigned int generation;
+					bool closed;
+					int predecessor;
+					double actualCost;
+					double heuristicCost;
+			};
+			/**
+			 *
+			 */
+			int indexOf( const Vertex& aVertex) const
+			{
+				return aVertex.y * width + aVertex.x;
+			}
+			/**
+			 *
+			 */
+			Vertex vertexAt( int anIndex) const;
+
+			int width;
+			int height;
+			unsigned int generation;
+			std::vector< Entry > entries;
+	};
+	// class VertexTable
+} // namespace PathAlgorithm
+#endif // VERTEXTABLE_HPP_
@@ -1,6 +1,7 @@
 #include "Wall.hpp"
 #include <sstream>
 #include "Logger.hpp"
+#include "RobotWorld.hpp"
 #include "Shape2DUtils.hpp"
 
 namespace Model
@@ -33,6 +34,7 @@ namespace Model
 							bool aNotifyObservers /*= true*/)
 	{
 		point1 = aPoint1;
+		RobotWorld::getRobotWorld().wallChanged();
 		if (aNotifyObservers == true)
 		{
 			notifyObservers();
@@ -45,6 +47,7 @@ namespace Model
 							bool aNotifyObservers /*= true*/)
 	{
 		point2 = aPoint2;
+		RobotWorld::getRobotWorld().wallChanged();
 		if (aNotifyObservers == true)
 		{
 			notifyObservers();
@@ -0,0 +1,371 @@
+#include "WallTree.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Shape2DUtils.hpp"
+#include "Wall.hpp"
+
+namespace Model
+{
+	/**
+	 * True if the line from aPoint1 to aPoint2 touches the box from aTopLeft to aBottomRight: their
+	 * bounding boxes overlap and the corners of the box are not all on the same side of the line
+	 */
+	static bool LineTouchesBox(	const Point& aPoint1,
+								const Point& aPoint2,
+								const Point& aTopLeft,
+								const Point& aBottomRight)
+	{
+		if (std::max( aPoint1.x, aPoint2.x) < aTopLeft.x || std::min( aPoint1.x, aPoint2.x) > aBottomRight.x ||
+			std::max( aPoint1.y, aPoint2.y) < aTopLeft.y || std::min( aPoint1.y, aPoint2.y) > aBottomRight.y)
+		{
+			return false;
+		}
+		const long dX = static_cast< long >( aPoint2.x) - aPoint1.x;
+		const long dY = static_cast< long >( aPoint2.y) - aPoint1.y;
+		auto side = [&]( long anX, long anY)
+		{
+			const long cross = dX * (anY - aPoint1.y) - dY * (anX - aPoint1.x);
+			return (cross > 0) - (cross < 0);
+		};
+		const int sides = side( aTopLeft.x, aTopLeft.y) + side( aBottomRight.x, aTopLeft.y) + side( aBottomRight.x, aBottomRight.y) + side( aTopLeft.x, aBottomRight.y);
+		return sides != 4 && sides != -4;
+	}
+	/**
+	 *
+	 */
+	static double DistanceToLine(	const Point& aPoint,
+									const Point& aPoint1,
+									const Point& aPoint2)
+	{
+		const double dX = aPoint2.x - aPoint1.x;
+		const double dY = aPoint2.y - aPoint1.y;
+		const double lengthSquared = dX * dX + dY * dY;
+		double t = 0.0;
+		if (lengthSquared > 0.0)
+		{
+			t = std::min( std::max( ((aPoint.x - aPoint1.x) * dX + (aPoint.y - aPoint1.y) * dY) / lengthSquared, 0.0), 1.0);
+		}
+		return std::hypot( aPoint1.x + t * dX - aPoint.x, aPoint1.y + t * dY - aPoint.y);
+	}
+	/**
+	 *
+	 */
+	static double DistanceToBox(	const Point& aPoint,
+									const Point& aTopLeft,
+									const Point& aBottomRight)
+	{
+		const double dX = std::max( { aTopLeft.x - aPoint.x, 0, aPoint.x - aBottomRight.x });
+		const double dY = std::max( { aTopLeft.y - aPoint.y, 0, aPoint.y - aBottomRight.y });
+		return std::hypot( dX, dY);
+	}
+	/**
+	 * The slab test: the distance along the ray where it enters the box, or infinity if it misses it
+	 */
+	static double RayEntersBox(	double anOriginX,
+								double anOriginY,
+								double aDirectionX,
+								double aDirectionY,
+								const Point& aTopLeft,
+								const Point& aBottomRight)
+	{
+		double entry = 0.0;
+		double exit = std::numeric_limits< double >::infinity();
+		const double origin[] = { anOriginX, anOriginY };
+		const double direction[] = { aDirectionX, aDirectionY };
+		const double low[] = { static_cast< double >( aTopLeft.x), static_cast< double >( aTopLeft.y) };
+		const double high[] = { static_cast< double >( aBottomRight.x), static_cast< double >( aBottomRight.y) };
+		for (int axis = 0; axis < 2; ++axis)
+		{
+			if (direction[axis] == 0.0)
+			{
+				if (origin[axis] < low[axis] || origin[axis] > high[axis])
+				{
+					return std::numeric_limits< double >::infinity();
+				}
+				continue;
+			}
+			double near = (low[axis] - origin[axis]) / direction[axis];
+			double far = (high[axis] - origin[axis]) / direction[axis];
+			if (near > far)
+			{
+				std::swap( near, far);
+			}
+			entry = std::max( entry, near);
+			exit = std::min( exit, far);
+			if (entry > exit)
+			{
+				return std::numeric_limits< double >::infinity();
+			}
+		}
+		return entry;
+	}
+	/**
+	 * The distance along the ray where it hits the line from aPoint1 to aPoint2, or infinity if it misses it
+	 */
+	static double RayHitsLine(	double anOriginX,
+								double anOriginY,
+								double aDirectionX,
+								double aDirectionY,
+								const Point& aPoint1,
+								const Point& aPoint2)
+	{
+		const double lineX = aPoint2.x - aPoint1.x;
+		const double lineY = aPoint2.y - aPoint1.y;
+		const double denominator = aDirectionX * lineY - aDirectionY * lineX;
+		if (denominator == 0.0)
+		{
+			// Parallel, a ray along the wall itself hits it at its nearest end
+			const double cross = (aPoint1.x - anOriginX) * aDirectionY - (aPoint1.y - anOriginY) * aDirectionX;
+			if (cross != 0.0)
+			{
+				return std::numeric_limits< double >::infinity();
+			}
+			const double t1 = (aPoint1.x - anOriginX) * aDirectionX + (aPoint1.y - anOriginY) * aDirectionY;
+			const double t2 = (aPoint2.x - anOriginX) * aDirectionX + (aPoint2.y - anOriginY) * aDirectionY;
+			if (std::max( t1, t2) < 0.0)
+			{
+				return std::numeric_limits< double >::infinity();
+			}
+			return std::min( t1, t2) <= 0.0 ? 0.0 : std::min( t1, t2);
+		}
+		const double t = ((aPoint1.x - anOriginX) * lineY - (aPoint1.y - anOriginY) * lineX) / denominator;
+		const double u = ((aPoint1.x - anOriginX) * aDirectionY - (aPoint1.y - anOriginY) * aDirectionX) / denominator;
+		if (t < 0.0 || u < 0.0 || u > 1.0)
+		{
+			return std::numeric_limits< double >::infinity();
+		}
+		return t;
+	}
+	/**
+	 *
+	 */
+	WallTree::WallTree( const std::vector< WallPtr >& someWalls)
+	{
+		segments.reserve( someWalls.size());
+		for (WallPtr wall : someWalls)
+		{
+			segments.push_back( Segment{ wall->getPoint1(), wall->getPoint2(), wall });
+		}
+		if (!segments.empty())
+		{
+			// Every leaf has at least LeafSize / 2 walls, a tree with n leaves has 2n - 1 nodes
+			nodes.reserve( segments.size());
+			nodes.emplace_back();
+			build( 0, 0, segments.size());
+		}
+	}
+	/**
+	 *
+	 */
+	void WallTree::findWalls(	const Point& aTopLeft,
+								const Point& aBottomRight,
+								std::vector< const Wall* >& someWalls) const
+	{
+		someWalls.clear();
+		if (nodes.empty())
+		{
+			return;
+		}
+		std::vector< std::size_t > stack( 1, 0);
+		while (!stack.empty())
+		{
+			const Node& node = nodes[stack.back()];
+			stack.pop_back();
+			if (node.bottomRight.x < aTopLeft.x || node.topLeft.x > aBottomRight.x || node.bottomRight.y < aTopLeft.y || node.topLeft.y > aBottomRight.y)
+			{
+				continue;
+			}
+			if (node.count == 0)
+			{
+				stack.push_back( node.first);
+				stack.push_back( node.first + 1);
+				continue;
+			}
+			for (std::size_t i = node.first; i < node.first + node.count; ++i)
+			{
+				if (LineTouchesBox( segments[i].point1, segments[i].point2, aTopLeft, aBottomRight))
+				{
+					someWalls.push_back( segments[i].wall.get());
+				}
+			}
+		}
+	}
+	/**
+	 *
+	 */
+	void WallTree::findCrossingWalls(	const Point& aStartPoint,
+										const Point& anEndPoint,
+										std::vector< const Wall* >& someWalls) const
+	{
+		someWalls.clear();
+		if (nodes.empty())
+		{
+			return;
+		}
+		std::vector< std::size_t > stack( 1, 0);
+		while (!stack.empty())
+		{
+			const Node& node = nodes[stack.back()];
+			stack.pop_back();
+			if (!LineTouchesBox( aStartPoint, anEndPoint, node.topLeft, node.bottomRight))
+			{
+				continue;
+			}
+			if (node.count == 0)
+			{
+				stack.push_back( node.first);
+				stack.push_back( node.first + 1);
+				continue;
+			}
+			for (std::size_t i = node.first; i < node.first + node.count; ++i)
+			{
+				if (Utils::Shape2DUtils::intersect( aStartPoint, anEndPoint, segments[i].point1, segments[i].point2))
+				{
+					someWalls.push_back( segments[i].wall.get());
+				}
+			}
+		}
+	}
+	/**
+	 * Depth first, the nearer child first, skipping the nodes that are further away than the nearest wall so far
+	 */
+	const Wall* WallTree::findNearestWall(	const Point& aPoint,
+											double* aDistance /*= nullptr*/) const
+	{
+		const Wall* nearestWall = nullptr;
+		double nearestDistance = std::numeric_limits< double >::infinity();
+		if (!nodes.empty())
+		{
+			std::vector< std::size_t > stack( 1, 0);
+			while (!stack.empty())
+			{
+				const Node& node = nodes[stack.back()];
+				stack.pop_back();
+				if (DistanceToBox( aPoint, node.topLeft, node.bottomRight) >= nearestDistance)
+				{
+					continue;
+				}
+				if (node.count == 0)
+				{
+					const double leftDistance = DistanceToBox( aPoint, nodes[node.first].topLeft, nodes[node.first].bottomRight);
+					const double rightDistance = DistanceToBox( aPoint, nodes[node.first + 1].topLeft, nodes[node.first + 1].bottomRight);
+					stack.push_back( leftDistance < rightDistance ? node.first + 1 : node.first);
+					stack.push_back( leftDistance < rightDistance ? node.first : node.first + 1);
+					continue;
+				}
+				for (std::size_t i = node.first; i < node.first + node.count; ++i)
+				{
+					const double distance = DistanceToLine( aPoint, segments[i].point1, segments[i].point2);
+					if (distance < nearestDistance)
+					{
+						nearestDistance = distance;
+						nearestWall = segments[i].wall.get();
+					}
+				}
+			}
+		}
+		if (aDistance)
+		{
+			*aDistance = nearestDistance;
+		}
+		return nearestWall;
+	}
+	/**
+	 *
+	 */
+	const Wall* WallTree::castRay(	const Point& anOrigin,
+									double aDirectionX,
+									double aDirectionY,
+									double aMaxDistance,
+									double* aDistance /*= nullptr*/) const
+	{
+		const Wall* hitWall = nullptr;
+		double hitDistance = aMaxDistance;
+		const double length = std::hypot( aDirectionX, aDirectionY);
+		if (!nodes.empty() && length > 0.0)
+		{
+			const double directionX = aDirectionX / length;
+			const double directionY = aDirectionY / length;
+			std::vector< std::size_t > stack( 1, 0);
+			while (!stack.empty())
+			{
+				const Node& node = nodes[stack.back()];
+				stack.pop_back();
+				// A node the ray enters after the nearest hit so far can not have a nearer wall
+				if (RayEntersBox( anOrigin.x, anOrigin.y, directionX, directionY, node.topLeft, node.bottomRight) > hitDistance)
+				{
+					continue;
+				}
+				if (node.count == 0)
+				{
+					stack.push_back( node.first);
+					stack.push_back( node.first + 1);
+					continue;
+				}
+				for (std::size_t i = node.first; i < node.first + node.count; ++i)
+				{
+					const double distance = RayHitsLine( anOrigin.x, anOrigin.y, directionX, directionY, segments[i].point1, segments[i].point2);
+					if (distance < hitDistance || (distance == hitDistance && !hitWall))
+					{
+						hitDistance = distance;
+						hitWall = segments[i].wall.get();
+					}
+				}
+			}
+		}
+		if (aDistance)
+		{
+			*aDistance = hitWall ? hitDistance : std::numeric_limits< double >::infinity();
+		}
+		return hitWall;
+	}
+	/**
+	 *
+	 */
+	void WallTree::build(	std::size_t aNode,
+							std::size_t aFirst,
+							std::size_t aLast)
+	{
+		Point topLeft( std::numeric_limits< int >::max(), std::numeric_limits< int >::max());
+		Point bottomRight( std::numeric_limits< int >::min(), std::numeric_limits< int >::min());
+		for (std::size_t i = aFirst; i < aLast; ++i)
+		{
+			topLeft.x = std::min( { topLeft.x, segments[i].point1.x, segments[i].point2.x });
+			topLeft.y = std::min( { topLeft.y, segments[i].point1.y, segments[i].point2.y });
+			bottomRight.x = std::max( { bottomRight.x, segments[i].point1.x, segments[i].point2.x });
+			bottomRight.y = std::max( { bottomRight.y, segments[i].point1.y, segments[i].point2.y });
+		}
+		nodes[aNode].topLeft = topLeft;
+		nodes[aNode].bottomRight = bottomRight;
+
+		if (aLast - aFirst <= LeafSize)
+		{
+			nodes[aNode].first = aFirst;
+			nodes[aNode].count = aLast - aFirst;
+			return;
+		}
+
+		// Twice the centre, to stay with integers
+		const bool alongX = bottomRight.x - topLeft.x >= bottomRight.y - topLeft.y;
+		auto centre = [alongX]( const Segment& aSegment)
+		{
+			return alongX ? aSegment.point1.x + aSegment.point2.x : aSegment.point1.y + aSegment.point2.y;
+		};
+		const std::size_t middle = aFirst + (aLast - aFirst) / 2;
+		std::nth_element( segments.begin() + static_cast< long >( aFirst), segments.begin() + static_cast< long >( middle), segments.begin() + static_cast< long >( aLast), [&centre]( const Segment& aSegment, const Segment& anotherSegment)
+		{
+			return centre( aSegment) < centre( anotherSegment);
+		});
+
+		const std::size_t children = nodes.size();
+		nodes[aNode].first = children;
+		nodes[aNode].count = 0;
+		nodes.emplace_back();
+		nodes.emplace_back();
+		build( children, aFirst, middle);
+		build( children + 1, middle, aLast);
+	}
+} // namespace Model
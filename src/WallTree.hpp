@@ -0,0 +1,110 @@
+#ifndef WALLTREE_HPP_
+#define WALLTREE_HPP_
+
+#include "Config.hpp"
+
+#include <memory>
+#include <vector>
+
+#include "Point.hpp"
+
+namespace Model
+{
+	class Wall;
+	typedef std::shared_ptr<Wall> WallPtr;
+
+	/**
+	 * A bounding volume hierarchy over the Walls of the RobotWorld.
+	 *
+	 * The tree is bulk loaded from all walls at once: a node is split at the median of the centres
+	 * of its walls along the longest side of its bounding box, until a leaf has at most LeafSize
+	 * walls. The tree keeps the points the walls had when it was built, a Wall that moves needs a
+	 * new tree, see RobotWorld::getWallTree. The queries only visit the nodes whose bounding box
+	 * can contain an answer, so they take about logarithmic time in the number of walls.
+	 *
+	 * The tree owns the walls it was built from, the Wall pointers it returns are valid as long as
+	 * the tree exists.
+	 */
+	class WallTree
+	{
+		public:
+			/**
+			 * The maximum number of walls in a leaf
+			 */
+			static const std::size_t LeafSize = 4;
+			/**
+			 *
+			 */
+			explicit WallTree( const std::vector< WallPtr >& someWalls);
+			/**
+			 *
+			 */
+			std::size_t getNumberOfWalls() const
+			{
+				return segments.size();
+			}
+			/**
+			 * Replaces someWalls by the walls that touch the box from aTopLeft to aBottomRight
+			 */
+			void findWalls(	const Point& aTopLeft,
+							const Point& aBottomRight,
+							std::vector< const Wall* >& someWalls) const;
+			/**
+			 * Replaces someWalls by the walls that cross the line from aStartPoint to anEndPoint,
+			 * as Utils::Shape2DUtils::intersect decides
+			 */
+			void findCrossingWalls(	const Point& aStartPoint,
+									const Point& anEndPoint,
+									std::vector< const Wall* >& someWalls) const;
+			/**
+			 *
+			 * @param aDistance If given, the distance from aPoint to the wall
+			 * @return The wall nearest to aPoint, nullptr if there are no walls
+			 */
+			const Wall* findNearestWall(	const Point& aPoint,
+											double* aDistance = nullptr) const;
+			/**
+			 * Follows the ray from anOrigin in the direction (aDirectionX, aDirectionY) up to
+			 * aMaxDistance, the direction does not have to be a unit vector
+			 *
+			 * @param aDistance If given, the distance from anOrigin to the wall that was hit
+			 * @return The first wall the ray hits, nullptr if it hits none within aMaxDistance
+			 */
+			const Wall* castRay(	const Point& anOrigin,
+									double aDirectionX,
+									double aDirectionY,
+									double aMaxDistance,
+									double* aDistance = nullptr) const;
+
+		private:
+			/**
+			 *
+			 */
+			struct Segment
+			{
+					Point point1;
+					Point point2;
+					WallPtr wall;
+			};
+			/**
+			 * A leaf has its segments from first, an inner node has its two children at first and first + 1
+			 */
+			struct Node
+			{
+					Point topLeft;
+					Point bottomRight;
+					std::size_t first;
+					std::size_t count;
+			};
+			/**
+			 * Makes aNode the node of the segments from aFirst up to aLast
+			 */
+			void build(	std::size_t aNode,
+						std::size_t aFirst,
+						std::size_t aLast);
+
+			std::vector< Segment > segments;
+			std::vector< Node > nodes;
+	}; // class WallTree
+} // namespace Model
+#endif // WALLTREE_HPP_
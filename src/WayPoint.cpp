@@ -1,6 +1,7 @@
 #include "WayPoint.hpp"
 #include <sstream>
 #include "Logger.hpp"
+#include "Shape2DUtils.hpp"
 
 namespace Model
 {
@@ -79,27 +80,16 @@ namespace Model
 	/**
 	 *
 	 */
-	Region WayPoint::getRegion() const
+	Point WayPoint::getTopLeft() const
 	{
-		// x and y are pointing to top left now
-		int x = position.x - (size.x / 2);
-		int y = position.y - (size.y / 2);
-
-		Point originalUpperLeft( x, y);
-		Point originalUpperRight( x + size.x, y);
-		Point originalBottomLeft( x, y + size.y);
-		Point originalBottomRight( x + size.x, y + size.y);
-
-		Point originalPoints[] = { originalUpperRight, originalUpperLeft, originalBottomLeft, originalBottomRight };
-
-		return Region( 4, originalPoints);
+		return Point( position.x - (size.x / 2), position.y - (size.y / 2));
 	}
 	/**
 	 *
 	 */
-	bool WayPoint::intersects( const Region& aRegion) const
+	bool WayPoint::intersects( const Point* aBox) const
 	{
-		return getRegion().Intersect( aRegion);
+		return Utils::Shape2DUtils::intersectBoxAndRectangle( aBox, getTopLeft(), size);
 	}
 	/**
 	 *
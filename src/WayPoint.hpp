@@ -5,7 +5,6 @@
 #include "ModelObject.hpp"
 #include "Point.hpp"
 #include "Size.hpp"
-#include "Region.hpp"
 
 namespace Model
 {
@@ -67,12 +66,15 @@ namespace Model
 								bool aNotifyObservers = true);
 			/**
 			 *
+			 * @return The top left corner of the rectangle of the WayPoint, position is its centre
 			 */
-			Region getRegion() const;
+			Point getTopLeft() const;
 			/**
 			 *
+			 * @param aBox The 4 corners of a box, in clockwise or counter-clockwise order
+			 * @return True if the box overlaps the rectangle of the WayPoint, see Utils::Shape2DUtils::intersectBoxAndRectangle
 			 */
-			bool intersects( const Region& aRegion) const;
+			bool intersects( const Point* aBox) const;
 			/**
 			 * @name Debug functions
 			 */
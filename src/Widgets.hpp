@@ -87,14 +87,6 @@ typedef wxActivateEvent ActivateEvent;
 	 * @see http://docs.wxwidgets.org/stable/classwx_data_format
 	 */
 	typedef wxDataFormat DataFormat;
-	/**
-	 * @see http://docs.wxwidgets.org/stable/classwx_default_position
-	 */
-#define DefaultPosition wxDefaultPosition
-	/**
-	 * @see http://docs.wxwidgets.org/stable/classwx_default_size
-	 */
-#define DefaultSize wxDefaultSize
 	/**
 	 * @see http://http://docs.wxwidgets.org/stable/classwx_validator
 	 */